@@ -2,3 +2,6 @@ gcc -o offline1 ./src/offline1.cpp -mfloat-abi=hard -mfpu=neon -DHAVE_NEON=1 -lm
 gcc -o offline2 ./src/offline2.cpp -mfloat-abi=hard -mfpu=neon -DHAVE_NEON=1 -lm -lpthread -lstdc++          -I../Superpowered ../Superpowered/libSuperpoweredLinuxARM32Hard.a
 gcc -o offline3 ./src/offline3.cpp -mfloat-abi=hard -mfpu=neon -DHAVE_NEON=1 -lm -lpthread -lstdc++          -I../Superpowered ../Superpowered/libSuperpoweredLinuxARM32Hard.a
 gcc -o hls      ./src/hls.cpp      -mfloat-abi=hard -mfpu=neon -DHAVE_NEON=1 -lm -lpthread -lstdc++ -lasound -I../Superpowered ../Superpowered/libSuperpoweredLinuxARM32Hard.a
+gcc -O2 -o benchmark ./src/benchmark.cpp ../Superpowered/OpenSource/SuperpoweredSIMD.cpp ../Superpowered/OpenSource/SuperpoweredNBandEQ.cpp ../Superpowered/OpenSource/SuperpoweredTruePeakMeter.cpp ../Superpowered/OpenSource/SuperpoweredTruePeakLimiter.cpp ../Superpowered/OpenSource/SuperpoweredPlanarFX.cpp ../Superpowered/OpenSource/SuperpoweredHalfAudio.cpp ../Superpowered/OpenSource/SuperpoweredPolyphaseResampler.cpp ../Superpowered/OpenSource/SuperpoweredLoudnessMeter.cpp ../Superpowered/OpenSource/SuperpoweredLargeFFT.cpp ../Superpowered/OpenSource/SuperpoweredBatchFFT.cpp ../Superpowered/OpenSource/SuperpoweredMixedRadixFFT.cpp ../Superpowered/OpenSource/SuperpoweredDoubleFFT.cpp ../Superpowered/OpenSource/SuperpoweredConvolver.cpp ../Superpowered/OpenSource/SuperpoweredMultichannelFrequencyDomain.cpp ../Superpowered/OpenSource/SuperpoweredSharedTables.cpp ../Superpowered/OpenSource/SuperpoweredConstantQ.cpp ../Superpowered/OpenSource/SuperpoweredSpectrogram.cpp ../Superpowered/OpenSource/SuperpoweredParallelDecoder.cpp ../Superpowered/OpenSource/SuperpoweredFloatDecoder.cpp ../Superpowered/OpenSource/SuperpoweredIndexedDecoder.cpp -mfloat-abi=hard -mfpu=neon -DHAVE_NEON=1 -lm -lpthread -lstdc++ -I../Superpowered ../Superpowered/libSuperpoweredLinuxARM32Hard.a
+gcc -O2 -o fftTest   ./src/fftTest.cpp   -mfloat-abi=hard -mfpu=neon -DHAVE_NEON=1 -I../Superpowered ../Superpowered/libSuperpoweredLinuxARM32Hard.a -lpthread -lstdc++ -lm
+gcc -O2 -o openSourceTest ./src/openSourceTest.cpp ../Superpowered/OpenSource/SuperpoweredSIMD.cpp ../Superpowered/OpenSource/SuperpoweredPolyphaseResampler.cpp ../Superpowered/OpenSource/SuperpoweredConvolver.cpp ../Superpowered/OpenSource/SuperpoweredIndexedDecoder.cpp -mfloat-abi=hard -mfpu=neon -DHAVE_NEON=1 -lm -lpthread -lstdc++ -I../Superpowered ../Superpowered/libSuperpoweredLinuxARM32Hard.a
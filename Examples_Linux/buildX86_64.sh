@@ -2,4 +2,7 @@ gcc -o offline1 ./src/offline1.cpp -lpthread -lstdc++ -I../Superpowered ../Super
 gcc -o offline2 ./src/offline2.cpp -lpthread -lstdc++ -I../Superpowered ../Superpowered/libSuperpoweredLinuxX86_64.a -lm
 gcc -o offline3 ./src/offline3.cpp -lpthread -lstdc++ -I../Superpowered ../Superpowered/libSuperpoweredLinuxX86_64.a -lm
 gcc -o hls ./src/hls.cpp -lpthread -lstdc++ -lasound -I../Superpowered ../Superpowered/libSuperpoweredLinuxX86_64.a -lm
+gcc -O2 -o benchmark ./src/benchmark.cpp ../Superpowered/OpenSource/SuperpoweredSIMD.cpp ../Superpowered/OpenSource/SuperpoweredNBandEQ.cpp ../Superpowered/OpenSource/SuperpoweredTruePeakMeter.cpp ../Superpowered/OpenSource/SuperpoweredTruePeakLimiter.cpp ../Superpowered/OpenSource/SuperpoweredPlanarFX.cpp ../Superpowered/OpenSource/SuperpoweredHalfAudio.cpp ../Superpowered/OpenSource/SuperpoweredPolyphaseResampler.cpp ../Superpowered/OpenSource/SuperpoweredLoudnessMeter.cpp ../Superpowered/OpenSource/SuperpoweredLargeFFT.cpp ../Superpowered/OpenSource/SuperpoweredBatchFFT.cpp ../Superpowered/OpenSource/SuperpoweredMixedRadixFFT.cpp ../Superpowered/OpenSource/SuperpoweredDoubleFFT.cpp ../Superpowered/OpenSource/SuperpoweredConvolver.cpp ../Superpowered/OpenSource/SuperpoweredMultichannelFrequencyDomain.cpp ../Superpowered/OpenSource/SuperpoweredSharedTables.cpp ../Superpowered/OpenSource/SuperpoweredConstantQ.cpp ../Superpowered/OpenSource/SuperpoweredSpectrogram.cpp ../Superpowered/OpenSource/SuperpoweredParallelDecoder.cpp ../Superpowered/OpenSource/SuperpoweredFloatDecoder.cpp ../Superpowered/OpenSource/SuperpoweredIndexedDecoder.cpp -lpthread -lstdc++ -I../Superpowered ../Superpowered/libSuperpoweredLinuxX86_64.a -lm
+gcc -O2 -o fftTest ./src/fftTest.cpp -I../Superpowered ../Superpowered/libSuperpoweredLinuxX86_64.a -lpthread -lstdc++ -lm
+gcc -O2 -o openSourceTest ./src/openSourceTest.cpp ../Superpowered/OpenSource/SuperpoweredSIMD.cpp ../Superpowered/OpenSource/SuperpoweredPolyphaseResampler.cpp ../Superpowered/OpenSource/SuperpoweredConvolver.cpp ../Superpowered/OpenSource/SuperpoweredIndexedDecoder.cpp -lpthread -lstdc++ -I../Superpowered ../Superpowered/libSuperpoweredLinuxX86_64.a -lm
 
@@ -0,0 +1,716 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "Superpowered.h"
+#include "SuperpoweredSimple.h"
+#include "SuperpoweredFFT.h"
+#include "Superpowered3BandEQ.h"
+#include "SuperpoweredBitcrusher.h"
+#include "SuperpoweredCompressor.h"
+#include "SuperpoweredEcho.h"
+#include "SuperpoweredFilter.h"
+#include "SuperpoweredFlanger.h"
+#include "SuperpoweredGate.h"
+#include "SuperpoweredGuitarDistortion.h"
+#include "SuperpoweredLimiter.h"
+#include "SuperpoweredReverb.h"
+#include "SuperpoweredRoll.h"
+#include "SuperpoweredWhoosh.h"
+#include "OpenSource/SuperpoweredSIMD.h"
+#include "OpenSource/SuperpoweredLargeFFT.h"
+#include "OpenSource/SuperpoweredBatchFFT.h"
+#include "OpenSource/SuperpoweredMixedRadixFFT.h"
+#include "OpenSource/SuperpoweredDoubleFFT.h"
+#include "OpenSource/SuperpoweredConvolver.h"
+#include "OpenSource/SuperpoweredMultichannelFrequencyDomain.h"
+#include "OpenSource/SuperpoweredConstantQ.h"
+#include "OpenSource/SuperpoweredSpectrogram.h"
+#include "OpenSource/SuperpoweredNBandEQ.h"
+#include "OpenSource/SuperpoweredTruePeakLimiter.h"
+#include "OpenSource/SuperpoweredPlanarFX.h"
+#include "OpenSource/SuperpoweredHalfAudio.h"
+#include "OpenSource/SuperpoweredPolyphaseResampler.h"
+#include "OpenSource/SuperpoweredLoudnessMeter.h"
+
+// EXAMPLE: headless micro-benchmark of the SuperpoweredSimple.h kernels, the FFT and every effect's process().
+// Usage: ./benchmark [--quick] > results.json
+// Prints JSON to stdout: nanoseconds per call, nanoseconds per frame and cycles per sample for every measurement, to compare SDK versions and machines.
+// Every measurement is repeated 9 times, the median is reported. Cycles are read from the time stamp counter on x86 (reference cycles, not adjusted for turbo), and are null on other CPUs.
+
+static const unsigned int bufferSizes[] = { 64, 256, 1024, 4096 };
+static const unsigned int numBufferSizes = sizeof(bufferSizes) / sizeof(bufferSizes[0]);
+static const unsigned int fxBufferSizes[] = { 64, 128, 256, 512, 1024, 2048 };
+static const unsigned int numFxBufferSizes = sizeof(fxBufferSizes) / sizeof(fxBufferSizes[0]);
+static const unsigned int maxFrames = 8192, samplerate = 48000, repeats = 9;
+
+static double targetRepeatNs = 2000000.0; // 2 ms per repeat, 0.2 ms with --quick.
+static std::string json;
+static bool firstResult = true;
+
+static inline uint64_t nowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Runs job() in a loop, returns with the median time and cycles of one call.
+// baselineNs and baselineCycles are subtracted, they measure the preparation done inside job() (such as restoring the input of an in-place FFT).
+template <class Job> static void measure(Job job, double &nsPerCall, double &cyclesPerCall) {
+    // Warm up the caches and find the number of iterations for the target repeat length.
+    unsigned int iterations = 1;
+    while (true) {
+        const uint64_t start = nowNs();
+        for (unsigned int n = 0; n < iterations; n++) job();
+        const double elapsed = double(nowNs() - start);
+        if ((elapsed >= targetRepeatNs * 0.25) || (iterations >= (1u << 24))) {
+            iterations = (unsigned int)std::max(1.0, double(iterations) * targetRepeatNs / std::max(elapsed, 1.0));
+            break;
+        }
+        iterations *= 4;
+    }
+
+    double ns[repeats], cy[repeats];
+    for (unsigned int r = 0; r < repeats; r++) {
+        const uint64_t startNs = nowNs(), startCycles = cycles();
+        for (unsigned int n = 0; n < iterations; n++) job();
+        cy[r] = double(cycles() - startCycles) / double(iterations);
+        ns[r] = double(nowNs() - startNs) / double(iterations);
+    }
+    std::sort(ns, ns + repeats);
+    std::sort(cy, cy + repeats);
+    nsPerCall = ns[repeats / 2];
+    cyclesPerCall = cy[repeats / 2];
+}
+
+// Adds one result to the JSON output. frames is the number of frames (or FFT points) per call, channels the number of samples per frame.
+static void addResult(const char *group, const char *name, const char *variant, unsigned int frames, unsigned int channels, double nsPerCall, double cyclesPerCall) {
+    char line[512];
+    char cyclesText[64];
+    if (cycles() != 0) snprintf(cyclesText, sizeof(cyclesText), "%.4f", std::max(cyclesPerCall, 0.0) / double(frames * channels)); else strcpy(cyclesText, "null");
+    snprintf(line, sizeof(line), "%s\n    { \"group\": \"%s\", \"name\": \"%s\", \"variant\": \"%s\", \"frames\": %u, \"channels\": %u, \"nsPerCall\": %.2f, \"nsPerFrame\": %.4f, \"cyclesPerSample\": %s }",
+             firstResult ? "" : ",", group, name, variant, frames, channels, std::max(nsPerCall, 0.0), std::max(nsPerCall, 0.0) / double(frames), cyclesText);
+    json += line;
+    firstResult = false;
+    fprintf(stderr, "%-8s %-28s %-10s %5u frames: %10.1f ns/call\n", group, name, variant, frames, nsPerCall);
+}
+
+template <class Job> static void benchmark(const char *group, const char *name, const char *variant, unsigned int frames, unsigned int channels, Job job) {
+    double ns, cy;
+    measure(job, ns, cy);
+    addResult(group, name, variant, frames, channels, ns, cy);
+}
+
+static void fillNoise(float *buffer, unsigned int numberOfValues) {
+    for (unsigned int n = 0; n < numberOfValues; n++) buffer[n] = float(rand()) / float(RAND_MAX) - 0.5f;
+}
+
+// Test buffers, big enough for maxFrames stereo frames (or 8 channels for the multichannel functions).
+static float *inputA, *inputB, *inputC, *inputD, *output, *left, *right;
+static short int *shortBuffer;
+static int *intBuffer;
+static signed char *charBuffer;
+
+static void benchmarkSimple() {
+    float peaks[8];
+    volatile float sink = 0;
+    volatile bool sinkBool = false;
+
+    for (unsigned int s = 0; s < numBufferSizes; s++) {
+        const unsigned int n = bufferSizes[s];
+        benchmark("simple", "Volume", "", n, 2, [&] { Superpowered::Volume(inputA, output, 0.5f, 0.7f, n); });
+        benchmark("simple", "ChangeVolume", "", n, 2, [&] { Superpowered::ChangeVolume(inputA, output, 0.5f, 0.0001f, n); });
+        benchmark("simple", "VolumeAdd", "", n, 2, [&] { Superpowered::VolumeAdd(inputA, output, 0.5f, 0.7f, n); });
+        benchmark("simple", "ChangeVolumeAdd", "", n, 2, [&] { Superpowered::ChangeVolumeAdd(inputA, output, 0.5f, 0.0001f, n); });
+        benchmark("simple", "Peak", "", n, 2, [&] { sink = Superpowered::Peak(inputA, n * 2); });
+        benchmark("simple", "CharToFloat", "", n, 2, [&] { Superpowered::CharToFloat(charBuffer, output, n); });
+        benchmark("simple", "FloatToChar", "", n, 2, [&] { Superpowered::FloatToChar(inputA, charBuffer, n); });
+        benchmark("simple", "Bit24ToFloat", "", n, 2, [&] { Superpowered::Bit24ToFloat(intBuffer, output, n); });
+        benchmark("simple", "FloatTo24bit", "", n, 2, [&] { Superpowered::FloatTo24bit(inputA, intBuffer, n); });
+        benchmark("simple", "IntToFloat", "", n, 2, [&] { Superpowered::IntToFloat(intBuffer, output, n); });
+        benchmark("simple", "FloatToInt", "", n, 2, [&] { Superpowered::FloatToInt(inputA, intBuffer, n); });
+        benchmark("simple", "FloatToShortInt", "", n, 2, [&] { Superpowered::FloatToShortInt(inputA, shortBuffer, n); });
+        benchmark("simple", "FloatToShortIntInterleave", "", n, 2, [&] { Superpowered::FloatToShortIntInterleave(left, right, shortBuffer, n); });
+        benchmark("simple", "ShortIntToFloatGetPeaks", "", n, 2, [&] { Superpowered::ShortIntToFloatGetPeaks(shortBuffer, output, n, peaks); });
+        benchmark("simple", "ShortIntToFloat", "", n, 2, [&] { Superpowered::ShortIntToFloat(shortBuffer, output, n); });
+        benchmark("simple", "CopyMonoToInterleaved", "", n, 1, [&] { Superpowered::CopyMonoToInterleaved(left, 3, output, 8, n); });
+        benchmark("simple", "CopyStereoToInterleaved", "", n, 2, [&] { Superpowered::CopyStereoToInterleaved(inputA, 2, output, 8, n); });
+        benchmark("simple", "CopyMonoFromInterleaved", "", n, 1, [&] { Superpowered::CopyMonoFromInterleaved(inputB, 8, left, 3, n); });
+        benchmark("simple", "CopyStereoFromInterleaved", "", n, 2, [&] { Superpowered::CopyStereoFromInterleaved(inputB, 8, output, 2, n); });
+        benchmark("simple", "GetPeaks", "", n, 8, [&] { Superpowered::GetPeaks(inputB, 8, n, peaks); });
+        benchmark("simple", "Interleave", "", n, 2, [&] { Superpowered::Interleave(left, right, output, n); });
+        benchmark("simple", "InterleaveAdd", "", n, 2, [&] { Superpowered::InterleaveAdd(left, right, output, n); });
+        benchmark("simple", "InterleaveAndGetPeaks", "", n, 2, [&] { Superpowered::InterleaveAndGetPeaks(left, right, output, n, peaks); });
+        benchmark("simple", "DeInterleave", "", n, 2, [&] { Superpowered::DeInterleave(inputA, left, right, n); });
+        benchmark("simple", "DeInterleaveMultiply", "", n, 2, [&] { Superpowered::DeInterleaveMultiply(inputA, left, right, n, 0.5f); });
+        benchmark("simple", "DeInterleaveAdd", "", n, 2, [&] { Superpowered::DeInterleaveAdd(inputA, left, right, n); });
+        benchmark("simple", "DeInterleaveMultiplyAdd", "", n, 2, [&] { Superpowered::DeInterleaveMultiplyAdd(inputA, left, right, n, 0.5f); });
+        benchmark("simple", "HasNonFinite", "", n, 2, [&] { sinkBool = Superpowered::HasNonFinite(inputA, n * 2); });
+        benchmark("simple", "StereoToMono", "", n, 2, [&] { Superpowered::StereoToMono(inputA, left, 0.5f, 0.6f, 0.5f, 0.4f, n); });
+        benchmark("simple", "CrossMono", "", n, 1, [&] { Superpowered::CrossMono(left, right, output, 0.5f, 0.6f, 0.5f, 0.4f, n); });
+        benchmark("simple", "CrossStereo", "", n, 2, [&] { Superpowered::CrossStereo(inputA, inputC, output, 0.5f, 0.6f, 0.5f, 0.4f, n); });
+        benchmark("simple", "Add1", "", n * 2, 1, [&] { Superpowered::Add1(inputA, output, n * 2); });
+        benchmark("simple", "Add2", "", n * 2, 1, [&] { Superpowered::Add2(inputA, inputC, output, n * 2); });
+        benchmark("simple", "Add4", "", n * 2, 1, [&] { Superpowered::Add4(inputA, inputC, inputD, inputB, output, n * 2); });
+        benchmark("simple", "StereoToMidSide", "", n, 2, [&] { Superpowered::StereoToMidSide(inputA, output, n); });
+        benchmark("simple", "MidSideToStereo", "", n, 2, [&] { Superpowered::MidSideToStereo(inputA, output, n); });
+        benchmark("simple", "DotProduct", "", n * 2, 1, [&] { sink = Superpowered::DotProduct(inputA, inputC, n * 2); });
+    }
+    (void)sink;
+    (void)sinkBool;
+}
+
+// The open-source, runtime dispatched versions of the same kernels, on every path the CPU supports.
+static void benchmarkSIMD() {
+    volatile float sink = 0;
+    const Superpowered::SIMD::Path best = Superpowered::SIMD::BestPath();
+    // The K-weighting filters of LoudnessMeter at 48000 Hz.
+    float biquadCoefficients[10] = { 1.53512486f, -2.69169619f, 1.19839281f, -1.69065929f, 0.73248077f, 1.0f, -2.0f, 1.0f, -1.99004745f, 0.99007225f }, biquadState[8] = { 0 }, sumOfSquares[2] = { 0 };
+
+    for (int p = Superpowered::SIMD::Path_Scalar; p <= best; p++) {
+        const Superpowered::SIMD::Path path = (Superpowered::SIMD::Path)p;
+        Superpowered::SIMD::SetPath(path);
+        const char *v = Superpowered::SIMD::PathToString(path);
+
+        for (unsigned int s = 0; s < numBufferSizes; s++) {
+            const unsigned int n = bufferSizes[s];
+            benchmark("simd", "Volume", v, n, 2, [&] { Superpowered::SIMD::Volume(inputA, output, 0.5f, 0.7f, n); });
+            benchmark("simd", "ChangeVolume", v, n, 2, [&] { Superpowered::SIMD::ChangeVolume(inputA, output, 0.5f, 0.0001f, n); });
+            benchmark("simd", "VolumeAdd", v, n, 2, [&] { Superpowered::SIMD::VolumeAdd(inputA, output, 0.5f, 0.7f, n); });
+            benchmark("simd", "ChangeVolumeAdd", v, n, 2, [&] { Superpowered::SIMD::ChangeVolumeAdd(inputA, output, 0.5f, 0.0001f, n); });
+            benchmark("simd", "CrossStereo", v, n, 2, [&] { Superpowered::SIMD::CrossStereo(inputA, inputC, output, 0.5f, 0.6f, 0.5f, 0.4f, n); });
+            benchmark("simd", "Interleave", v, n, 2, [&] { Superpowered::SIMD::Interleave(left, right, output, n); });
+            benchmark("simd", "DeInterleave", v, n, 2, [&] { Superpowered::SIMD::DeInterleave(inputA, left, right, n); });
+            benchmark("simd", "ShortIntToFloat", v, n, 2, [&] { Superpowered::SIMD::ShortIntToFloat(shortBuffer, output, n); });
+            benchmark("simd", "FloatToShortInt", v, n, 2, [&] { Superpowered::SIMD::FloatToShortInt(inputA, shortBuffer, n); });
+            benchmark("simd", "Add1", v, n * 2, 1, [&] { Superpowered::SIMD::Add1(inputA, output, n * 2); });
+            benchmark("simd", "Add2", v, n * 2, 1, [&] { Superpowered::SIMD::Add2(inputA, inputC, output, n * 2); });
+            benchmark("simd", "Add4", v, n * 2, 1, [&] { Superpowered::SIMD::Add4(inputA, inputC, inputD, inputB, output, n * 2); });
+            benchmark("simd", "DotProduct", v, n * 2, 1, [&] { sink = Superpowered::SIMD::DotProduct(inputA, inputC, n * 2); });
+            benchmark("simd", "Peak", v, n, 2, [&] { sink = Superpowered::SIMD::Peak(inputA, n * 2); });
+            benchmark("simd", "Biquad2SumOfSquares", v, n, 2, [&] { Superpowered::SIMD::Biquad2SumOfSquares(inputA, n, 2, biquadCoefficients, biquadState, sumOfSquares); });
+        }
+    }
+    Superpowered::SIMD::SetPath(best);
+    (void)sink;
+}
+
+// HalfAudio conversions in both sample formats on every path. append() starts from an empty buffer every time, so it measures the conversion and the copy without growing.
+static void benchmarkHalfAudio() {
+    const Superpowered::SIMD::Path best = Superpowered::SIMD::BestPath();
+    static const struct { Superpowered::HalfAudio::Format format; const char *name; } formats[2] = {
+        { Superpowered::HalfAudio::Format_Half, "HalfAudio.Half" },
+        { Superpowered::HalfAudio::Format_BFloat16, "HalfAudio.BFloat16" }
+    };
+
+    for (int f = 0; f < 2; f++) {
+        Superpowered::HalfAudio audio(samplerate, 2, formats[f].format, maxFrames);
+        std::string appendName = std::string(formats[f].name) + ".append", readName = std::string(formats[f].name) + ".read";
+
+        for (int p = Superpowered::SIMD::Path_Scalar; p <= best; p++) {
+            const Superpowered::SIMD::Path path = (Superpowered::SIMD::Path)p;
+            Superpowered::SIMD::SetPath(path);
+            const char *v = Superpowered::SIMD::PathToString(path);
+
+            for (unsigned int s = 0; s < numBufferSizes; s++) {
+                const unsigned int n = bufferSizes[s];
+                benchmark("simd", appendName.c_str(), v, n, 2, [&] { audio.clear(); audio.append(inputA, n); });
+                audio.clear();
+                audio.append(inputA, maxFrames);
+                benchmark("simd", readName.c_str(), v, n, 2, [&] { audio.read(output, 0, n); });
+            }
+        }
+    }
+    Superpowered::SIMD::SetPath(best);
+}
+
+// LoudnessMeter on every path. The K-weighting filters are recursive: stereo and mono need a different vectorization than 8 channels.
+static void benchmarkLoudnessMeter() {
+    const Superpowered::SIMD::Path best = Superpowered::SIMD::BestPath();
+    static const struct { unsigned int numChannels; const char *name; } layouts[3] = {
+        { 1, "LoudnessMeter.mono" },
+        { 2, "LoudnessMeter.stereo" },
+        { 8, "LoudnessMeter.8ch" }
+    };
+
+    for (int l = 0; l < 3; l++) {
+        Superpowered::LoudnessMeter meter(samplerate, layouts[l].numChannels);
+        for (int p = Superpowered::SIMD::Path_Scalar; p <= best; p++) {
+            const Superpowered::SIMD::Path path = (Superpowered::SIMD::Path)p;
+            Superpowered::SIMD::SetPath(path);
+            const char *v = Superpowered::SIMD::PathToString(path);
+
+            for (unsigned int s = 0; s < numFxBufferSizes; s++) {
+                const unsigned int n = fxBufferSizes[s];
+                benchmark("simd", layouts[l].name, v, n, layouts[l].numChannels, [&] { meter.process(inputA, n); });
+            }
+        }
+    }
+    Superpowered::SIMD::SetPath(best);
+}
+
+// The FFTs are in-place, so the input is restored before every call. The cost of restoring is measured separately and subtracted.
+static void benchmarkFFT() {
+    float *real = (float *)malloc(maxFrames * sizeof(float)), *imag = (float *)malloc(maxFrames * sizeof(float));
+    float *sourceReal = (float *)malloc(maxFrames * sizeof(float)), *sourceImag = (float *)malloc(maxFrames * sizeof(float));
+    fillNoise(sourceReal, maxFrames);
+    fillNoise(sourceImag, maxFrames);
+    static const char *kinds[3] = { "FFTComplex", "FFTReal", "PolarFFT" };
+
+    for (int kind = 0; kind < 3; kind++) {
+        const int minLogSize = (kind == 0) ? 4 : 5, maxLogSize = (kind == 0) ? 12 : 13;
+        for (int logSize = minLogSize; logSize <= maxLogSize; logSize++) {
+            const unsigned int size = 1u << logSize, values = (kind == 0) ? size : size / 2; // Real and polar FFTs store size / 2 values in each array.
+
+            // Inverse transforms get the output of the forward transform as input.
+            memcpy(real, sourceReal, values * sizeof(float));
+            memcpy(imag, sourceImag, values * sizeof(float));
+            float *inverseReal = (float *)malloc(values * sizeof(float)), *inverseImag = (float *)malloc(values * sizeof(float));
+            if (kind == 0) Superpowered::FFTComplex(real, imag, logSize, true); else if (kind == 1) Superpowered::FFTReal(real, imag, logSize, true); else Superpowered::PolarFFT(real, imag, logSize, true);
+            memcpy(inverseReal, real, values * sizeof(float));
+            memcpy(inverseImag, imag, values * sizeof(float));
+
+            double baselineNs, baselineCycles;
+            measure([&] {
+                memcpy(real, sourceReal, values * sizeof(float));
+                memcpy(imag, sourceImag, values * sizeof(float));
+            }, baselineNs, baselineCycles);
+
+            for (int forward = 1; forward >= 0; forward--) {
+                float *sr = forward ? sourceReal : inverseReal, *si = forward ? sourceImag : inverseImag;
+                double ns, cy;
+                measure([&] {
+                    memcpy(real, sr, values * sizeof(float));
+                    memcpy(imag, si, values * sizeof(float));
+                    if (kind == 0) Superpowered::FFTComplex(real, imag, logSize, forward != 0);
+                    else if (kind == 1) Superpowered::FFTReal(real, imag, logSize, forward != 0);
+                    else Superpowered::PolarFFT(real, imag, logSize, forward != 0);
+                }, ns, cy);
+                addResult("fft", kinds[kind], forward ? "forward" : "inverse", size, 1, ns - baselineNs, cy - baselineCycles);
+            }
+            free(inverseReal);
+            free(inverseImag);
+        }
+    }
+    free(real);
+    free(imag);
+    free(sourceReal);
+    free(sourceImag);
+}
+
+// LargeFFT above the FFTComplex and FFTReal sizes, up to 2^20.
+static void benchmarkLargeFFT() {
+    const unsigned int maxSize = 1u << 20;
+    float *real = (float *)malloc(maxSize * sizeof(float)), *imag = (float *)malloc(maxSize * sizeof(float));
+    float *sourceReal = (float *)malloc(maxSize * sizeof(float)), *sourceImag = (float *)malloc(maxSize * sizeof(float));
+    float *inverseReal = (float *)malloc(maxSize * sizeof(float)), *inverseImag = (float *)malloc(maxSize * sizeof(float));
+    fillNoise(sourceReal, maxSize);
+    fillNoise(sourceImag, maxSize);
+
+    for (unsigned int logSize = 13; logSize <= 20; logSize++) {
+        Superpowered::LargeFFT fft(logSize);
+        for (int kind = 0; kind < 2; kind++) {
+            const unsigned int size = 1u << logSize, values = (kind == 0) ? size : size / 2;
+            if ((kind == 1) && (logSize == 13)) continue; // FFTReal handles it directly.
+
+            memcpy(real, sourceReal, values * sizeof(float));
+            memcpy(imag, sourceImag, values * sizeof(float));
+            if (kind == 0) fft.complexFFT(real, imag, true); else fft.realFFT(real, imag, true);
+            memcpy(inverseReal, real, values * sizeof(float));
+            memcpy(inverseImag, imag, values * sizeof(float));
+
+            double baselineNs, baselineCycles;
+            measure([&] {
+                memcpy(real, sourceReal, values * sizeof(float));
+                memcpy(imag, sourceImag, values * sizeof(float));
+            }, baselineNs, baselineCycles);
+
+            for (int forward = 1; forward >= 0; forward--) {
+                float *sr = forward ? sourceReal : inverseReal, *si = forward ? sourceImag : inverseImag;
+                double ns, cy;
+                measure([&] {
+                    memcpy(real, sr, values * sizeof(float));
+                    memcpy(imag, si, values * sizeof(float));
+                    if (kind == 0) fft.complexFFT(real, imag, forward != 0); else fft.realFFT(real, imag, forward != 0);
+                }, ns, cy);
+                addResult("fft", (kind == 0) ? "LargeFFT.complexFFT" : "LargeFFT.realFFT", forward ? "forward" : "inverse", size, 1, ns - baselineNs, cy - baselineCycles);
+            }
+        }
+    }
+    free(real);
+    free(imag);
+    free(sourceReal);
+    free(sourceImag);
+    free(inverseReal);
+    free(inverseImag);
+}
+
+// BatchFFT with 64 transforms per call, at the sizes it interleaves and one size above. Compare with the per-buffer FFTComplex and FFTReal results.
+static void benchmarkBatchFFT() {
+    const unsigned int numTransforms = 64, maxValues = 1u << 8, total = numTransforms * maxValues;
+    float *memory = (float *)malloc(total * 2 * sizeof(float)), *source = (float *)malloc(total * 2 * sizeof(float)), *inverse = (float *)malloc(total * 2 * sizeof(float));
+    fillNoise(source, total * 2);
+
+    for (unsigned int logSize = 4; logSize <= 9; logSize++) {
+        Superpowered::BatchFFT fft(logSize);
+        for (int kind = 0; kind < 2; kind++) {
+            if (((kind == 0) && (logSize > 8)) || ((kind == 1) && (logSize < 5))) continue;
+            const unsigned int size = 1u << logSize, values = (kind == 0) ? size : size / 2, bytes = numTransforms * values * 2 * sizeof(float);
+            float *real[numTransforms], *imag[numTransforms];
+            for (unsigned int n = 0; n < numTransforms; n++) {
+                real[n] = memory + n * values * 2;
+                imag[n] = real[n] + values;
+            }
+
+            memcpy(memory, source, bytes);
+            if (kind == 0) fft.complexFFT(real, imag, numTransforms, true); else fft.realFFT(real, imag, numTransforms, true);
+            memcpy(inverse, memory, bytes);
+
+            double baselineNs, baselineCycles;
+            measure([&] { memcpy(memory, source, bytes); }, baselineNs, baselineCycles);
+
+            for (int forward = 1; forward >= 0; forward--) {
+                const float *from = forward ? source : inverse;
+                double ns, cy;
+                measure([&] {
+                    memcpy(memory, from, bytes);
+                    if (kind == 0) fft.complexFFT(real, imag, numTransforms, forward != 0); else fft.realFFT(real, imag, numTransforms, forward != 0);
+                }, ns, cy);
+                addResult("fft", (kind == 0) ? "BatchFFT.complexFFT" : "BatchFFT.realFFT", forward ? "forward" : "inverse", size, numTransforms, ns - baselineNs, cy - baselineCycles);
+            }
+        }
+    }
+    free(memory);
+    free(source);
+    free(inverse);
+}
+
+// MixedRadixFFT at the audio frame sizes of 10 and 20 ms, and a power of two for comparison with FFTComplex and FFTReal.
+static void benchmarkMixedRadixFFT() {
+    static const unsigned int sizes[] = { 240, 441, 480, 512, 882, 960, 1920 };
+    const unsigned int maxSize = 1920;
+    float *real = (float *)malloc(maxSize * sizeof(float)), *imag = (float *)malloc(maxSize * sizeof(float));
+    float *sourceReal = (float *)malloc(maxSize * sizeof(float)), *sourceImag = (float *)malloc(maxSize * sizeof(float));
+    float *inverseReal = (float *)malloc(maxSize * sizeof(float)), *inverseImag = (float *)malloc(maxSize * sizeof(float));
+    fillNoise(sourceReal, maxSize);
+    fillNoise(sourceImag, maxSize);
+
+    for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        const unsigned int size = sizes[s];
+        Superpowered::MixedRadixFFT fft(size);
+        for (int kind = 0; kind < 2; kind++) {
+            if ((kind == 1) && (size & 1)) continue; // The real FFT needs an even size.
+            const unsigned int values = (kind == 0) ? size : size / 2;
+
+            memcpy(real, sourceReal, values * sizeof(float));
+            memcpy(imag, sourceImag, values * sizeof(float));
+            if (kind == 0) fft.complexFFT(real, imag, true); else fft.realFFT(real, imag, true);
+            memcpy(inverseReal, real, values * sizeof(float));
+            memcpy(inverseImag, imag, values * sizeof(float));
+
+            double baselineNs, baselineCycles;
+            measure([&] {
+                memcpy(real, sourceReal, values * sizeof(float));
+                memcpy(imag, sourceImag, values * sizeof(float));
+            }, baselineNs, baselineCycles);
+
+            for (int forward = 1; forward >= 0; forward--) {
+                float *sr = forward ? sourceReal : inverseReal, *si = forward ? sourceImag : inverseImag;
+                double ns, cy;
+                measure([&] {
+                    memcpy(real, sr, values * sizeof(float));
+                    memcpy(imag, si, values * sizeof(float));
+                    if (kind == 0) fft.complexFFT(real, imag, forward != 0); else fft.realFFT(real, imag, forward != 0);
+                }, ns, cy);
+                addResult("fft", (kind == 0) ? "MixedRadixFFT.complexFFT" : "MixedRadixFFT.realFFT", forward ? "forward" : "inverse", size, 1, ns - baselineNs, cy - baselineCycles);
+            }
+        }
+    }
+    free(real);
+    free(imag);
+    free(sourceReal);
+    free(sourceImag);
+    free(inverseReal);
+    free(inverseImag);
+}
+
+// DoubleFFT at the FFTComplex/FFTReal sizes for comparison with float, and the long transforms of impulse response measurements.
+static void benchmarkDoubleFFT() {
+    const unsigned int maxSize = 1u << 18;
+    double *real = (double *)malloc(maxSize * sizeof(double)), *imag = (double *)malloc(maxSize * sizeof(double));
+    double *sourceReal = (double *)malloc(maxSize * sizeof(double)), *sourceImag = (double *)malloc(maxSize * sizeof(double));
+    double *inverseReal = (double *)malloc(maxSize * sizeof(double)), *inverseImag = (double *)malloc(maxSize * sizeof(double));
+    for (unsigned int n = 0; n < maxSize; n++) {
+        sourceReal[n] = double(rand()) / double(RAND_MAX) - 0.5;
+        sourceImag[n] = double(rand()) / double(RAND_MAX) - 0.5;
+    }
+
+    for (unsigned int logSize = 8; logSize <= 18; logSize += 2) {
+        Superpowered::DoubleFFT fft(logSize);
+        for (int kind = 0; kind < 2; kind++) {
+            const unsigned int size = 1u << logSize, values = (kind == 0) ? size : size / 2;
+
+            memcpy(real, sourceReal, values * sizeof(double));
+            memcpy(imag, sourceImag, values * sizeof(double));
+            if (kind == 0) fft.complexFFT(real, imag, true); else fft.realFFT(real, imag, true);
+            memcpy(inverseReal, real, values * sizeof(double));
+            memcpy(inverseImag, imag, values * sizeof(double));
+
+            double baselineNs, baselineCycles;
+            measure([&] {
+                memcpy(real, sourceReal, values * sizeof(double));
+                memcpy(imag, sourceImag, values * sizeof(double));
+            }, baselineNs, baselineCycles);
+
+            for (int forward = 1; forward >= 0; forward--) {
+                double *sr = forward ? sourceReal : inverseReal, *si = forward ? sourceImag : inverseImag;
+                double ns, cy;
+                measure([&] {
+                    memcpy(real, sr, values * sizeof(double));
+                    memcpy(imag, si, values * sizeof(double));
+                    if (kind == 0) fft.complexFFT(real, imag, forward != 0); else fft.realFFT(real, imag, forward != 0);
+                }, ns, cy);
+                addResult("fft", (kind == 0) ? "DoubleFFT.complexFFT" : "DoubleFFT.realFFT", forward ? "forward" : "inverse", size, 1, ns - baselineNs, cy - baselineCycles);
+            }
+        }
+    }
+    free(real);
+    free(imag);
+    free(sourceReal);
+    free(sourceImag);
+    free(inverseReal);
+    free(inverseImag);
+}
+
+// MultichannelFrequencyDomain round trip (forward, inverse and advance) of one step, 16 channels in the calling thread.
+static void benchmarkMultichannelFrequencyDomain() {
+    const unsigned int numChannels = 16, logSize = 11, size = 1u << logSize, step = size / 4;
+    Superpowered::MultichannelFrequencyDomain frequencyDomain(numChannels, logSize);
+    float *input = (float *)malloc(step * numChannels * sizeof(float)), *outputFrames = (float *)malloc(step * numChannels * sizeof(float));
+    float *spectra = (float *)malloc(size * numChannels * sizeof(float)), *magnitudes[numChannels], *phases[numChannels];
+    fillNoise(input, step * numChannels);
+    for (unsigned int c = 0; c < numChannels; c++) {
+        magnitudes[c] = spectra + c * size;
+        phases[c] = magnitudes[c] + size / 2;
+    }
+    while (frequencyDomain.getNumberOfInputFramesNeeded() > 0) frequencyDomain.addInput(input, step);
+
+    benchmark("fft", "MultichannelFrequencyDomain", "16 channels", step, numChannels, [&] {
+        frequencyDomain.addInput(input, step);
+        frequencyDomain.timeDomainToFrequencyDomain(magnitudes, phases);
+        frequencyDomain.frequencyDomainToTimeDomain(magnitudes, phases, outputFrames);
+        frequencyDomain.advance();
+    });
+    free(input);
+    free(outputFrames);
+    free(spectra);
+}
+
+static void benchmarkConstantQ() {
+    Superpowered::ConstantQ constantQ(samplerate);
+    const unsigned int hop = constantQ.getHopFrames();
+    float *input = (float *)malloc(hop * sizeof(float)), *magnitudes = (float *)malloc(constantQ.getNumberOfBins() * sizeof(float));
+    fillNoise(input, hop);
+    while (!constantQ.process(magnitudes)) constantQ.addInput(input, hop);
+
+    benchmark("fft", "ConstantQ", "12 bins per octave", hop, 1, [&] {
+        constantQ.addInput(input, hop);
+        constantQ.process(magnitudes);
+    });
+    free(input);
+    free(magnitudes);
+}
+
+static void benchmarkSpectrogram() {
+    const unsigned int numFrames = samplerate * 10;
+    float *input = (float *)malloc(numFrames * sizeof(float));
+    fillNoise(input, numFrames);
+    Superpowered::Spectrogram linear(samplerate, 11, 512, 0, 0, 0, 1), mel(samplerate, 11, 512, 128, 0, 0, 1);
+    float *output = (float *)malloc(linear.getNumberOfFrames(numFrames) * linear.getNumberOfBands() * sizeof(float));
+
+    benchmark("fft", "Spectrogram", "linear, 1 thread", numFrames, 1, [&] { linear.process(input, numFrames, output); });
+    benchmark("fft", "Spectrogram", "128 mel, 1 thread", numFrames, 1, [&] { mel.process(input, numFrames, output); });
+    free(input);
+    free(output);
+}
+
+static void benchmarkFX(const char *name, Superpowered::FX *fx) {
+    fx->enabled = true;
+    for (unsigned int s = 0; s < numFxBufferSizes; s++) {
+        const unsigned int n = fxBufferSizes[s];
+        benchmark("fx", name, "", n, 2, [&] { fx->process(inputA, output, n); });
+    }
+    delete fx;
+}
+
+static void benchmarkEffects() {
+    benchmarkFX("ThreeBandEQ", new Superpowered::ThreeBandEQ(samplerate));
+    benchmarkFX("Bitcrusher", new Superpowered::Bitcrusher(samplerate));
+    benchmarkFX("Compressor", new Superpowered::Compressor(samplerate));
+    benchmarkFX("Compressor2", new Superpowered::Compressor2(samplerate));
+    benchmarkFX("Echo", new Superpowered::Echo(samplerate));
+    static const struct { Superpowered::Filter::FilterType type; const char *name; } filters[7] = {
+        { Superpowered::Filter::Resonant_Lowpass, "Filter.Resonant_Lowpass" },
+        { Superpowered::Filter::Resonant_Highpass, "Filter.Resonant_Highpass" },
+        { Superpowered::Filter::Bandlimited_Bandpass, "Filter.Bandlimited_Bandpass" },
+        { Superpowered::Filter::Bandlimited_Notch, "Filter.Bandlimited_Notch" },
+        { Superpowered::Filter::LowShelf, "Filter.LowShelf" },
+        { Superpowered::Filter::HighShelf, "Filter.HighShelf" },
+        { Superpowered::Filter::Parametric, "Filter.Parametric" }
+    };
+    for (int n = 0; n < 7; n++) {
+        Superpowered::Filter *filter = new Superpowered::Filter(filters[n].type, samplerate);
+        filter->frequency = 1000.0f;
+        filter->decibel = 6.0f;
+        benchmarkFX(filters[n].name, filter);
+    }
+    benchmarkFX("Flanger", new Superpowered::Flanger(samplerate));
+    benchmarkFX("Gate", new Superpowered::Gate(samplerate));
+    benchmarkFX("GuitarDistortion", new Superpowered::GuitarDistortion(samplerate));
+    benchmarkFX("Limiter", new Superpowered::Limiter(samplerate));
+    benchmarkFX("Reverb", new Superpowered::Reverb(samplerate));
+    benchmarkFX("Roll", new Superpowered::Roll(samplerate));
+    benchmarkFX("Whoosh", new Superpowered::Whoosh(samplerate));
+
+    // Open-source effects.
+    float frequencies[] = { 100.0f, 300.0f, 1000.0f, 3000.0f, 10000.0f, 0.0f };
+    SuperpoweredNBandEQ *nbandeq = new SuperpoweredNBandEQ(samplerate, frequencies);
+    for (unsigned int n = 0; n < 5; n++) nbandeq->setGainDb(n, 3.0f);
+    benchmarkFX("NBandEQ", nbandeq);
+    benchmarkFX("TruePeakLimiter", new Superpowered::TruePeakLimiter(samplerate));
+
+    // The same effect on planar buffers, the difference to the interleaved Echo above is the cost of the conversions.
+    Superpowered::Echo echo(samplerate);
+    echo.enabled = true;
+    Superpowered::PlanarFX planarEcho(&echo);
+    float *planarInput[2] = { left, right }, *planarOutput[2] = { inputC, inputD };
+    for (unsigned int s = 0; s < numFxBufferSizes; s++) {
+        const unsigned int n = fxBufferSizes[s];
+        benchmark("fx", "PlanarFX", "Echo", n, 2, [&] { planarEcho.process(Superpowered::SIMD::PlanarBuffer(planarInput, 2, n), Superpowered::SIMD::PlanarBuffer(planarOutput, 2, n)); });
+    }
+
+    // 2 seconds true stereo impulse response. The tail partitions are computed in process() too, so their cost is measured (amortized over the calls).
+    const unsigned int irFrames = samplerate * 2;
+    float *irs[4];
+    for (int n = 0; n < 4; n++) {
+        irs[n] = (float *)malloc(irFrames * sizeof(float));
+        fillNoise(irs[n], irFrames);
+    }
+    Superpowered::Convolver *convolver = new Superpowered::Convolver(samplerate, 2, 2, 128, true, false);
+    convolver->setImpulseResponse(irs, 4, irFrames);
+    benchmarkFX("Convolver", convolver);
+    for (int n = 0; n < 4; n++) free(irs[n]);
+}
+
+// 44100 to 48000 Hz stereo, frames is the number of input frames per call.
+static void benchmarkPolyphaseResampler() {
+    static const struct { Superpowered::PolyphaseResampler::Quality quality; const char *name; } qualities[4] = {
+        { Superpowered::PolyphaseResampler::Quality_Low, "Low" },
+        { Superpowered::PolyphaseResampler::Quality_Normal, "Normal" },
+        { Superpowered::PolyphaseResampler::Quality_High, "High" },
+        { Superpowered::PolyphaseResampler::Quality_Best, "Best" }
+    };
+    for (int q = 0; q < 4; q++) {
+        Superpowered::PolyphaseResampler resampler(2, 44100, 48000, qualities[q].quality, maxFrames);
+        for (unsigned int s = 0; s < numFxBufferSizes; s++) {
+            const unsigned int n = fxBufferSizes[s];
+            benchmark("fx", "PolyphaseResampler", qualities[q].name, n, 2, [&] { resampler.process(inputA, n, output, resampler.getMaxOutputFrames(n)); });
+        }
+    }
+}
+
+static std::string cpuName() {
+    std::string name = "unknown";
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (!f) return name;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "model name", 10) && strncmp(line, "Hardware", 8)) continue;
+        const char *value = strchr(line, ':');
+        if (!value) continue;
+        name = value + 1;
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t\r\n") + 1);
+        break;
+    }
+    fclose(f);
+    std::string escaped; // JSON string escaping.
+    for (size_t n = 0; n < name.size(); n++) {
+        if ((name[n] == '"') || (name[n] == '\\')) escaped += '\\';
+        escaped += name[n];
+    }
+    return escaped;
+}
+
+int main(int argc, char *argv[]) {
+    Superpowered::Initialize("ExampleLicenseKey-WillExpire-OnNextUpdate");
+    for (int n = 1; n < argc; n++) if (!strcmp(argv[n], "--quick")) targetRepeatNs = 200000.0;
+
+    srand(1);
+    inputA = (float *)malloc(maxFrames * 8 * sizeof(float));
+    inputB = (float *)malloc(maxFrames * 8 * sizeof(float));
+    inputC = (float *)malloc(maxFrames * 8 * sizeof(float));
+    inputD = (float *)malloc(maxFrames * 8 * sizeof(float));
+    output = (float *)malloc(maxFrames * 8 * sizeof(float));
+    left = (float *)malloc(maxFrames * sizeof(float));
+    right = (float *)malloc(maxFrames * sizeof(float));
+    shortBuffer = (short int *)malloc(maxFrames * 8 * sizeof(short int));
+    intBuffer = (int *)malloc(maxFrames * 8 * sizeof(int));
+    charBuffer = (signed char *)malloc(maxFrames * 8);
+    fillNoise(inputA, maxFrames * 8);
+    fillNoise(inputB, maxFrames * 8);
+    fillNoise(inputC, maxFrames * 8);
+    fillNoise(inputD, maxFrames * 8);
+    fillNoise(output, maxFrames * 8);
+    fillNoise(left, maxFrames);
+    fillNoise(right, maxFrames);
+    Superpowered::FloatToShortInt(inputA, shortBuffer, maxFrames * 4);
+    Superpowered::FloatToInt(inputA, intBuffer, maxFrames * 4);
+    Superpowered::FloatToChar(inputA, charBuffer, maxFrames * 4);
+
+    benchmarkSimple();
+    benchmarkSIMD();
+    benchmarkHalfAudio();
+    benchmarkLoudnessMeter();
+    benchmarkFFT();
+    benchmarkLargeFFT();
+    benchmarkBatchFFT();
+    benchmarkMixedRadixFFT();
+    benchmarkDoubleFFT();
+    benchmarkMultichannelFrequencyDomain();
+    benchmarkConstantQ();
+    benchmarkSpectrogram();
+    benchmarkEffects();
+    benchmarkPolyphaseResampler();
+
+    printf("{\n  \"timestamp\": %lld,\n  \"cpu\": \"%s\",\n  \"simdPath\": \"%s\",\n  \"cycleCounter\": \"%s\",\n  \"results\": [%s\n  ]\n}\n",
+           (long long)time(NULL), cpuName().c_str(), Superpowered::SIMD::PathToString(Superpowered::SIMD::BestPath()), cycles() ? "tsc" : "none", json.c_str());
+
+    free(inputA);
+    free(inputB);
+    free(inputC);
+    free(inputD);
+    free(output);
+    free(left);
+    free(right);
+    free(shortBuffer);
+    free(intBuffer);
+    free(charBuffer);
+    return 0;
+}
@@ -0,0 +1,321 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+#include "Superpowered.h"
+#include "SuperpoweredFFT.h"
+
+// EXAMPLE: headless FFT accuracy and throughput test, the Linux version of Examples_iOS/SuperpoweredPerformance/fftTest.h.
+// Instead of vDSP, every FFTComplex, FFTReal and PolarFFT result is checked against a double precision DFT, at every supported logSize, in both directions.
+// Usage: ./fftTest
+// Prints a table with the largest errors and the speed of every transform. Returns with 0 if every error is within the limits below, 1 otherwise.
+
+// Complex and real results, forward and inverse. The largest sum of the real and imaginary error of one bin or sample, after scaling the output to the -1..1 range of the input (dividing by the FFT size).
+#define vdspdiff 0.000001f
+
+// Magnitude error of the polar FFT, relative to the largest magnitude. 0.01 percent, max. -80 decibel.
+#define magnitudediff 0.0001f
+
+// Phase error of the polar FFT, relative to a full circle. 0.65 percent, max. 2.34 degrees.
+#define phasediff 0.0065f
+
+// Inverse polar FFT error, after scaling the output to the range of the input. 1.7 percent.
+#define invpolardiff 0.017f
+
+static const int numSignals = 2; // Every check runs with a ramp (the same as fftTest.h) and with white noise.
+
+static inline uint64_t nowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Fills the input with values from -1.0f to 1.0f (signal 0) or white noise (signal 1).
+static void fillInput(float *values, int numValues, int signal) {
+    if (signal == 0) {
+        const float step = 2.0f / float(numValues);
+        for (int n = 0; n < numValues; n++) values[n] = -1.0f + float(n) * step;
+    } else for (int n = 0; n < numValues; n++) values[n] = float(rand()) / float(RAND_MAX) * 2.0f - 1.0f;
+}
+
+// Double precision DFT with an exact twiddle table. sign = -1 for forward, +1 for inverse. No scaling.
+static void referenceDFT(const double *inReal, const double *inImag, double *outReal, double *outImag, int size, int sign, int numOutputs) {
+    double *cosTable = (double *)malloc(size * sizeof(double)), *sinTable = (double *)malloc(size * sizeof(double));
+    for (int n = 0; n < size; n++) {
+        cosTable[n] = cos(2.0 * M_PI * double(n) / double(size));
+        sinTable[n] = double(sign) * sin(2.0 * M_PI * double(n) / double(size));
+    }
+    for (int k = 0; k < numOutputs; k++) {
+        double r = 0, i = 0;
+        for (int n = 0, index = 0; n < size; n++, index = (index + k) & (size - 1)) {
+            r += inReal[n] * cosTable[index] - inImag[n] * sinTable[index];
+            i += inReal[n] * sinTable[index] + inImag[n] * cosTable[index];
+        }
+        outReal[k] = r;
+        outImag[k] = i;
+    }
+    free(cosTable);
+    free(sinTable);
+}
+
+// Runs a transform iterations times, restoring the input before every call. Returns with the elapsed time in nanoseconds.
+// kind: 0 = FFTComplex, 1 = FFTReal, 2 = PolarFFT, -1 = restoring the input only.
+static double run(int kind, float *real, float *imag, const float *sourceReal, const float *sourceImag, int numValues, int logSize, bool forward, int iterations) {
+    const uint64_t start = nowNs();
+    for (int n = 0; n < iterations; n++) {
+        memcpy(real, sourceReal, numValues * sizeof(float));
+        memcpy(imag, sourceImag, numValues * sizeof(float));
+        if (kind == 0) Superpowered::FFTComplex(real, imag, logSize, forward);
+        else if (kind == 1) Superpowered::FFTReal(real, imag, logSize, forward);
+        else if (kind == 2) Superpowered::PolarFFT(real, imag, logSize, forward);
+    }
+    return double(nowNs() - start);
+}
+
+// Average time of one transform in nanoseconds, without the cost of restoring the input.
+// Each of the 10 measurements runs for about 1 ms. Like in fftTest.h, high values (when the thread is interrupted for example) are filtered out.
+static double measure(int kind, float *real, float *imag, const float *sourceReal, const float *sourceImag, int numValues, int logSize, bool forward) {
+    double results[2];
+    for (int pass = 0; pass < 2; pass++) { // Pass 0 measures restoring the input only.
+        const int k = pass ? kind : -1;
+        int iterations = 1; // Warm up and find the number of iterations.
+        while ((iterations < (1 << 20)) && (run(k, real, imag, sourceReal, sourceImag, numValues, logSize, forward, iterations) < 1000000.0)) iterations *= 2;
+
+        double values[10], smallest = 0, sum = 0;
+        for (int m = 0; m < 10; m++) {
+            values[m] = run(k, real, imag, sourceReal, sourceImag, numValues, logSize, forward, iterations) / double(iterations);
+            if ((m == 0) || (values[m] < smallest)) smallest = values[m];
+        }
+        int goodValues = 0;
+        for (int m = 0; m < 10; m++) if (values[m] <= smallest * 2.0) {
+            goodValues++;
+            sum += values[m];
+        }
+        results[pass] = sum / double(goodValues);
+    }
+    const double ns = results[1] - results[0];
+    return ns > 0 ? ns : 0;
+}
+
+struct result {
+    double forwardError, inverseError, forwardPhaseError; // For the polar FFT forwardError is the magnitude error.
+    double forwardNs, inverseNs;
+};
+
+// FFTComplex: forward and inverse are unscaled, vDSP_fft_zip compatible.
+static result testComplex(int logSize) {
+    const int size = 1 << logSize;
+    float *real = (float *)malloc(size * sizeof(float)), *imag = (float *)malloc(size * sizeof(float));
+    float *sourceReal = (float *)malloc(size * sizeof(float)), *sourceImag = (float *)malloc(size * sizeof(float));
+    double *inReal = (double *)malloc(size * sizeof(double)), *inImag = (double *)malloc(size * sizeof(double));
+    double *outReal = (double *)malloc(size * sizeof(double)), *outImag = (double *)malloc(size * sizeof(double));
+    result r = { 0, 0, 0, 0, 0 };
+    const double scale = 1.0 / double(size);
+
+    for (int signal = 0; signal < numSignals; signal++) {
+        fillInput(sourceReal, size, signal);
+        fillInput(sourceImag, size, signal);
+        if (signal == 0) for (int n = 0; n < size; n++) sourceImag[n] += 1.0f; // fftTest.h: imag = 1 + real.
+
+        // Forward.
+        for (int n = 0; n < size; n++) {
+            inReal[n] = real[n] = sourceReal[n];
+            inImag[n] = imag[n] = sourceImag[n];
+        }
+        referenceDFT(inReal, inImag, outReal, outImag, size, -1, size);
+        Superpowered::FFTComplex(real, imag, logSize, true);
+        for (int n = 0; n < size; n++) {
+            double error = (fabs(double(real[n]) - outReal[n]) + fabs(double(imag[n]) - outImag[n])) * scale;
+            if (!isfinite(real[n]) || !isfinite(imag[n])) error = INFINITY;
+            if (error > r.forwardError) r.forwardError = error;
+        }
+
+        // Inverse, with the correct spectrum as input.
+        for (int n = 0; n < size; n++) {
+            inReal[n] = real[n] = float(outReal[n]);
+            inImag[n] = imag[n] = float(outImag[n]);
+        }
+        referenceDFT(inReal, inImag, outReal, outImag, size, 1, size);
+        Superpowered::FFTComplex(real, imag, logSize, false);
+        for (int n = 0; n < size; n++) {
+            double error = (fabs(double(real[n]) - outReal[n]) + fabs(double(imag[n]) - outImag[n])) * scale;
+            if (!isfinite(real[n]) || !isfinite(imag[n])) error = INFINITY;
+            if (error > r.inverseError) r.inverseError = error;
+        }
+    }
+
+    // Throughput with the last signal.
+    r.forwardNs = measure(0, real, imag, sourceReal, sourceImag, size, logSize, true);
+    for (int n = 0; n < size; n++) {
+        sourceReal[n] = float(inReal[n]);
+        sourceImag[n] = float(inImag[n]);
+    }
+    r.inverseNs = measure(0, real, imag, sourceReal, sourceImag, size, logSize, false);
+
+    free(real);
+    free(imag);
+    free(sourceReal);
+    free(sourceImag);
+    free(inReal);
+    free(inImag);
+    free(outReal);
+    free(outImag);
+    return r;
+}
+
+// FFTReal and PolarFFT: the input is packed into real (even samples) and imag (odd samples). vDSP_fft_zrip compatible, so the forward output is 2x the DFT, with the Nyquist bin in imag[0].
+// The inverse output is 2 * size times the signal. The inverse PolarFFT clears the DC offset and the Nyquist bin.
+static result testReal(int logSize, bool polar) {
+    const int size = 1 << logSize, half = size / 2;
+    float *real = (float *)malloc(half * sizeof(float)), *imag = (float *)malloc(half * sizeof(float));
+    float *sourceReal = (float *)malloc(half * sizeof(float)), *sourceImag = (float *)malloc(half * sizeof(float));
+    float *interleaved = (float *)malloc(size * sizeof(float));
+    double *inReal = (double *)malloc(size * sizeof(double)), *inImag = (double *)malloc(size * sizeof(double));
+    double *outReal = (double *)malloc(size * sizeof(double)), *outImag = (double *)malloc(size * sizeof(double));
+    result r = { 0, 0, 0, 0, 0 };
+    const double scale = 0.5 / double(size);
+
+    for (int signal = 0; signal < numSignals; signal++) {
+        fillInput(interleaved, size, signal);
+        for (int n = 0; n < half; n++) {
+            sourceReal[n] = real[n] = interleaved[n * 2];
+            sourceImag[n] = imag[n] = interleaved[n * 2 + 1];
+        }
+        for (int n = 0; n < size; n++) {
+            inReal[n] = interleaved[n];
+            inImag[n] = 0;
+        }
+        referenceDFT(inReal, inImag, outReal, outImag, size, -1, half + 1);
+
+        // Forward.
+        if (polar) {
+            Superpowered::PolarFFT(real, imag, logSize, true);
+            double peak = 0;
+            for (int n = 1; n < half; n++) {
+                const double magnitude = hypot(outReal[n], outImag[n]);
+                if (magnitude > peak) peak = magnitude;
+            }
+            for (int n = 1; n < half; n++) { // PolarFFT returns with zero magnitude and phase for the DC offset.
+                const double magnitude = 2.0 * hypot(outReal[n], outImag[n]), phase = atan2(outImag[n], outReal[n]);
+                double magError = fabs(double(real[n]) - magnitude) / (2.0 * peak);
+                double phaseError = fabs(double(imag[n]) - phase);
+                if (phaseError > M_PI) phaseError = 2.0 * M_PI - phaseError; // -pi and pi are the same.
+                phaseError /= 2.0 * M_PI;
+                if (!isfinite(real[n]) || !isfinite(imag[n])) magError = INFINITY;
+                if (magError > r.forwardError) r.forwardError = magError;
+                if (phaseError > r.forwardPhaseError) r.forwardPhaseError = phaseError;
+            }
+        } else {
+            Superpowered::FFTReal(real, imag, logSize, true);
+            for (int n = 0; n < half; n++) {
+                const double expectedReal = 2.0 * outReal[n], expectedImag = (n == 0) ? 2.0 * outReal[half] : 2.0 * outImag[n];
+                double error = (fabs(double(real[n]) - expectedReal) + fabs(double(imag[n]) - expectedImag)) * scale;
+                if (!isfinite(real[n]) || !isfinite(imag[n])) error = INFINITY;
+                if (error > r.forwardError) r.forwardError = error;
+            }
+        }
+
+        // Inverse, with the correct spectrum as input.
+        for (int n = 0; n < half; n++) {
+            if (polar) {
+                sourceReal[n] = real[n] = (n == 0) ? 0.0f : float(2.0 * hypot(outReal[n], outImag[n]));
+                sourceImag[n] = imag[n] = (n == 0) ? 0.0f : float(atan2(outImag[n], outReal[n]));
+            } else {
+                sourceReal[n] = real[n] = float(2.0 * outReal[n]);
+                sourceImag[n] = imag[n] = float(2.0 * ((n == 0) ? outReal[half] : outImag[n]));
+            }
+        }
+        // The reference signal is the inverse DFT of the same single precision spectrum, with the conjugate symmetric upper half.
+        inReal[0] = polar ? 0 : double(real[0]) * 0.5;
+        inImag[0] = 0;
+        inReal[half] = polar ? 0 : double(imag[0]) * 0.5;
+        inImag[half] = 0;
+        for (int n = 1; n < half; n++) {
+            double re, im;
+            if (polar) {
+                re = double(real[n]) * cos(double(imag[n])) * 0.5;
+                im = double(real[n]) * sin(double(imag[n])) * 0.5;
+            } else {
+                re = double(real[n]) * 0.5;
+                im = double(imag[n]) * 0.5;
+            }
+            inReal[n] = inReal[size - n] = re;
+            inImag[n] = im;
+            inImag[size - n] = -im;
+        }
+        referenceDFT(inReal, inImag, outReal, outImag, size, 1, size);
+
+        if (polar) Superpowered::PolarFFT(real, imag, logSize, false); else Superpowered::FFTReal(real, imag, logSize, false);
+        for (int n = 0; n < half; n++) {
+            double error = polar ? fmax(fabs(double(real[n]) * scale - outReal[n * 2] / double(size)), fabs(double(imag[n]) * scale - outReal[n * 2 + 1] / double(size)))
+                                 : (fabs(double(real[n]) * scale - outReal[n * 2] / double(size)) + fabs(double(imag[n]) * scale - outReal[n * 2 + 1] / double(size)));
+            if (!isfinite(real[n]) || !isfinite(imag[n])) error = INFINITY;
+            if (error > r.inverseError) r.inverseError = error;
+        }
+
+        // Restore the forward input for the throughput measurement.
+        if (signal == numSignals - 1) {
+            float *inverseReal = (float *)malloc(half * sizeof(float)), *inverseImag = (float *)malloc(half * sizeof(float));
+            memcpy(inverseReal, sourceReal, half * sizeof(float));
+            memcpy(inverseImag, sourceImag, half * sizeof(float));
+            for (int n = 0; n < half; n++) {
+                sourceReal[n] = interleaved[n * 2];
+                sourceImag[n] = interleaved[n * 2 + 1];
+            }
+            r.forwardNs = measure(polar ? 2 : 1, real, imag, sourceReal, sourceImag, half, logSize, true);
+            r.inverseNs = measure(polar ? 2 : 1, real, imag, inverseReal, inverseImag, half, logSize, false);
+            free(inverseReal);
+            free(inverseImag);
+        }
+    }
+
+    free(real);
+    free(imag);
+    free(sourceReal);
+    free(sourceImag);
+    free(interleaved);
+    free(inReal);
+    free(inImag);
+    free(outReal);
+    free(outImag);
+    return r;
+}
+
+int main(int argc, char *argv[]) {
+    Superpowered::Initialize("ExampleLicenseKey-WillExpire-OnNextUpdate");
+    srand(1);
+    int failures = 0;
+
+    printf("        |      ||            forward             |        inverse         ||           speed (ns)          |\n");
+    printf("FFT     | size ||     error      | phase error   |         error          ||    forward    |    inverse    | MFLOPS\n");
+    printf("--------|------||----------------|---------------|------------------------||---------------|---------------|--------\n");
+
+    static const char *kind[3] = { "complex", "real   ", "polar  " };
+    for (int logSize = 4; logSize < 14; logSize++) {
+        for (int k = 0; k < 3; k++) {
+            if ((k == 0) && (logSize > 12)) continue; // FFTComplex: 16 - 4096.
+            if ((k > 0) && (logSize < 5)) continue;   // FFTReal and PolarFFT: 32 - 8192.
+
+            const result r = (k == 0) ? testComplex(logSize) : testReal(logSize, k == 2);
+            const double forwardLimit = (k == 2) ? magnitudediff : vdspdiff, inverseLimit = (k == 2) ? invpolardiff : vdspdiff;
+            const bool ok = (r.forwardError <= forwardLimit) && (r.inverseError <= inverseLimit) && (r.forwardPhaseError <= phasediff);
+            if (!ok) failures++;
+
+            // The usual FFT benchmark metric: 5 * N * log2(N) floating point operations for a complex FFT, half that for a real one.
+            const double flops = (k == 0 ? 5.0 : 2.5) * double(1 << logSize) * double(logSize);
+            char phaseText[32];
+            if (k == 2) snprintf(phaseText, sizeof(phaseText), "%13.3g", r.forwardPhaseError); else strcpy(phaseText, "            -");
+            printf("%s | %4i || %14.3g | %s | %22.3g || %13.1f | %13.1f | %6.0f %s\n", kind[k], 1 << logSize, r.forwardError, phaseText, r.inverseError,
+                   r.forwardNs, r.inverseNs, 2.0 * flops / (r.forwardNs + r.inverseNs) * 1000.0, ok ? "" : " FAILED");
+        }
+        printf("\n");
+    }
+
+    printf("Limits: complex and real %g, polar magnitude %g, polar phase %g, inverse polar %g.\n", vdspdiff, magnitudediff, phasediff, invpolardiff);
+    if (failures) printf("%i FAILED.\n", failures); else printf("PASSED.\n");
+    (void)argc;
+    (void)argv;
+    return failures ? 1 : 0;
+}
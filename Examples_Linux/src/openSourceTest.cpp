@@ -0,0 +1,282 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Superpowered.h"
+#include "SuperpoweredDecoder.h"
+#include "OpenSource/SuperpoweredSIMD.h"
+#include "OpenSource/SuperpoweredPolyphaseResampler.h"
+#include "OpenSource/SuperpoweredConvolver.h"
+#include "OpenSource/SuperpoweredIndexedDecoder.h"
+
+// EXAMPLE: headless behavior tests of the open-source classes in Superpowered/OpenSource, which can not be checked by the accuracy tests of fftTest.
+// Usage: ./openSourceTest [mp3 file]
+// The mp3 file is joined with itself for the IndexedDecoder test, default: ../Examples_macOS/ambi/ambi/ambi_01.mp3.
+// Prints one line per check. Returns with 0 if every check passed, 1 otherwise.
+
+static int failures = 0;
+
+static void check(bool ok, const char *name, const char *details) {
+    printf("%-64s %s %s\n", name, ok ? "ok    " : "FAILED", details);
+    if (!ok) failures++;
+}
+
+static void fillNoise(float *values, unsigned int numValues) {
+    for (unsigned int n = 0; n < numValues; n++) values[n] = float(rand()) / float(RAND_MAX) * 2.0f - 1.0f;
+}
+
+// FloatToHalf and HalfToFloat must give the same bits on every SIMD path (F16C on AVX2 and AVX-512), including denormals, infinity and NaN payloads.
+static void testHalfConversion() {
+    const unsigned int numValues = 65536 * 4;
+    float *floats = (float *)malloc(numValues * sizeof(float)), *referenceFloats = (float *)malloc(65536 * sizeof(float)), *convertedFloats = (float *)malloc(65536 * sizeof(float));
+    unsigned short *halves = (unsigned short *)malloc(65536 * sizeof(unsigned short)), *reference = (unsigned short *)malloc(numValues * sizeof(unsigned short)), *converted = (unsigned short *)malloc(numValues * sizeof(unsigned short));
+    // Every half converted to float and back to bits around it (rounding ties and overflow), and every NaN payload of the top 10 mantissa bits with random lower bits.
+    for (unsigned int n = 0; n < 65536; n++) halves[n] = (unsigned short)n;
+    Superpowered::SIMD::SetPath(Superpowered::SIMD::Path_Scalar);
+    Superpowered::SIMD::HalfToFloat(halves, referenceFloats, 65536);
+    for (unsigned int n = 0; n < 65536; n++) {
+        unsigned int bits;
+        memcpy(&bits, referenceFloats + n, 4);
+        const unsigned int values[3] = { bits, bits + 0x1000, (n & 0x8000) << 16 | 0x7f800000 | (n & 0x3ff) << 13 | (unsigned int)(rand() & 0x1fff) | 1 };
+        for (int k = 0; k < 3; k++) memcpy(floats + n * 4 + k, values + k, 4);
+        floats[n * 4 + 3] = float(rand()) / float(RAND_MAX) * 131072.0f - 65536.0f;
+    }
+    Superpowered::SIMD::FloatToHalf(floats, reference, numValues);
+    const Superpowered::SIMD::Path best = Superpowered::SIMD::BestPath();
+
+    for (int p = Superpowered::SIMD::Path_Scalar + 1; p <= best; p++) {
+        Superpowered::SIMD::SetPath((Superpowered::SIMD::Path)p);
+        Superpowered::SIMD::FloatToHalf(floats, converted, numValues);
+        Superpowered::SIMD::HalfToFloat(halves, convertedFloats, 65536);
+        unsigned int toHalf = 0, toFloat = 0;
+        for (unsigned int n = 0; n < numValues; n++) if (converted[n] != reference[n]) toHalf++;
+        for (unsigned int n = 0; n < 65536; n++) if (memcmp(convertedFloats + n, referenceFloats + n, 4)) toFloat++;
+        char name[128], details[128];
+        snprintf(name, sizeof(name), "FloatToHalf and HalfToFloat, %s", Superpowered::SIMD::PathToString((Superpowered::SIMD::Path)p));
+        snprintf(details, sizeof(details), "%u of %u to half, %u of 65536 to float differ", toHalf, numValues, toFloat);
+        check(!toHalf && !toFloat, name, details);
+    }
+    Superpowered::SIMD::SetPath(best);
+    free(floats);
+    free(referenceFloats);
+    free(convertedFloats);
+    free(halves);
+    free(reference);
+    free(converted);
+}
+
+// Resamples the input with enough output space on every call, then flush().
+static unsigned int resampleUnlimited(Superpowered::PolyphaseResampler &resampler, float *input, unsigned int numFrames, unsigned int blockFrames, float *output) {
+    const unsigned int numChannels = resampler.getNumChannels();
+    unsigned int outputFrames = 0;
+    for (unsigned int offset = 0; offset < numFrames; offset += blockFrames) {
+        const unsigned int n = (numFrames - offset < blockFrames) ? numFrames - offset : blockFrames;
+        outputFrames += resampler.process(input + offset * numChannels, n, output + outputFrames * numChannels, resampler.getMaxOutputFrames(n));
+    }
+    unsigned int n;
+    while ((n = resampler.flush(output + outputFrames * numChannels, 1024)) > 0) outputFrames += n;
+    return outputFrames;
+}
+
+// Resamples the input with a few output frames per call only, passing the input not taken to the next call, then flush().
+static unsigned int resampleLimited(Superpowered::PolyphaseResampler &resampler, float *input, unsigned int numFrames, unsigned int blockFrames, unsigned int maximumOutputFrames, float *output, unsigned int &inputFramesUsed) {
+    const unsigned int numChannels = resampler.getNumChannels();
+    unsigned int outputFrames = 0, offset = 0;
+    inputFramesUsed = 0;
+    while (offset < numFrames) {
+        const unsigned int n = (numFrames - offset < blockFrames) ? numFrames - offset : blockFrames;
+        outputFrames += resampler.process(input + offset * numChannels, n, output + outputFrames * numChannels, maximumOutputFrames);
+        offset += resampler.getInputFramesUsed();
+        inputFramesUsed += resampler.getInputFramesUsed();
+    }
+    unsigned int n;
+    while ((n = resampler.process(input, 0, output + outputFrames * numChannels, maximumOutputFrames)) > 0) outputFrames += n; // The input kept.
+    while ((n = resampler.flush(output + outputFrames * numChannels, maximumOutputFrames)) > 0) outputFrames += n;
+    return outputFrames;
+}
+
+// Limiting the output of PolyphaseResampler::process() must not lose input: the output has to be identical to the unlimited output.
+static void testPolyphaseResamplerLimitedOutput() {
+    static const struct { unsigned int inputSamplerate, outputSamplerate, numChannels, blockFrames, maximumOutputFrames; } cases[4] = {
+        { 48000, 44100, 2, 512, 37 },
+        { 44100, 48000, 2, 4096, 100 },
+        { 22050, 96000, 1, 1000, 7 },
+        { 96000, 32000, 3, 333, 50 }
+    };
+    const unsigned int numFrames = 48000;
+
+    for (int c = 0; c < 4; c++) {
+        const unsigned int numChannels = cases[c].numChannels, maximumOutput = numFrames * 5 + 4096;
+        float *input = (float *)malloc(numFrames * numChannels * sizeof(float));
+        float *unlimited = (float *)malloc(maximumOutput * numChannels * sizeof(float)), *limited = (float *)malloc(maximumOutput * numChannels * sizeof(float));
+        fillNoise(input, numFrames * numChannels);
+
+        Superpowered::PolyphaseResampler a(numChannels, cases[c].inputSamplerate, cases[c].outputSamplerate, Superpowered::PolyphaseResampler::Quality_Normal, cases[c].blockFrames);
+        Superpowered::PolyphaseResampler b(numChannels, cases[c].inputSamplerate, cases[c].outputSamplerate, Superpowered::PolyphaseResampler::Quality_Normal, cases[c].blockFrames);
+        unsigned int inputFramesUsed;
+        const unsigned int unlimitedFrames = resampleUnlimited(a, input, numFrames, cases[c].blockFrames, unlimited);
+        const unsigned int limitedFrames = resampleLimited(b, input, numFrames, cases[c].blockFrames, cases[c].maximumOutputFrames, limited, inputFramesUsed);
+        const unsigned int expectedFrames = (unsigned int)(((unsigned long long)numFrames * cases[c].outputSamplerate + cases[c].inputSamplerate - 1) / cases[c].inputSamplerate);
+        const bool ok = (inputFramesUsed == numFrames) && (unlimitedFrames == expectedFrames) && (limitedFrames == expectedFrames) && !memcmp(unlimited, limited, expectedFrames * numChannels * sizeof(float));
+
+        char name[128], details[128];
+        snprintf(name, sizeof(name), "PolyphaseResampler %u -> %u Hz, %u ch, %u output frames per call", cases[c].inputSamplerate, cases[c].outputSamplerate, numChannels, cases[c].maximumOutputFrames);
+        snprintf(details, sizeof(details), "input used %u/%u, output %u/%u/%u", inputFramesUsed, numFrames, limitedFrames, unlimitedFrames, expectedFrames);
+        check(ok, name, details);
+        free(input);
+        free(unlimited);
+        free(limited);
+    }
+}
+
+// Every SIMD path of Biquad2SumOfSquares must match the scalar path, with channel counts below and above the vector widths and buffer sizes which are not multiples of them.
+static void testBiquad2SumOfSquares() {
+    // The K-weighting filters of LoudnessMeter at 48000 Hz.
+    float coefficients[10] = { 1.53512486f, -2.69169619f, 1.19839281f, -1.69065929f, 0.73248077f, 1.0f, -2.0f, 1.0f, -1.99004745f, 0.99007225f };
+    static const unsigned int bufferSizes[6] = { 1, 17, 64, 255, 1000, 4096 };
+    const unsigned int maxChannels = 9, maxFrames = 4096;
+    float *input = (float *)malloc(maxFrames * maxChannels * sizeof(float));
+    fillNoise(input, maxFrames * maxChannels);
+    const Superpowered::SIMD::Path best = Superpowered::SIMD::BestPath();
+
+    for (unsigned int numChannels = 1; numChannels <= maxChannels; numChannels++) {
+        float referenceState[maxChannels * 4], reference[maxChannels];
+        memset(referenceState, 0, sizeof(referenceState));
+        memset(reference, 0, sizeof(reference));
+        Superpowered::SIMD::SetPath(Superpowered::SIMD::Path_Scalar);
+        for (unsigned int b = 0; b < 6; b++) Superpowered::SIMD::Biquad2SumOfSquares(input, bufferSizes[b], numChannels, coefficients, referenceState, reference);
+
+        for (int p = Superpowered::SIMD::Path_Scalar + 1; p <= best; p++) {
+            float state[maxChannels * 4], sumOfSquares[maxChannels];
+            memset(state, 0, sizeof(state));
+            memset(sumOfSquares, 0, sizeof(sumOfSquares));
+            Superpowered::SIMD::SetPath((Superpowered::SIMD::Path)p);
+            for (unsigned int b = 0; b < 6; b++) Superpowered::SIMD::Biquad2SumOfSquares(input, bufferSizes[b], numChannels, coefficients, state, sumOfSquares);
+
+            // The sums are compared relative to the reference. The state of the second filter (a highpass with its poles close to 1) differs by up to 0.0003 between any two paths because of rounding, so it has a looser absolute limit.
+            double sumError = 0, stateError = 0;
+            for (unsigned int ch = 0; ch < numChannels; ch++) {
+                sumError = fmax(sumError, fabs(double(sumOfSquares[ch]) / double(reference[ch]) - 1.0));
+                for (unsigned int z = 0; z < 4; z++) stateError = fmax(stateError, fabs(double(state[numChannels * z + ch]) - double(referenceState[numChannels * z + ch])));
+            }
+            char name[128], details[128];
+            snprintf(name, sizeof(name), "Biquad2SumOfSquares %u ch, %s", numChannels, Superpowered::SIMD::PathToString((Superpowered::SIMD::Path)p));
+            snprintf(details, sizeof(details), "sum error %.3g, state error %.3g", sumError, stateError);
+            check((sumError < 0.00001) && (stateError < 0.001), name, details);
+        }
+    }
+    Superpowered::SIMD::SetPath(best);
+    free(input);
+}
+
+// The dry signal of Convolver: output o gets input o % inputs, or the average of the inputs o, o + outputs... if there are more inputs than outputs.
+static void testConvolverDryMapping() {
+    static const unsigned int layouts[4][2] = { { 2, 1 }, { 3, 2 }, { 1, 2 }, { 2, 2 } };
+    const unsigned int numFrames = 1000;
+    float impulseResponse[300], *impulseResponses[64];
+    fillNoise(impulseResponse, 300);
+    for (int n = 0; n < 64; n++) impulseResponses[n] = impulseResponse;
+    float *input = (float *)malloc(numFrames * 8 * sizeof(float)), *output = (float *)malloc(numFrames * 8 * sizeof(float));
+
+    for (int l = 0; l < 4; l++) {
+        const unsigned int numInputs = layouts[l][0], numOutputs = layouts[l][1];
+        Superpowered::Convolver convolver(48000, numInputs, numOutputs, 64, false, false);
+        const bool ok = convolver.setImpulseResponse(impulseResponses, numInputs * numOutputs, 300);
+        convolver.enabled = true;
+        convolver.wet = 0;
+        convolver.dry = 1;
+        fillNoise(input, numFrames * numInputs);
+        convolver.process(input, output, numFrames); // The gains ramp from their previous values in the first call.
+        fillNoise(input, numFrames * numInputs);
+        convolver.process(input, output, numFrames);
+
+        double error = 0;
+        for (unsigned int n = 0; n < numFrames; n++) for (unsigned int o = 0; o < numOutputs; o++) {
+            double expected = 0;
+            unsigned int numMixed = 0;
+            if (numInputs <= numOutputs) expected = input[n * numInputs + o % numInputs], numMixed = 1;
+            else for (unsigned int i = o; i < numInputs; i += numOutputs, numMixed++) expected += input[n * numInputs + i];
+            error = fmax(error, fabs(double(output[n * numOutputs + o]) - expected / double(numMixed)));
+        }
+        char name[128], details[128];
+        snprintf(name, sizeof(name), "Convolver dry signal, %u to %u channels", numInputs, numOutputs);
+        snprintf(details, sizeof(details), "error %.3g", error);
+        check(ok && (error < 0.000001), name, details);
+    }
+    free(input);
+    free(output);
+}
+
+// Seeking IndexedDecoder to the start of every frame must return with the same audio as sequential decoding with Decoder.
+// The file is joined with itself: the padding frame at the end of the first copy and the Info frame of the second copy have no main data, which Decoder doesn't decode.
+static void testIndexedDecoderSeek(const char *mp3) {
+    static const char *path = "openSourceTest.mp3", *sidecar = "openSourceTest.mp3.spsi";
+    FILE *file = fopen(mp3, "rb");
+    long size = 0;
+    if (file && !fseek(file, 0, SEEK_END)) size = ftell(file);
+    unsigned char *data = (size > 0) ? (unsigned char *)malloc((size_t)size) : NULL;
+    bool ok = data && !fseek(file, 0, SEEK_SET) && (fread(data, 1, (size_t)size, file) == (size_t)size);
+    if (file) fclose(file);
+    if (ok) {
+        file = fopen(path, "wb");
+        ok = file && (fwrite(data, 1, (size_t)size, file) == (size_t)size) && (fwrite(data, 1, (size_t)size, file) == (size_t)size);
+        if (file) fclose(file);
+    }
+    free(data);
+    remove(sidecar);
+    if (!ok) {
+        check(false, "IndexedDecoder seek to every frame", "can not read the mp3 file");
+        return;
+    }
+
+    // Sequential decoding.
+    Superpowered::Decoder decoder;
+    unsigned int numFrames = 0, capacity = 0;
+    short int *reference = NULL, *pcm = NULL;
+    if (decoder.open(path) == Superpowered::Decoder::OpenSuccess) {
+        pcm = (short int *)malloc(decoder.getFramesPerChunk() * 4 + 16384);
+        int decoded;
+        while (pcm && ((decoded = decoder.decodeAudio(pcm, decoder.getFramesPerChunk())) > 0)) {
+            if (numFrames + (unsigned int)decoded > capacity) {
+                capacity = (numFrames + (unsigned int)decoded) * 2;
+                reference = (short int *)realloc(reference, (size_t)capacity * 4);
+                if (!reference) break;
+            }
+            memcpy(reference + numFrames * 2, pcm, (size_t)decoded * 4);
+            numFrames += (unsigned int)decoded;
+        }
+    }
+
+    Superpowered::IndexedDecoder indexed;
+    ok = reference && (indexed.open(path) == Superpowered::Decoder::OpenSuccess) && indexed.isIndexed() && ((unsigned int)indexed.getDurationFrames() == numFrames);
+    const unsigned int samplesPerFrame = (indexed.getSamplerate() < 32000) ? 576 : 1152; // MPEG-2 and 2.5 below 32000 Hz.
+    unsigned int numSeeks = 0, mismatches = 0, firstMismatch = 0;
+    for (unsigned int position = 0; ok && (position + samplesPerFrame <= numFrames); position += samplesPerFrame, numSeeks++) {
+        if (!indexed.setPositionPrecise((int)position) || (indexed.decodeAudio(pcm, samplesPerFrame) != (int)samplesPerFrame) || memcmp(pcm, reference + position * 2, samplesPerFrame * 4)) {
+            if (!mismatches) firstMismatch = position / samplesPerFrame;
+            mismatches++;
+        }
+    }
+
+    char details[128];
+    snprintf(details, sizeof(details), "%u of %u frames mismatch (first: %u)", mismatches, numSeeks, firstMismatch);
+    check(ok && numSeeks && !mismatches, "IndexedDecoder seek to every frame", ok ? details : "can not decode the mp3 file");
+    free(reference);
+    free(pcm);
+    remove(path);
+    remove(sidecar);
+}
+
+int main(int argc, char *argv[]) {
+    Superpowered::Initialize("ExampleLicenseKey-WillExpire-OnNextUpdate");
+    srand(1);
+
+    testPolyphaseResamplerLimitedOutput();
+    testBiquad2SumOfSquares();
+    testHalfConversion();
+    testConvolverDryMapping();
+    testIndexedDecoderSeek((argc > 1) ? argv[1] : "../Examples_macOS/ambi/ambi/ambi_01.mp3");
+
+    if (failures) printf("%i FAILED.\n", failures); else printf("PASSED.\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+#include "SuperpoweredBatchFFT.h"
+#include "SuperpoweredFFT.h"
+#include "SuperpoweredSIMD.h"
+#include "SuperpoweredSharedTables.h"
+#include <string.h>
+
+namespace Superpowered {
+
+static const unsigned int minimumLogSize = 4, maximumLogSize = 13, maximumComplexLogSize = 12;
+static const unsigned int maximumBatchedLogSize = 7; // Complex points. The work buffers of larger sizes don't fit into the L1 cache, and FFTComplex/FFTReal are faster.
+static const unsigned int minimumBatch = 12;         // Smaller groups are not worth interleaving, as a partial group costs the same as a full one.
+static const unsigned int lanes = 16;                // Transforms per group, see SIMD::FFTBatchInterleave.
+
+struct batchFFTInternals {
+    float *twiddles;  // cos and sin of 2 * pi * j / 2^logSize. Read-only, shared between instances.
+    float *bufferReal[2], *bufferImag[2]; // A group of interleaved transforms, the stages alternate between the two.
+    float *zeros, *discard; // Inputs and outputs of the unused lanes.
+    unsigned int logSize, batchedSize;
+};
+
+// Stockham stages of size interleaved complex points, radix-4 and a radix-2 stage for the odd log2 sizes. Returns with the index of the buffer holding the result.
+static unsigned int transform(batchFFTInternals *internals, unsigned int from, unsigned int size, bool forward) {
+    const unsigned int tableSize = 1u << internals->logSize;
+    unsigned int n = size, stride = 1;
+    for (; n >= 4; n /= 4, stride *= 4, from ^= 1) SIMD::FFTBatchRadix4(internals->bufferReal[from], internals->bufferImag[from], internals->bufferReal[from ^ 1], internals->bufferImag[from ^ 1], n, stride, internals->twiddles, tableSize / n, forward);
+    if (n == 2) {
+        SIMD::FFTBatchRadix2(internals->bufferReal[from], internals->bufferImag[from], internals->bufferReal[from ^ 1], internals->bufferImag[from ^ 1], stride);
+        from ^= 1;
+    }
+    return from;
+}
+
+// Transforms of one group of count buffers, each size (complex) points.
+static void group(batchFFTInternals *internals, float **real, float **imag, unsigned int count, unsigned int size, bool realFFT, bool forward) {
+    float *inReal[lanes], *inImag[lanes], *outReal[lanes], *outImag[lanes];
+    for (unsigned int t = 0; t < lanes; t++) {
+        inReal[t] = (t < count) ? real[t] : internals->zeros;
+        inImag[t] = (t < count) ? imag[t] : internals->zeros;
+        outReal[t] = (t < count) ? real[t] : internals->discard;
+        outImag[t] = (t < count) ? imag[t] : internals->discard;
+    }
+    SIMD::FFTBatchInterleave(inReal, size, internals->bufferReal[0]);
+    SIMD::FFTBatchInterleave(inImag, size, internals->bufferImag[0]);
+
+    unsigned int result;
+    if (!realFFT) result = transform(internals, 0, size, forward);
+    else if (forward) {
+        result = transform(internals, 0, size, true);
+        SIMD::FFTBatchRealSplit(internals->bufferReal[result], internals->bufferImag[result], size, internals->twiddles, true);
+    } else {
+        SIMD::FFTBatchRealSplit(internals->bufferReal[0], internals->bufferImag[0], size, internals->twiddles, false);
+        result = transform(internals, 0, size, false);
+    }
+
+    SIMD::FFTBatchDeInterleave(internals->bufferReal[result], outReal, size);
+    SIMD::FFTBatchDeInterleave(internals->bufferImag[result], outImag, size);
+}
+
+BatchFFT::BatchFFT(unsigned int logSize) {
+    if (logSize < minimumLogSize) logSize = minimumLogSize; else if (logSize > maximumLogSize) logSize = maximumLogSize;
+    internals = new batchFFTInternals;
+    internals->logSize = logSize;
+    const unsigned int size = 1u << logSize;
+
+    // The real FFT is a complex FFT of half size.
+    const unsigned int batchedSize = (logSize <= maximumBatchedLogSize) ? size : ((logSize - 1 <= maximumBatchedLogSize) ? size / 2 : 0);
+    internals->batchedSize = batchedSize;
+    if (batchedSize) {
+        internals->twiddles = (float *)SharedTables::acquireTwiddles(size);
+        for (int n = 0; n < 2; n++) {
+            internals->bufferReal[n] = new float[batchedSize * lanes];
+            internals->bufferImag[n] = new float[batchedSize * lanes];
+        }
+        internals->zeros = new float[batchedSize];
+        internals->discard = new float[batchedSize];
+        memset(internals->zeros, 0, batchedSize * sizeof(float));
+    } else {
+        internals->twiddles = internals->zeros = internals->discard = NULL;
+        internals->bufferReal[0] = internals->bufferReal[1] = internals->bufferImag[0] = internals->bufferImag[1] = NULL;
+    }
+}
+
+BatchFFT::~BatchFFT() {
+    SharedTables::release(internals->twiddles);
+    for (int n = 0; n < 2; n++) {
+        delete[] internals->bufferReal[n];
+        delete[] internals->bufferImag[n];
+    }
+    delete[] internals->zeros;
+    delete[] internals->discard;
+    delete internals;
+}
+
+unsigned int BatchFFT::getSize() {
+    return 1u << internals->logSize;
+}
+
+unsigned int BatchFFT::getLogSize() {
+    return internals->logSize;
+}
+
+unsigned int BatchFFT::getMemoryUsage() {
+    return (unsigned int)sizeof(batchFFTInternals) + internals->batchedSize * (4 * lanes + 2) * (unsigned int)sizeof(float);
+}
+
+void BatchFFT::complexFFT(float **real, float **imag, unsigned int numTransforms, bool forward) {
+    const unsigned int logSize = internals->logSize;
+    if (logSize > maximumComplexLogSize) return;
+    unsigned int n = 0;
+    if (logSize <= maximumBatchedLogSize) for (; n + minimumBatch <= numTransforms; n += lanes) {
+        const unsigned int count = (numTransforms - n < lanes) ? numTransforms - n : lanes;
+        group(internals, real + n, imag + n, count, 1u << logSize, false, forward);
+    }
+    for (; n < numTransforms; n++) FFTComplex(real[n], imag[n], (int)logSize, forward);
+}
+
+void BatchFFT::realFFT(float **real, float **imag, unsigned int numTransforms, bool forward) {
+    const unsigned int logSize = internals->logSize;
+    if (logSize < 5) return;
+    unsigned int n = 0;
+    if (logSize - 1 <= maximumBatchedLogSize) for (; n + minimumBatch <= numTransforms; n += lanes) {
+        const unsigned int count = (numTransforms - n < lanes) ? numTransforms - n : lanes;
+        group(internals, real + n, imag + n, count, 1u << (logSize - 1), true, forward);
+    }
+    for (; n < numTransforms; n++) FFTReal(real[n], imag[n], (int)logSize, forward);
+}
+
+}
@@ -0,0 +1,53 @@
+#ifndef Header_SuperpoweredBatchFFT
+#define Header_SuperpoweredBatchFFT
+
+namespace Superpowered {
+
+struct batchFFTInternals;
+
+/// @brief Many FFTs of the same size in one call, for example the channels or frames of a multichannel spectral analysis or the partitions of a convolution.
+/// Data packing, scaling and the results are the same as FFTComplex and FFTReal in SuperpoweredFFT.h.
+/// The transforms are processed in groups of 16: a group is interleaved into a work buffer, so the vectors run along the transforms and every twiddle is loaded once for the whole group.
+/// This is 1.2-2.7x faster than calling FFTComplex or FFTReal for every buffer at the small sizes (complex FFT up to 128 points, real FFT up to 256 points), where the per-call overhead and the short vector loops dominate.
+/// Larger sizes and groups of less than 12 transforms are passed to FFTComplex and FFTReal one by one.
+/// The methods are not allocating and not blocking. One instance can not be used on multiple threads concurrently, as it has an internal work buffer. It will not create any internal threads.
+class BatchFFT {
+public:
+/// @brief Constructor. Allocates the twiddle table and the work buffers, up to 40 kilobytes for the batched sizes.
+/// @param logSize FFT size is 2^logSize. Limited between 4 and 13 (16 - 8192 points). The complex FFT supports up to 12, the real FFT needs 5 or more.
+    BatchFFT(unsigned int logSize);
+    ~BatchFFT();
+
+/// @brief Complex in-place FFT of every buffer, the same as FFTComplex in SuperpoweredFFT.h.
+/// @param real Pointers to numTransforms buffers of floating point numbers, 2^logSize big each. Real part.
+/// @param imag Pointers to numTransforms buffers of floating point numbers, 2^logSize big each. Imaginary part.
+/// @param numTransforms The number of transforms.
+/// @param forward Forward or inverse. Not scaled in either direction.
+    void complexFFT(float **real, float **imag, unsigned int numTransforms, bool forward);
+
+/// @brief Real in-place FFT of every buffer, the same as FFTReal in SuperpoweredFFT.h.
+/// Data packing is same as Apple's vDSP: the input is split into real (even samples) and imag (odd samples). The output of the forward transform is 2x the DFT, with the Nyquist bin in imag[0]. The inverse transform returns with 2 * 2^logSize times the signal.
+/// @param real Pointers to numTransforms buffers of floating point numbers, 2^logSize / 2 big each. Real part.
+/// @param imag Pointers to numTransforms buffers of floating point numbers, 2^logSize / 2 big each. Imaginary part.
+/// @param numTransforms The number of transforms.
+/// @param forward Forward or inverse.
+    void realFFT(float **real, float **imag, unsigned int numTransforms, bool forward);
+
+/// @return Returns with the FFT size (2^logSize).
+    unsigned int getSize();
+
+/// @return Returns with the log2 of the FFT size.
+    unsigned int getLogSize();
+
+/// @return Returns with the memory used by this instance in bytes. The twiddle table is shared with the other instances of the same size and not included, see SharedTables::getMemoryUsage().
+    unsigned int getMemoryUsage();
+
+private:
+    batchFFTInternals *internals;
+    BatchFFT(const BatchFFT&);
+    BatchFFT& operator=(const BatchFFT&);
+};
+
+}
+
+#endif
@@ -0,0 +1,253 @@
+#include "SuperpoweredConstantQ.h"
+#include "SuperpoweredLargeFFT.h"
+#include "SuperpoweredSIMD.h"
+#include <math.h>
+#include <string.h>
+
+namespace Superpowered {
+
+static const unsigned int minimumLogSize = 8, maximumLogSize = 20, maximumBinsPerOctave = 96, minimumInputCapacity = 8192;
+
+struct constantQInternals {
+    LargeFFT *fft;
+    float *fftReal, *fftImag;       // The input of a frame split to even and odd samples, then its spectrum. fftSize / 2 each.
+    float *kernelReal, *kernelImag; // The non-zero band of every kernel spectrum, bin after bin. Conjugated and scaled, so the product gives the bin directly.
+    unsigned int *bandStart, *bandLength;
+    float *frequencies, *binReal, *binImag;
+    float *input;                   // Mono streaming input, inputCapacity frames. The frames between inputStart and inputEnd are waiting.
+    unsigned int numBins, fftLogSize, fftSize, hop, kernelValues, inputCapacity, inputStart, inputEnd;
+};
+
+// The spectrum of one bin's kernel: a Hann windowed complex exponential, centered in the FFT window and scaled to return with the amplitude of a sine wave.
+// Keeps the band around the peak where the values are above threshold * peak, in the FFTReal bin range (DC and Nyquist are skipped, as they are packed into the first value).
+static void kernelSpectrum(LargeFFT *fft, float *real, float *imag, unsigned int fftSize, unsigned int length, double frequency, double samplerate, float threshold, unsigned int *start, unsigned int *end) {
+    memset(real, 0, fftSize * sizeof(float));
+    memset(imag, 0, fftSize * sizeof(float));
+    const unsigned int center = fftSize / 2, first = center - length / 2;
+    double windowSum = 0;
+    for (unsigned int n = 0; n < length; n++) windowSum += 0.5 - 0.5 * cos(2.0 * M_PI * double(n) / double(length));
+    for (unsigned int n = 0; n < length; n++) {
+        const double window = (0.5 - 0.5 * cos(2.0 * M_PI * double(n) / double(length))) * 2.0 / windowSum, phase = 2.0 * M_PI * frequency * (double(first + n) - double(center)) / samplerate;
+        real[first + n] = float(window * cos(phase));
+        imag[first + n] = float(window * sin(phase));
+    }
+    fft->complexFFT(real, imag, true);
+
+    float peak = 0;
+    for (unsigned int j = 1; j < fftSize / 2; j++) {
+        const float m = real[j] * real[j] + imag[j] * imag[j];
+        if (m > peak) peak = m;
+    }
+    const float limit = peak * threshold * threshold;
+    *start = 1;
+    *end = fftSize / 2;
+    while ((*start < *end - 1) && (real[*start] * real[*start] + imag[*start] * imag[*start] < limit)) (*start)++;
+    while ((*end > *start + 1) && (real[*end - 1] * real[*end - 1] + imag[*end - 1] * imag[*end - 1] < limit)) (*end)--;
+}
+
+ConstantQ::ConstantQ(unsigned int samplerate, float minimumFrequency, float maximumFrequency, unsigned int binsPerOctave, unsigned int hopFrames, float kernelThreshold) {
+    if (samplerate < 1) samplerate = 1;
+    if (binsPerOctave < 1) binsPerOctave = 1; else if (binsPerOctave > maximumBinsPerOctave) binsPerOctave = maximumBinsPerOctave;
+    const float nyquistLimit = float(samplerate) * 0.45f;
+    if ((maximumFrequency <= 0) || (maximumFrequency > nyquistLimit)) maximumFrequency = nyquistLimit;
+    if (minimumFrequency < 1.0f) minimumFrequency = 1.0f; else if (minimumFrequency > maximumFrequency) minimumFrequency = maximumFrequency;
+    if (kernelThreshold < 0) kernelThreshold = 0; else if (kernelThreshold > 0.5f) kernelThreshold = 0.5f;
+
+    internals = new constantQInternals;
+    internals->numBins = (unsigned int)floor(double(binsPerOctave) * log2(double(maximumFrequency) / double(minimumFrequency)) + 1e-9) + 1;
+    const double q = 1.0 / (pow(2.0, 1.0 / double(binsPerOctave)) - 1.0);
+
+    // The lowest bin has the longest kernel, the FFT is the next power of two. Beyond 2^20 the lowest kernels are cut, lowering their Q.
+    const double longest = ceil(q * double(samplerate) / double(minimumFrequency));
+    unsigned int logSize = minimumLogSize;
+    while ((logSize < maximumLogSize) && (double(1u << logSize) < longest)) logSize++;
+    internals->fftLogSize = logSize;
+    internals->fftSize = 1u << logSize;
+    const unsigned int fftSize = internals->fftSize;
+    internals->fft = new LargeFFT(logSize);
+    internals->hop = (hopFrames < 1) ? 1 : (hopFrames > fftSize ? fftSize : hopFrames);
+
+    internals->frequencies = new float[internals->numBins];
+    internals->bandStart = new unsigned int[internals->numBins];
+    internals->bandLength = new unsigned int[internals->numBins];
+    float **bandReal = new float *[internals->numBins], **bandImag = new float *[internals->numBins];
+    float *real = new float[fftSize], *imag = new float[fftSize];
+    const float scale = 1.0f / float(fftSize * 2); // FFTReal returns with 2x the DFT, and the inner product in the frequency domain is fftSize times the one in the time domain.
+    internals->kernelValues = 0;
+
+    for (unsigned int k = 0; k < internals->numBins; k++) {
+        const double frequency = double(minimumFrequency) * pow(2.0, double(k) / double(binsPerOctave));
+        double length = ceil(q * double(samplerate) / frequency);
+        if (length > double(fftSize)) length = double(fftSize);
+        unsigned int start, end;
+        kernelSpectrum(internals->fft, real, imag, fftSize, (unsigned int)length, frequency, double(samplerate), kernelThreshold, &start, &end);
+
+        const unsigned int bandLength = end - start;
+        internals->frequencies[k] = float(frequency);
+        internals->bandStart[k] = start;
+        internals->bandLength[k] = bandLength;
+        internals->kernelValues += bandLength;
+        bandReal[k] = new float[bandLength];
+        bandImag[k] = new float[bandLength];
+        for (unsigned int j = 0; j < bandLength; j++) {
+            bandReal[k][j] = real[start + j] * scale;
+            bandImag[k][j] = -imag[start + j] * scale;
+        }
+    }
+    delete[] real;
+    delete[] imag;
+
+    internals->kernelReal = new float[internals->kernelValues];
+    internals->kernelImag = new float[internals->kernelValues];
+    for (unsigned int k = 0, offset = 0; k < internals->numBins; offset += internals->bandLength[k], k++) {
+        memcpy(internals->kernelReal + offset, bandReal[k], internals->bandLength[k] * sizeof(float));
+        memcpy(internals->kernelImag + offset, bandImag[k], internals->bandLength[k] * sizeof(float));
+        delete[] bandReal[k];
+        delete[] bandImag[k];
+    }
+    delete[] bandReal;
+    delete[] bandImag;
+
+    internals->fftReal = new float[fftSize / 2];
+    internals->fftImag = new float[fftSize / 2];
+    internals->binReal = new float[internals->numBins];
+    internals->binImag = new float[internals->numBins];
+    internals->inputCapacity = fftSize + minimumInputCapacity;
+    internals->input = new float[internals->inputCapacity];
+    reset();
+}
+
+ConstantQ::~ConstantQ() {
+    delete internals->fft;
+    delete[] internals->fftReal;
+    delete[] internals->fftImag;
+    delete[] internals->kernelReal;
+    delete[] internals->kernelImag;
+    delete[] internals->bandStart;
+    delete[] internals->bandLength;
+    delete[] internals->frequencies;
+    delete[] internals->binReal;
+    delete[] internals->binImag;
+    delete[] internals->input;
+    delete internals;
+}
+
+unsigned int ConstantQ::getNumberOfBins() {
+    return internals->numBins;
+}
+
+float ConstantQ::getFrequency(unsigned int bin) {
+    return (bin < internals->numBins) ? internals->frequencies[bin] : 0;
+}
+
+unsigned int ConstantQ::getFFTSize() {
+    return internals->fftSize;
+}
+
+unsigned int ConstantQ::getHopFrames() {
+    return internals->hop;
+}
+
+unsigned int ConstantQ::getLatencyFrames() {
+    return internals->fftSize / 2;
+}
+
+unsigned int ConstantQ::getMemoryUsage() {
+    return (unsigned int)sizeof(constantQInternals) + internals->fftSize * 3 * (unsigned int)sizeof(float) // LargeFFT, fftReal and fftImag.
+        + internals->kernelValues * 2 * (unsigned int)sizeof(float) + internals->numBins * 5 * (unsigned int)sizeof(float) + internals->inputCapacity * (unsigned int)sizeof(float);
+}
+
+// The first frame is centered at the first input frame.
+void ConstantQ::reset() {
+    internals->inputStart = 0;
+    internals->inputEnd = internals->fftSize / 2;
+    memset(internals->input, 0, internals->inputEnd * sizeof(float));
+}
+
+// Makes room for numberOfFrames more input frames. Moves the waiting frames to the start, and grows the buffer if that's not enough.
+static void prepareInput(constantQInternals *internals, unsigned int numberOfFrames) {
+    if (internals->inputEnd + numberOfFrames <= internals->inputCapacity) return;
+    const unsigned int waiting = internals->inputEnd - internals->inputStart;
+    if (waiting + numberOfFrames > internals->inputCapacity) {
+        const unsigned int capacity = (waiting + numberOfFrames) * 2;
+        float *input = new float[capacity];
+        memcpy(input, internals->input + internals->inputStart, waiting * sizeof(float));
+        delete[] internals->input;
+        internals->input = input;
+        internals->inputCapacity = capacity;
+    } else memmove(internals->input, internals->input + internals->inputStart, waiting * sizeof(float));
+    internals->inputStart = 0;
+    internals->inputEnd = waiting;
+}
+
+void ConstantQ::addInput(float *input, unsigned int numberOfFrames, unsigned int numberOfChannels) {
+    if (!input || !numberOfFrames || !numberOfChannels) return;
+    prepareInput(internals, numberOfFrames);
+    float *mono = internals->input + internals->inputEnd;
+    if (numberOfChannels == 1) memcpy(mono, input, numberOfFrames * sizeof(float));
+    else {
+        const float mul = 1.0f / float(numberOfChannels);
+        for (unsigned int n = 0; n < numberOfFrames; n++) {
+            float sum = 0;
+            for (unsigned int c = 0; c < numberOfChannels; c++) sum += input[n * numberOfChannels + c];
+            mono[n] = sum * mul;
+        }
+    }
+    internals->inputEnd += numberOfFrames;
+}
+
+// The FFT of the frame in fftReal/fftImag, then the kernel products to binReal/binImag.
+static void transform(constantQInternals *internals) {
+    internals->fft->realFFT(internals->fftReal, internals->fftImag, true);
+    SIMD::SparseComplexDotProducts(internals->fftReal, internals->fftImag, internals->kernelReal, internals->kernelImag, internals->bandStart, internals->bandLength, internals->numBins, internals->binReal, internals->binImag);
+}
+
+static void magnitudes(constantQInternals *internals, float *output) {
+    for (unsigned int k = 0; k < internals->numBins; k++) output[k] = sqrtf(internals->binReal[k] * internals->binReal[k] + internals->binImag[k] * internals->binImag[k]);
+}
+
+// Loads the next streaming frame and advances.
+static bool nextFrame(constantQInternals *internals) {
+    if (internals->inputEnd - internals->inputStart < internals->fftSize) return false;
+    SIMD::DeInterleave(internals->input + internals->inputStart, internals->fftReal, internals->fftImag, internals->fftSize / 2);
+    internals->inputStart += internals->hop;
+    return true;
+}
+
+bool ConstantQ::process(float *output) {
+    if (!nextFrame(internals)) return false;
+    transform(internals);
+    magnitudes(internals, output);
+    return true;
+}
+
+bool ConstantQ::processComplex(float *real, float *imag) {
+    if (!nextFrame(internals)) return false;
+    transform(internals);
+    memcpy(real, internals->binReal, internals->numBins * sizeof(float));
+    memcpy(imag, internals->binImag, internals->numBins * sizeof(float));
+    return true;
+}
+
+unsigned int ConstantQ::getNumberOfOfflineFrames(unsigned int numberOfFrames) {
+    return (numberOfFrames + internals->hop - 1) / internals->hop;
+}
+
+void ConstantQ::processOffline(float *input, unsigned int numberOfFrames, float *output) {
+    const unsigned int numFrames = getNumberOfOfflineFrames(numberOfFrames), fftSize = internals->fftSize, half = fftSize / 2;
+    float *real = internals->fftReal, *imag = internals->fftImag;
+
+    for (unsigned int frame = 0; frame < numFrames; frame++, output += internals->numBins) {
+        const long long first = (long long)frame * internals->hop - half;
+        if ((first >= 0) && (first + fftSize <= numberOfFrames)) SIMD::DeInterleave(input + first, real, imag, half);
+        else for (unsigned int n = 0; n < half; n++) { // The frame reaches over the start or the end of the signal.
+            const long long even = first + n * 2, odd = even + 1;
+            real[n] = ((even >= 0) && (even < numberOfFrames)) ? input[even] : 0;
+            imag[n] = ((odd >= 0) && (odd < numberOfFrames)) ? input[odd] : 0;
+        }
+        transform(internals);
+        magnitudes(internals, output);
+    }
+}
+
+}
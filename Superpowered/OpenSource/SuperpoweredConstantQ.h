@@ -0,0 +1,83 @@
+#ifndef Header_SuperpoweredConstantQ
+#define Header_SuperpoweredConstantQ
+
+namespace Superpowered {
+
+struct constantQInternals;
+
+/// @brief Constant-Q (log-frequency) transform for key detection, chord recognition and music visualizers. The bins are spaced geometrically, with the same number of bins in every octave and the same Q (center frequency / bandwidth) for every bin.
+/// Uses the method of Brown and Puckette: one FFT per frame, then a sparse product with the precomputed spectra of the bin kernels (Hann windowed complex exponentials, 1 / Q times the bin frequency wide), which is much cheaper than remapping linear bins or filtering per bin.
+/// Every kernel is centered in the FFT window, so all bins of a frame refer to the same moment. The FFT size is the length of the lowest kernel rounded up to a power of two, for example 32768 for C1 (32.7 Hz) and 12 bins per octave at 44100 Hz.
+/// A sine wave with amplitude A at the center frequency of a bin results in magnitude A for that bin. The phase is relative to the center of the frame.
+/// Streaming: add input with addInput(), then call process() until it returns false. Offline: processOffline() transforms a complete signal in one call.
+/// It doesn't allocate any memory in process(). One instance can not be used on multiple threads concurrently, as it has internal work buffers.
+class ConstantQ {
+public:
+/// @brief Constructor. Computes the kernels, allocates about 12 * [FFT SIZE] bytes plus the kernels. Do not call it in the audio processing thread.
+/// @param samplerate The sample rate of the input in Hz.
+/// @param minimumFrequency The center frequency of the lowest bin in Hz. The default is C1.
+/// @param maximumFrequency The highest center frequency in Hz. Limited to 0.45 * samplerate, 0 means the limit.
+/// @param binsPerOctave The number of bins per octave, between 1 and 96. 12 for semitones, 36 or more for tuning-tolerant key and chord detection.
+/// @param hopFrames The distance between the centers of two frames in frames, limited to [FFT SIZE].
+/// @param kernelThreshold Kernel spectrum values below kernelThreshold * the peak of the kernel are dropped. Larger values make it faster with more leakage between bins.
+    ConstantQ(unsigned int samplerate, float minimumFrequency = 32.703196f, float maximumFrequency = 0, unsigned int binsPerOctave = 12, unsigned int hopFrames = 512, float kernelThreshold = 0.005f);
+    ~ConstantQ();
+
+/// @return Returns with the number of bins in a frame.
+    unsigned int getNumberOfBins();
+
+/// @return Returns with the center frequency of a bin in Hz.
+/// @param bin The index of the bin, 0 is the lowest.
+    float getFrequency(unsigned int bin);
+
+/// @return Returns with the FFT size, the number of input frames a frame is computed from.
+    unsigned int getFFTSize();
+
+/// @return Returns with the distance between the centers of two frames in frames.
+    unsigned int getHopFrames();
+
+/// @return Returns with the streaming latency in frames ([FFT SIZE] / 2). The first frame is centered at the first input frame, the input before it counts as silence.
+    unsigned int getLatencyFrames();
+
+/// @return Returns with the memory used by this instance in bytes.
+    unsigned int getMemoryUsage();
+
+/// @brief Add some audio input for streaming. The input buffer grows (allocates) if more than [FFT SIZE] + 8192 frames are waiting.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input, the channels are mixed to mono.
+/// @param numberOfFrames The number of input frames.
+/// @param numberOfChannels The number of channels in input.
+    void addInput(float *input, unsigned int numberOfFrames, unsigned int numberOfChannels = 1);
+
+/// @brief Computes the next frame from the input (added by addInput()) and advances by hopFrames.
+/// @return True if a frame was computed, false if there is not enough input yet.
+/// @param magnitudes Pointer to floating point numbers, getNumberOfBins() big. Output: magnitudes, the lowest bin first.
+    bool process(float *magnitudes);
+
+/// @brief Computes the next frame from the input (added by addInput()) as complex numbers and advances by hopFrames.
+/// @return True if a frame was computed, false if there is not enough input yet.
+/// @param real Pointer to floating point numbers, getNumberOfBins() big. Output: real part.
+/// @param imag Pointer to floating point numbers, getNumberOfBins() big. Output: imaginary part.
+    bool processComplex(float *real, float *imag);
+
+/// @return Returns with the number of frames processOffline() outputs for numberOfFrames input.
+/// @param numberOfFrames The number of input frames.
+    unsigned int getNumberOfOfflineFrames(unsigned int numberOfFrames);
+
+/// @brief Transforms a complete signal. Frame n is centered at input frame n * hopFrames, the signal is padded with silence on both sides. Doesn't change the streaming state.
+/// @param input Pointer to floating point numbers. 32-bit mono input.
+/// @param numberOfFrames The number of input frames.
+/// @param magnitudes Pointer to floating point numbers, getNumberOfOfflineFrames(numberOfFrames) * getNumberOfBins() big. Output: the magnitudes of every frame, frame after frame.
+    void processOffline(float *input, unsigned int numberOfFrames, float *magnitudes);
+
+/// @brief Clears the streaming input.
+    void reset();
+
+private:
+    constantQInternals *internals;
+    ConstantQ(const ConstantQ&);
+    ConstantQ& operator=(const ConstantQ&);
+};
+
+}
+
+#endif
@@ -0,0 +1,449 @@
+#include "SuperpoweredConvolver.h"
+#include "SuperpoweredFFT.h"
+#include "SuperpoweredSIMD.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <string.h>
+
+namespace Superpowered {
+
+static const unsigned int maximumChannels = 8, minimumHeadFrames = 16, maximumBlockFrames = 4096, levelGrowth = 8, maximumLevels = 5;
+static const int jobIdle = 0, jobPending = 1, jobRunning = 2, jobDone = 3;
+static const unsigned int maximumYields = 64; // Waiting for a running background job yields this many times, then blocks.
+
+struct convolverPath {
+    float *head; // The first headFrames of the impulse response, reversed for SIMD::DotProduct.
+    unsigned int input, output;
+};
+
+// One uniformly partitioned part of the impulse response: numPartitions blocks of frames, starting at offset.
+// A job transforms the last 2 * frames input frames, multiplies the last numPartitions input spectra with the partition spectra and transforms the sum back.
+struct convolverLevel {
+    float *spectra;    // Frequency-domain delay line: the last numPartitions input spectra for every input, frames real and frames imaginary values each.
+    float *filters;    // The spectrum of every partition for every path.
+    float *results[2]; // The output of the last two jobs, 2 * frames for every output channel. The second half is valid (overlap-save).
+    float *current;    // The result being played.
+    float *accumulatorReal, *accumulatorImag;
+    float **aReal, **aImag, **bReal, **bImag; // For SIMD::ComplexMultiplyAccumulate.
+    std::thread *thread;
+    std::mutex mutex;
+    std::condition_variable condition, finished; // A job is pending, the background thread has finished a job. Both signaled with the mutex held.
+    std::atomic<int> state;
+    unsigned int frames, logSize, numPartitions, offset, slot, jobs;
+};
+
+struct convolverEngine {
+    convolverLevel levels[maximumLevels]; // The first level is computed in process(), the others on the background threads (if any).
+    convolverPath *paths;
+    float *history[maximumChannels];      // The input, planar. The first keepFrames are zeros after a reset.
+    float *wet[maximumChannels];          // The convolved signal of the current chunk.
+    float *dryMix[maximumChannels];       // The inputs mixed down to the outputs, if there are more inputs than outputs.
+    std::atomic<bool> quit;
+    unsigned int numInputs, numOutputs, numPaths, numLevels, headFrames, historyFrames, historyCapacity, keepFrames, frame;
+};
+
+struct convolverInternals {
+    convolverEngine *engine;
+    std::atomic<convolverEngine *> pending, retired; // An engine waiting for process() to pick it up, and the previous one waiting to be freed outside of the audio thread.
+    std::atomic<bool> resetRequested;
+    std::atomic<unsigned int> irFrames; // Of the last impulse response set. getImpulseResponseFrames() doesn't touch the engines, process() may retire and free them at any time.
+    float previousWet, previousDry;
+    unsigned int numInputs, numOutputs, headFrames;
+    bool nonUniform, backgroundThreads, wasEnabled;
+};
+
+static void runJob(convolverEngine *engine, convolverLevel *level) {
+    const unsigned int frames = level->frames, numPartitions = level->numPartitions, spectrumSize = frames * 2, slot = level->slot;
+    for (unsigned int i = 0; i < engine->numInputs; i++) {
+        float *spectrum = level->spectra + (i * numPartitions + slot) * spectrumSize;
+        FFTReal(spectrum, spectrum + frames, (int)level->logSize, true);
+    }
+
+    float *result = level->results[level->jobs & 1];
+    for (unsigned int o = 0; o < engine->numOutputs; o++) {
+        unsigned int numProducts = 0;
+        for (unsigned int p = 0; p < engine->numPaths; p++) if (engine->paths[p].output == o) {
+            float *spectra = level->spectra + engine->paths[p].input * numPartitions * spectrumSize, *filters = level->filters + p * numPartitions * spectrumSize;
+            for (unsigned int j = 0; j < numPartitions; j++, numProducts++) {
+                float *spectrum = spectra + ((slot + numPartitions - j) % numPartitions) * spectrumSize, *filter = filters + j * spectrumSize;
+                level->aReal[numProducts] = spectrum;
+                level->aImag[numProducts] = spectrum + frames;
+                level->bReal[numProducts] = filter;
+                level->bImag[numProducts] = filter + frames;
+            }
+        }
+        SIMD::ComplexMultiplyAccumulate(level->aReal, level->aImag, level->bReal, level->bImag, numProducts, level->accumulatorReal, level->accumulatorImag, frames, true);
+        FFTReal(level->accumulatorReal, level->accumulatorImag, (int)level->logSize, false);
+        SIMD::Interleave(level->accumulatorReal, level->accumulatorImag, result + o * spectrumSize, frames);
+    }
+
+    level->slot = (slot + 1) % numPartitions;
+    level->jobs++;
+}
+
+// Makes sure the last job of the level has finished. The job runs here if the background thread didn't pick it up yet.
+// If the background thread is running it, a few yields are usually enough. After that the thread blocks instead of spinning, so the background thread gets the core.
+static void finishJob(convolverEngine *engine, convolverLevel *level) {
+    int expected = jobPending;
+    if (level->state.compare_exchange_strong(expected, jobRunning)) {
+        runJob(engine, level);
+        level->state.store(jobDone);
+    } else if (level->state.load() == jobRunning) {
+        for (unsigned int n = 0; (n < maximumYields) && (level->state.load() == jobRunning); n++) std::this_thread::yield();
+        if (level->state.load() == jobRunning) {
+            std::unique_lock<std::mutex> lock(level->mutex);
+            while (level->state.load() == jobRunning) level->finished.wait(lock);
+        }
+    }
+    level->current = level->results[(level->jobs - 1) & 1];
+}
+
+// Starts a job with the input segment ending at the last input frame.
+static void startJob(convolverEngine *engine, convolverLevel *level) {
+    const unsigned int frames = level->frames;
+    for (unsigned int i = 0; i < engine->numInputs; i++) {
+        float *spectrum = level->spectra + (i * level->numPartitions + level->slot) * frames * 2;
+        SIMD::DeInterleave(engine->history[i] + engine->historyFrames - frames * 2, spectrum, spectrum + frames, frames);
+    }
+    if (level->thread) {
+        // Taking the mutex (held by the background thread only while it checks the state) makes sure the wakeup can't fall between its check and wait.
+        std::lock_guard<std::mutex> lock(level->mutex);
+        level->state.store(jobPending);
+        level->condition.notify_one();
+    } else level->state.store(jobPending);
+}
+
+static void worker(convolverEngine *engine, convolverLevel *level) {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(level->mutex);
+            while (!engine->quit.load() && (level->state.load() != jobPending)) level->condition.wait(lock);
+        }
+        if (engine->quit.load()) return;
+        int expected = jobPending;
+        if (level->state.compare_exchange_strong(expected, jobRunning)) {
+            runJob(engine, level);
+            std::lock_guard<std::mutex> lock(level->mutex);
+            level->state.store(jobDone);
+            level->finished.notify_one();
+        }
+    }
+}
+
+static void clearEngine(convolverEngine *engine) {
+    for (unsigned int l = 0; l < engine->numLevels; l++) {
+        convolverLevel *level = &engine->levels[l];
+        finishJob(engine, level);
+        level->state.store(jobIdle);
+        memset(level->spectra, 0, engine->numInputs * level->numPartitions * level->frames * 2 * sizeof(float));
+        for (int n = 0; n < 2; n++) memset(level->results[n], 0, engine->numOutputs * level->frames * 2 * sizeof(float));
+        level->slot = level->jobs = 0;
+        level->current = level->results[1];
+    }
+    for (unsigned int i = 0; i < engine->numInputs; i++) memset(engine->history[i], 0, engine->keepFrames * sizeof(float));
+    engine->historyFrames = engine->keepFrames;
+    engine->frame = 0;
+}
+
+static void deleteEngine(convolverEngine *engine) {
+    if (!engine) return;
+    engine->quit.store(true);
+    for (unsigned int l = 0; l < engine->numLevels; l++) {
+        convolverLevel *level = &engine->levels[l];
+        if (level->thread) {
+            {
+                // The background thread is either waiting already, or checks quit before it waits.
+                std::lock_guard<std::mutex> lock(level->mutex);
+                level->condition.notify_one();
+            }
+            level->thread->join();
+            delete level->thread;
+        }
+        delete[] level->spectra;
+        delete[] level->filters;
+        for (int n = 0; n < 2; n++) delete[] level->results[n];
+        delete[] level->accumulatorReal;
+        delete[] level->accumulatorImag;
+        delete[] level->aReal;
+        delete[] level->aImag;
+        delete[] level->bReal;
+        delete[] level->bImag;
+    }
+    for (unsigned int p = 0; p < engine->numPaths; p++) delete[] engine->paths[p].head;
+    delete[] engine->paths;
+    for (unsigned int i = 0; i < engine->numInputs; i++) delete[] engine->history[i];
+    for (unsigned int o = 0; o < engine->numOutputs; o++) {
+        delete[] engine->wet[o];
+        delete[] engine->dryMix[o];
+    }
+    delete engine;
+}
+
+static unsigned int logSizeOf(unsigned int n) {
+    unsigned int log = 0;
+    while ((1u << log) < n) log++;
+    return log;
+}
+
+static convolverEngine *createEngine(convolverInternals *internals, float **impulseResponses, unsigned int numberOfImpulseResponses, unsigned int numberOfFrames) {
+    const unsigned int numInputs = internals->numInputs, numOutputs = internals->numOutputs, headFrames = internals->headFrames;
+    if (!impulseResponses || !numberOfFrames) return NULL;
+
+    // The paths of the impulse response matrix. irIndex[p] is the impulse response of path p.
+    unsigned int numPaths = 0, irIndex[maximumChannels * maximumChannels], inputs[maximumChannels * maximumChannels], outputs[maximumChannels * maximumChannels];
+    if (numberOfImpulseResponses == numInputs * numOutputs) {
+        for (unsigned int i = 0; i < numInputs; i++) for (unsigned int o = 0; o < numOutputs; o++, numPaths++) {
+            inputs[numPaths] = i;
+            outputs[numPaths] = o;
+            irIndex[numPaths] = i * numOutputs + o;
+        }
+    } else if (((numberOfImpulseResponses == numOutputs) || (numberOfImpulseResponses == 1)) && ((numInputs == numOutputs) || (numInputs == 1))) {
+        for (unsigned int o = 0; o < numOutputs; o++, numPaths++) {
+            inputs[numPaths] = (numInputs == 1) ? 0 : o;
+            outputs[numPaths] = o;
+            irIndex[numPaths] = (numberOfImpulseResponses == 1) ? 0 : o;
+        }
+    } else return NULL;
+    for (unsigned int p = 0; p < numPaths; p++) if (!impulseResponses[irIndex[p]]) return NULL;
+
+    convolverEngine *engine = new convolverEngine;
+    engine->quit.store(false);
+    engine->numInputs = numInputs;
+    engine->numOutputs = numOutputs;
+    engine->numPaths = numPaths;
+    engine->headFrames = headFrames;
+
+    engine->paths = new convolverPath[numPaths];
+    for (unsigned int p = 0; p < numPaths; p++) {
+        convolverPath *path = &engine->paths[p];
+        path->input = inputs[p];
+        path->output = outputs[p];
+        path->head = new float[headFrames];
+        const float *ir = impulseResponses[irIndex[p]];
+        for (unsigned int n = 0; n < headFrames; n++) path->head[headFrames - 1 - n] = (n < numberOfFrames) ? ir[n] : 0;
+    }
+
+    // The first level continues the head with headFrames partitions. The block size grows by levelGrowth per level, and a level of L frames starts at 2 * L, so its job has L frames of time to finish.
+    unsigned int sizes[maximumLevels], offsets[maximumLevels + 1], numLevels = 0;
+    if (numberOfFrames > headFrames) {
+        sizes[0] = offsets[0] = headFrames;
+        numLevels = 1;
+        if (internals->nonUniform) for (unsigned int frames = headFrames * levelGrowth; numLevels < maximumLevels; frames *= levelGrowth) {
+            if (frames > maximumBlockFrames) frames = maximumBlockFrames;
+            if ((frames <= sizes[numLevels - 1]) || (frames * 2 >= numberOfFrames)) break;
+            sizes[numLevels] = frames;
+            offsets[numLevels] = frames * 2;
+            numLevels++;
+        }
+        offsets[numLevels] = numberOfFrames;
+    }
+    engine->numLevels = numLevels;
+
+    unsigned int largestFrames = headFrames;
+    float *segment = new float[(numLevels ? sizes[numLevels - 1] : 1) * 2];
+    for (unsigned int l = 0; l < numLevels; l++) {
+        convolverLevel *level = &engine->levels[l];
+        const unsigned int frames = sizes[l], spectrumSize = frames * 2, numPartitions = (offsets[l + 1] - offsets[l] + frames - 1) / frames;
+        level->frames = frames;
+        level->logSize = logSizeOf(frames * 2);
+        level->numPartitions = numPartitions;
+        level->offset = offsets[l];
+        largestFrames = frames;
+
+        // FFTReal returns with 2x the DFT and the inverse with 2 * size times the signal: the product of two spectra comes back 4 * size = 8 * frames louder.
+        const float scale = 1.0f / float(frames * 8);
+        level->filters = new float[numPaths * numPartitions * spectrumSize];
+        for (unsigned int p = 0; p < numPaths; p++) for (unsigned int j = 0; j < numPartitions; j++) {
+            const float *ir = impulseResponses[irIndex[p]];
+            const unsigned int start = offsets[l] + j * frames, end = (start + frames < offsets[l + 1]) ? start + frames : offsets[l + 1];
+            memset(segment, 0, spectrumSize * sizeof(float));
+            for (unsigned int n = start; n < end; n++) segment[n - start] = ir[n] * scale;
+            float *filter = level->filters + (p * numPartitions + j) * spectrumSize;
+            SIMD::DeInterleave(segment, filter, filter + frames, frames);
+            FFTReal(filter, filter + frames, (int)level->logSize, true);
+        }
+
+        level->spectra = new float[numInputs * numPartitions * spectrumSize];
+        for (int n = 0; n < 2; n++) level->results[n] = new float[numOutputs * spectrumSize];
+        level->accumulatorReal = new float[frames];
+        level->accumulatorImag = new float[frames];
+        level->aReal = new float *[numPaths * numPartitions];
+        level->aImag = new float *[numPaths * numPartitions];
+        level->bReal = new float *[numPaths * numPartitions];
+        level->bImag = new float *[numPaths * numPartitions];
+        level->state.store(jobIdle);
+        level->thread = NULL;
+    }
+    delete[] segment;
+
+    // The history holds the input segments of the largest level, and is shifted back when full.
+    engine->keepFrames = largestFrames * 2;
+    engine->historyCapacity = engine->keepFrames * 2;
+    for (unsigned int i = 0; i < numInputs; i++) engine->history[i] = new float[engine->historyCapacity];
+    for (unsigned int o = 0; o < numOutputs; o++) {
+        engine->wet[o] = new float[headFrames];
+        engine->dryMix[o] = (numInputs > numOutputs) ? new float[headFrames] : NULL;
+    }
+    clearEngine(engine);
+
+    if (internals->backgroundThreads) for (unsigned int l = 1; l < numLevels; l++) engine->levels[l].thread = new std::thread(worker, engine, &engine->levels[l]);
+    return engine;
+}
+
+Convolver::Convolver(unsigned int _samplerate, unsigned int numberOfInputChannels, unsigned int numberOfOutputChannels, unsigned int headFrames, bool nonUniform, bool backgroundThreads) : wet(1.0f), dry(0) {
+    samplerate = _samplerate;
+    internals = new convolverInternals;
+    internals->engine = NULL;
+    internals->pending.store(NULL);
+    internals->retired.store(NULL);
+    internals->resetRequested.store(false);
+    internals->irFrames.store(0);
+    internals->previousWet = 1.0f;
+    internals->previousDry = 0;
+    internals->numInputs = (numberOfInputChannels < 1) ? 1 : ((numberOfInputChannels > maximumChannels) ? maximumChannels : numberOfInputChannels);
+    internals->numOutputs = (numberOfOutputChannels < 1) ? 1 : ((numberOfOutputChannels > maximumChannels) ? maximumChannels : numberOfOutputChannels);
+    if (headFrames < minimumHeadFrames) headFrames = minimumHeadFrames; else if (headFrames > maximumBlockFrames) headFrames = maximumBlockFrames;
+    internals->headFrames = 1u << logSizeOf(headFrames);
+    internals->nonUniform = nonUniform;
+    internals->backgroundThreads = backgroundThreads;
+    internals->wasEnabled = false;
+}
+
+Convolver::~Convolver() {
+    deleteEngine(internals->engine);
+    deleteEngine(internals->pending.load());
+    deleteEngine(internals->retired.load());
+    delete internals;
+}
+
+bool Convolver::setImpulseResponse(float **impulseResponses, unsigned int numberOfImpulseResponses, unsigned int numberOfFrames) {
+    convolverEngine *engine = createEngine(internals, impulseResponses, numberOfImpulseResponses, numberOfFrames);
+    if (!engine) return false;
+    deleteEngine(internals->retired.exchange(NULL));
+    deleteEngine(internals->pending.exchange(engine)); // Not picked up by process() yet.
+    internals->irFrames.store(numberOfFrames);
+    return true;
+}
+
+unsigned int Convolver::getImpulseResponseFrames() {
+    return internals->irFrames.load();
+}
+
+void Convolver::reset() {
+    internals->resetRequested.store(true);
+}
+
+bool Convolver::process(float *input, float *output, unsigned int numberOfFrames) {
+    if (!input || !output || !numberOfFrames) return false; // Some safety.
+    convolverInternals *c = internals;
+
+    // Switch to a new impulse response if the previous engine was freed already.
+    if (c->pending.load() && !c->retired.load()) {
+        convolverEngine *engine = c->pending.exchange(NULL);
+        if (engine) {
+            c->retired.store(c->engine);
+            c->engine = engine;
+        }
+    }
+
+    convolverEngine *e = c->engine;
+    const bool reset = c->resetRequested.exchange(false);
+    if (!enabled || !e) {
+        c->wasEnabled = false;
+        return false;
+    }
+    if (!c->wasEnabled || reset) {
+        if (e->frame || (e->historyFrames != e->keepFrames)) clearEngine(e);
+        c->wasEnabled = true;
+    }
+
+    float wetEnd = wet, dryEnd = dry;
+    if (!(wetEnd >= 0)) wetEnd = 0; else if (wetEnd > 16.0f) wetEnd = 16.0f;
+    if (!(dryEnd >= 0)) dryEnd = 0; else if (dryEnd > 16.0f) dryEnd = 16.0f;
+    const float wetStep = (wetEnd - c->previousWet) / float(numberOfFrames), dryStep = (dryEnd - c->previousDry) / float(numberOfFrames);
+    float wetGain = c->previousWet, dryGain = c->previousDry;
+    c->previousWet = wetEnd;
+    c->previousDry = dryEnd;
+
+    const unsigned int numInputs = e->numInputs, numOutputs = e->numOutputs, headFrames = e->headFrames;
+    while (numberOfFrames > 0) {
+        unsigned int frames = headFrames - (e->frame & (headFrames - 1));
+        if (frames > numberOfFrames) frames = numberOfFrames;
+
+        // Append the input to the history.
+        if (e->historyFrames + frames > e->historyCapacity) {
+            for (unsigned int i = 0; i < numInputs; i++) memmove(e->history[i], e->history[i] + e->historyFrames - e->keepFrames, e->keepFrames * sizeof(float));
+            e->historyFrames = e->keepFrames;
+        }
+        const unsigned int start = e->historyFrames;
+        if (numInputs == 2) SIMD::DeInterleave(input, e->history[0] + start, e->history[1] + start, frames);
+        else if (numInputs == 1) memcpy(e->history[0] + start, input, frames * sizeof(float));
+        else for (unsigned int i = 0; i < numInputs; i++) {
+            float *history = e->history[i] + start;
+            for (unsigned int n = 0; n < frames; n++) history[n] = input[n * numInputs + i];
+        }
+        e->historyFrames += frames;
+
+        // The partitions were computed at the previous block boundaries, the head is a direct-form FIR.
+        for (unsigned int o = 0; o < numOutputs; o++) {
+            float *wetOut = e->wet[o];
+            if (e->numLevels) memcpy(wetOut, e->levels[0].current + o * headFrames * 2 + headFrames + (e->frame & (headFrames - 1)), frames * sizeof(float));
+            else memset(wetOut, 0, frames * sizeof(float));
+            for (unsigned int l = 1; l < e->numLevels; l++) {
+                const convolverLevel *level = &e->levels[l];
+                SIMD::Add1(level->current + o * level->frames * 2 + level->frames + (e->frame & (level->frames - 1)), wetOut, frames);
+            }
+        }
+        for (unsigned int p = 0; p < e->numPaths; p++) {
+            const convolverPath *path = &e->paths[p];
+            float *wetOut = e->wet[path->output], *window = e->history[path->input] + start + 1 - headFrames;
+            for (unsigned int n = 0; n < frames; n++) wetOut[n] += SIMD::DotProduct(path->head, window + n, headFrames);
+        }
+
+        // The dry signal. With more inputs than outputs, output o gets the average of inputs o, o + numOutputs, o + 2 * numOutputs... (stereo to mono: (left + right) / 2).
+        const float *drySignal[maximumChannels];
+        for (unsigned int o = 0; o < numOutputs; o++) {
+            if (numInputs <= numOutputs) {
+                drySignal[o] = e->history[o % numInputs] + start;
+                continue;
+            }
+            float *mix = e->dryMix[o];
+            unsigned int numMixed = 1;
+            memcpy(mix, e->history[o] + start, frames * sizeof(float));
+            for (unsigned int i = o + numOutputs; i < numInputs; i += numOutputs, numMixed++) SIMD::Add1(e->history[i] + start, mix, frames);
+            if (numMixed > 1) {
+                const float scale = 1.0f / float(numMixed);
+                for (unsigned int n = 0; n < frames; n++) mix[n] *= scale;
+            }
+            drySignal[o] = mix;
+        }
+
+        for (unsigned int n = 0; n < frames; n++) {
+            for (unsigned int o = 0; o < numOutputs; o++) output[o] = e->wet[o][n] * wetGain + drySignal[o][n] * dryGain;
+            wetGain += wetStep;
+            dryGain += dryStep;
+            output += numOutputs;
+        }
+        input += frames * numInputs;
+        numberOfFrames -= frames;
+        e->frame += frames;
+
+        // Block boundaries. The first level is needed right away, the others start a job for the block after the next one.
+        if ((e->frame & (headFrames - 1)) == 0) for (unsigned int l = 0; l < e->numLevels; l++) {
+            convolverLevel *level = &e->levels[l];
+            if (e->frame & (level->frames - 1)) continue;
+            if (l == 0) {
+                startJob(e, level);
+                finishJob(e, level);
+            } else {
+                finishJob(e, level);
+                startJob(e, level);
+            }
+        }
+    }
+    return true;
+}
+
+}
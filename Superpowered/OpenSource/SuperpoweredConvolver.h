@@ -0,0 +1,64 @@
+#ifndef Header_SuperpoweredConvolver
+#define Header_SuperpoweredConvolver
+
+#include "SuperpoweredFX.h"
+
+namespace Superpowered {
+
+struct convolverInternals;
+
+/// @brief Zero-latency partitioned convolution for impulse response reverbs, speaker cabinets and room correction. Impulse responses of several seconds are fine.
+/// The first headFrames of the impulse response run as a direct-form FIR, so there is no latency. The rest is uniformly partitioned FFT convolution (FFTReal, overlap-save) in blocks of headFrames, computed in process().
+/// With non-uniform partitioning the later parts of the impulse response are split into 8x larger blocks per level (up to 4096 frames), each level computed on its own background thread with one block of time to finish.
+/// If a background thread falls behind (offline processing faster than real-time or an overloaded system), process() computes its block or waits for it.
+/// Up to 8 input and 8 output channels, with an impulse response for every input-output pair (true stereo) or one per channel.
+/// It doesn't allocate any memory in process(). setImpulseResponse() allocates about 8 * (paths + inputs) bytes per impulse response frame.
+class Convolver: public FX {
+public:
+    float wet; ///< Gain of the convolved signal, linear. Limited between 0 and 16. Default: 1.
+    float dry; ///< Gain of the input signal, linear. Limited between 0 and 16. Default: 0. Output channel o gets input channel o % numberOfInputChannels. With more input than output channels, it gets the average of input channels o, o + numberOfOutputChannels, o + 2 * numberOfOutputChannels... (stereo to mono: (left + right) / 2).
+
+/// @brief Constructor. Enabled is false by default.
+/// @param samplerate The initial sample rate in Hz.
+/// @param numberOfInputChannels The number of input channels, limited between 1 and 8.
+/// @param numberOfOutputChannels The number of output channels, limited between 1 and 8.
+/// @param headFrames The block size of the direct-form head and the first FFT partitions. Rounded up to a power of two between 16 and 4096. Larger values reduce the FFT work but increase the FIR work linearly.
+/// @param nonUniform True: larger partitions for the tail, computed on background threads. False: every partition is headFrames long and computed in process().
+/// @param backgroundThreads If false, the tail partitions of non-uniform partitioning are computed in process() too, useful for offline processing.
+    Convolver(unsigned int samplerate, unsigned int numberOfInputChannels = 2, unsigned int numberOfOutputChannels = 2, unsigned int headFrames = 128, bool nonUniform = true, bool backgroundThreads = true);
+    ~Convolver();
+
+/// @brief Sets the impulse response. Allocates memory and starts the background threads, do not call it in the audio processing thread. Can be called concurrently with process(), the switch happens at the next process() call and the tail of the previous impulse response is cut.
+/// The impulse response should have the same sample rate as the audio.
+/// @return Returns false if numberOfImpulseResponses doesn't match the channel layout.
+/// @param impulseResponses Pointers to the impulse responses (mono, 32-bit floating point), each numberOfFrames long.
+/// @param numberOfImpulseResponses One of:
+/// numberOfInputChannels * numberOfOutputChannels: full matrix (true stereo), impulseResponses[input * numberOfOutputChannels + output]. For stereo: left to left, left to right, right to left, right to right.
+/// numberOfOutputChannels: one impulse response per channel. The number of input channels must be 1 or the same as the number of output channels.
+/// 1: the same impulse response for every channel. The number of input channels must be 1 or the same as the number of output channels.
+/// @param numberOfFrames The length of the impulse responses.
+    bool setImpulseResponse(float **impulseResponses, unsigned int numberOfImpulseResponses, unsigned int numberOfFrames);
+
+/// @return Returns with the length of the impulse response set by the last successful setImpulseResponse() call in frames, 0 if there is none. Safe to call on any thread.
+    unsigned int getImpulseResponseFrames();
+
+/// @brief Clears the input history and the tail. Happens at the next process() call.
+    void reset();
+
+/// @brief Processes the audio. Always call it in the audio processing callback, regardless if the effect is enabled or not for smooth, audio-artifact free operation.
+/// It's never allocating. It waits only if a background thread falls behind. You can change all properties on any thread, concurrently with process().
+/// @return If process() returns with true, the contents of output are replaced with the audio output. If process() returns with false, the contents of output are not changed.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input with numberOfInputChannels.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output with numberOfOutputChannels. Can point to the same location with input (in-place processing) if the channel counts are the same.
+/// @param numberOfFrames Number of frames to process. Any number is accepted.
+    bool process(float *input, float *output, unsigned int numberOfFrames);
+
+private:
+    convolverInternals *internals;
+    Convolver(const Convolver&);
+    Convolver& operator=(const Convolver&);
+};
+
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include "SuperpoweredDoubleFFT.h"
+#include "SuperpoweredSIMD.h"
+#include "SuperpoweredRealFFTSplit.h"
+#include "SuperpoweredSharedTables.h"
+#include <string.h>
+
+namespace Superpowered {
+
+static const unsigned int minimumLogSize = 4, maximumLogSize = 20;
+
+struct doubleFFTInternals {
+    double *twiddles; // cos and sin of 2 * pi * j / 2^logSize for j < 3 / 4 * 2^logSize. The half-size transform of the real FFT uses every second one. Read-only, shared between instances.
+    double *workReal, *workImag;
+    unsigned int logSize;
+};
+
+// Stockham stages of size complex points, radix-4 and a radix-2 stage for the odd log2 sizes. The stages alternate between the input and the work buffer.
+static void transform(doubleFFTInternals *internals, double *real, double *imag, unsigned int size, bool forward) {
+    const unsigned int tableSize = 1u << internals->logSize;
+    double *inReal = real, *inImag = imag, *outReal = internals->workReal, *outImag = internals->workImag;
+    unsigned int n = size, stride = 1;
+    while (n >= 2) {
+        if (n >= 4) {
+            SIMD::FFTDoubleRadix4(inReal, inImag, outReal, outImag, n, stride, internals->twiddles, tableSize / n, forward);
+            n /= 4;
+            stride *= 4;
+        } else {
+            SIMD::FFTDoubleRadix2(inReal, inImag, outReal, outImag, stride);
+            n = 1;
+            stride *= 2;
+        }
+        double *r = inReal, *i = inImag;
+        inReal = outReal;
+        inImag = outImag;
+        outReal = r;
+        outImag = i;
+    }
+    if (inReal != real) {
+        memcpy(real, inReal, size * sizeof(double));
+        memcpy(imag, inImag, size * sizeof(double));
+    }
+}
+
+DoubleFFT::DoubleFFT(unsigned int logSize) {
+    if (logSize < minimumLogSize) logSize = minimumLogSize; else if (logSize > maximumLogSize) logSize = maximumLogSize;
+    internals = new doubleFFTInternals;
+    internals->logSize = logSize;
+    const unsigned int size = 1u << logSize;
+
+    internals->twiddles = (double *)SharedTables::acquireDoubleTwiddles(size);
+    internals->workReal = new double[size];
+    internals->workImag = new double[size];
+}
+
+DoubleFFT::~DoubleFFT() {
+    SharedTables::release(internals->twiddles);
+    delete[] internals->workReal;
+    delete[] internals->workImag;
+    delete internals;
+}
+
+unsigned int DoubleFFT::getSize() {
+    return 1u << internals->logSize;
+}
+
+unsigned int DoubleFFT::getLogSize() {
+    return internals->logSize;
+}
+
+unsigned int DoubleFFT::getMemoryUsage() {
+    return (unsigned int)sizeof(doubleFFTInternals) + (2u << internals->logSize) * (unsigned int)sizeof(double);
+}
+
+void DoubleFFT::complexFFT(double *real, double *imag, bool forward) {
+    transform(internals, real, imag, 1u << internals->logSize, forward);
+}
+
+// The real FFT is a complex FFT of size / 2 points (even samples as real, odd samples as imaginary), with the split step of SuperpoweredRealFFTSplit.h.
+void DoubleFFT::realFFT(double *real, double *imag, bool forward) {
+    if (internals->logSize < 5) return;
+    const unsigned int half = 1u << (internals->logSize - 1);
+    const RealFFTSplit::interleavedTwiddles<double> twiddles(internals->twiddles);
+
+    if (forward) {
+        transform(internals, real, imag, half, true);
+        RealFFTSplit::forward(real, imag, half, twiddles);
+    } else {
+        RealFFTSplit::inverse(real, imag, half, twiddles);
+        transform(internals, real, imag, half, false);
+    }
+}
+
+}
@@ -0,0 +1,48 @@
+#ifndef Header_SuperpoweredDoubleFFT
+#define Header_SuperpoweredDoubleFFT
+
+namespace Superpowered {
+
+struct doubleFFTInternals;
+
+/// @brief Double precision FFT for measurement and filter design tasks which need more dynamic range than float, such as log-sweep deconvolution of impulse responses.
+/// Data packing and scaling are the same as FFTComplex and FFTReal in SuperpoweredFFT.h. The stages are vectorized with SSE2, AVX2 or AVX-512 (see SIMD in SuperpoweredSIMD.h).
+/// The methods are not allocating and not blocking. One instance can not be used on multiple threads concurrently, as it has an internal work buffer. It will not create any internal threads.
+class DoubleFFT {
+public:
+/// @brief Constructor. Allocates the twiddle table and the work buffer, about 28 * 2^logSize bytes.
+/// @param logSize FFT size is 2^logSize. Limited between 4 and 20 (16 - 1048576 points). The real FFT needs logSize 5 or more.
+    DoubleFFT(unsigned int logSize);
+    ~DoubleFFT();
+
+/// @brief Complex in-place FFT, the same as FFTComplex in SuperpoweredFFT.h.
+/// @param real Pointer to double precision numbers, 2^logSize big. Real part.
+/// @param imag Pointer to double precision numbers, 2^logSize big. Imaginary part.
+/// @param forward Forward or inverse. Not scaled in either direction.
+    void complexFFT(double *real, double *imag, bool forward);
+
+/// @brief Real in-place FFT, the same as FFTReal in SuperpoweredFFT.h.
+/// Data packing is same as Apple's vDSP: the input is split into real (even samples) and imag (odd samples). The output of the forward transform is 2x the DFT, with the Nyquist bin in imag[0]. The inverse transform returns with 2 * 2^logSize times the signal.
+/// @param real Pointer to double precision numbers, 2^logSize / 2 big. Real part.
+/// @param imag Pointer to double precision numbers, 2^logSize / 2 big. Imaginary part.
+/// @param forward Forward or inverse.
+    void realFFT(double *real, double *imag, bool forward);
+
+/// @return Returns with the FFT size (2^logSize).
+    unsigned int getSize();
+
+/// @return Returns with the log2 of the FFT size.
+    unsigned int getLogSize();
+
+/// @return Returns with the memory used by this instance in bytes. The twiddle table is shared with the other instances of the same size and not included, see SharedTables::getMemoryUsage().
+    unsigned int getMemoryUsage();
+
+private:
+    doubleFFTInternals *internals;
+    DoubleFFT(const DoubleFFT&);
+    DoubleFFT& operator=(const DoubleFFT&);
+};
+
+}
+
+#endif
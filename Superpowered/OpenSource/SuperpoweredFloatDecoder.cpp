@@ -0,0 +1,468 @@
+#include "SuperpoweredFloatDecoder.h"
+#include "SuperpoweredDecoder.h"
+#include "SuperpoweredSIMD.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if _WIN32
+#include "Windows.h"
+#define fseek64 _fseeki64
+#define ftell64 _ftelli64
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define fseek64 fseeko
+#define ftell64 ftello
+#endif
+
+namespace Superpowered {
+
+static const unsigned int readBufferFrames = 4096;
+static const size_t readAheadBytes = 4 * 1024 * 1024;
+
+typedef enum pcmEncoding {
+    pcmEncoding_UInt8,  // WAV 8-bit.
+    pcmEncoding_Int8,   // AIFF 8-bit.
+    pcmEncoding_Int,    // 16, 24 or 32-bit.
+    pcmEncoding_Float   // 32 or 64-bit.
+} pcmEncoding;
+
+struct floatDecoderInternals {
+    Decoder *decoder;       // Compressed formats only.
+    FILE *file;             // WAV and AIFF with file I/O.
+    const unsigned char *mapped; // WAV and AIFF memory mapped: the entire file.
+    unsigned char *buffer;  // WAV and AIFF: readBufferFrames * frameBytes. Decoder: decodeAudio() output, framesPerChunk * 4 + 16384 bytes.
+    int64_t dataOffset;
+    size_t mappedBytes, advisedUntil;
+#if _WIN32
+    HANDLE mapFile, mapping;
+#endif
+    pcmEncoding encoding;
+    unsigned int samplerate, numChannels, bitsPerSample, bytesPerSample, frameBytes, durationFrames, position, framesPerChunk, pcmStart, pcmEnd;
+    bool bigEndian;
+};
+
+static inline unsigned int readLE16(const unsigned char *p) { return p[0] | (p[1] << 8); }
+static inline unsigned int readLE32(const unsigned char *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24); }
+static inline unsigned int readBE16(const unsigned char *p) { return (p[0] << 8) | p[1]; }
+static inline unsigned int readBE32(const unsigned char *p) { return ((unsigned int)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+
+// 80-bit IEEE 754 extended precision, the sample rate format of AIFF.
+static double readExtended(const unsigned char *p) {
+    const int exponent = ((p[0] & 0x7f) << 8) | p[1];
+    const uint64_t mantissa = ((uint64_t)readBE32(p + 2) << 32) | readBE32(p + 6);
+    if (!exponent && !mantissa) return 0;
+    return ldexp((double)mantissa, exponent - 16383 - 63);
+}
+
+// Sets the sample layout from the container size. Returns false for unsupported formats.
+static bool setFormat(floatDecoderInternals *internals, unsigned int bitsPerSample, unsigned int bytesPerSample, bool isFloat) {
+    if (!internals->numChannels || !internals->samplerate || !bitsPerSample) return false;
+    if (isFloat) {
+        if ((bytesPerSample != 4) && (bytesPerSample != 8)) return false;
+        internals->encoding = pcmEncoding_Float;
+    } else if (bytesPerSample > 1) {
+        if (bytesPerSample > 4) return false;
+        internals->encoding = pcmEncoding_Int;
+    }
+    internals->bitsPerSample = bitsPerSample;
+    internals->bytesPerSample = bytesPerSample;
+    internals->frameBytes = bytesPerSample * internals->numChannels;
+    return true;
+}
+
+static int64_t fileSize(FILE *file) {
+    if (fseek64(file, 0, SEEK_END) != 0) return 0;
+    return ftell64(file);
+}
+
+// RIFF/WAVE: "fmt " and "data" chunks.
+static bool parseWAV(floatDecoderInternals *internals, int64_t size) {
+    unsigned char chunk[40];
+    int64_t offset = 12, dataBytes = -1;
+    bool hasFormat = false, isFloat = false;
+    unsigned int bitsPerSample = 0, blockAlign = 0;
+
+    while ((offset + 8 <= size) && (dataBytes < 0)) {
+        if ((fseek64(internals->file, offset, SEEK_SET) != 0) || (fread(chunk, 1, 8, internals->file) != 8)) return false;
+        const int64_t chunkBytes = readLE32(chunk + 4);
+
+        if (!memcmp(chunk, "fmt ", 4)) {
+            if ((chunkBytes < 16) || (fread(chunk, 1, (chunkBytes < 40) ? (size_t)chunkBytes : 40, internals->file) < 16)) return false;
+            unsigned int formatTag = readLE16(chunk);
+            if ((formatTag == 0xfffe) && (chunkBytes >= 40)) formatTag = readLE16(chunk + 24); // WAVE_FORMAT_EXTENSIBLE: the first two bytes of the sub format GUID.
+            if ((formatTag != 1) && (formatTag != 3)) return false;
+            isFloat = (formatTag == 3);
+            internals->numChannels = readLE16(chunk + 2);
+            internals->samplerate = readLE32(chunk + 4);
+            blockAlign = readLE16(chunk + 12);
+            bitsPerSample = readLE16(chunk + 14);
+            hasFormat = true;
+        } else if (!memcmp(chunk, "data", 4)) {
+            if (!hasFormat) return false;
+            internals->dataOffset = offset + 8;
+            // Streaming writers leave the size at 0 or 0xffffffff.
+            dataBytes = (!chunkBytes || (internals->dataOffset + chunkBytes > size)) ? size - internals->dataOffset : chunkBytes;
+        }
+        offset += 8 + chunkBytes + (chunkBytes & 1);
+    }
+
+    if ((dataBytes < 0) || !internals->numChannels || (blockAlign % internals->numChannels)) return false;
+    internals->encoding = pcmEncoding_UInt8;
+    internals->bigEndian = false;
+    if (!setFormat(internals, bitsPerSample, blockAlign / internals->numChannels, isFloat)) return false;
+    const int64_t frames = dataBytes / internals->frameBytes;
+    internals->durationFrames = (frames > 0x7fffffff) ? 0x7fffffff : (unsigned int)frames;
+    return true;
+}
+
+// FORM/AIFF or FORM/AIFC: "COMM" and "SSND" chunks.
+static bool parseAIFF(floatDecoderInternals *internals, int64_t size, bool aifc) {
+    unsigned char chunk[26];
+    int64_t offset = 12, dataBytes = -1;
+    bool hasFormat = false, isFloat = false;
+    unsigned int bitsPerSample = 0, bytesPerSample = 0, commFrames = 0;
+
+    while ((offset + 8 <= size) && ((dataBytes < 0) || !hasFormat)) {
+        if ((fseek64(internals->file, offset, SEEK_SET) != 0) || (fread(chunk, 1, 8, internals->file) != 8)) return false;
+        const int64_t chunkBytes = readBE32(chunk + 4);
+
+        if (!memcmp(chunk, "COMM", 4)) {
+            const size_t commBytes = aifc ? 22 : 18;
+            if ((chunkBytes < (int64_t)commBytes) || (fread(chunk, 1, commBytes, internals->file) != commBytes)) return false;
+            internals->numChannels = readBE16(chunk);
+            commFrames = readBE32(chunk + 2);
+            bitsPerSample = readBE16(chunk + 6);
+            internals->samplerate = (unsigned int)(readExtended(chunk + 8) + 0.5);
+            bytesPerSample = (bitsPerSample + 7) / 8;
+            internals->bigEndian = true;
+            if (aifc) {
+                const unsigned char *type = chunk + 18;
+                if (!memcmp(type, "sowt", 4)) internals->bigEndian = false;
+                else if (!memcmp(type, "fl32", 4) || !memcmp(type, "FL32", 4)) { isFloat = true; bytesPerSample = 4; bitsPerSample = 32; }
+                else if (!memcmp(type, "fl64", 4) || !memcmp(type, "FL64", 4)) { isFloat = true; bytesPerSample = 8; bitsPerSample = 64; }
+                else if (memcmp(type, "NONE", 4) && memcmp(type, "twos", 4)) return false;
+            }
+            hasFormat = true;
+        } else if (!memcmp(chunk, "SSND", 4)) {
+            if ((chunkBytes < 8) || (fread(chunk, 1, 8, internals->file) != 8)) return false;
+            internals->dataOffset = offset + 16 + readBE32(chunk);
+            dataBytes = chunkBytes - 8 - readBE32(chunk);
+            if (internals->dataOffset + dataBytes > size) dataBytes = size - internals->dataOffset;
+            if (dataBytes < 0) return false;
+        }
+        offset += 8 + chunkBytes + (chunkBytes & 1);
+    }
+
+    if (!hasFormat || (dataBytes < 0)) return false;
+    internals->encoding = pcmEncoding_Int8;
+    if (!setFormat(internals, bitsPerSample, bytesPerSample, isFloat)) return false;
+    int64_t frames = dataBytes / internals->frameBytes;
+    if (frames > commFrames) frames = commFrames;
+    internals->durationFrames = (frames > 0x7fffffff) ? 0x7fffffff : (unsigned int)frames;
+    return true;
+}
+
+// Opens WAV and AIFF files. Returns false for every other format.
+static bool openPCM(floatDecoderInternals *internals, const char *path) {
+    internals->file = fopen(path, "rb");
+    if (!internals->file) return false;
+    unsigned char header[12];
+    const int64_t size = fileSize(internals->file);
+    bool ok = false;
+    if ((size >= 12) && (fseek64(internals->file, 0, SEEK_SET) == 0) && (fread(header, 1, 12, internals->file) == 12)) {
+        if (!memcmp(header, "RIFF", 4) && !memcmp(header + 8, "WAVE", 4)) ok = parseWAV(internals, size);
+        else if (!memcmp(header, "FORM", 4) && !memcmp(header + 8, "AIFF", 4)) ok = parseAIFF(internals, size, false);
+        else if (!memcmp(header, "FORM", 4) && !memcmp(header + 8, "AIFC", 4)) ok = parseAIFF(internals, size, true);
+    }
+    if (ok) ok = (fseek64(internals->file, internals->dataOffset, SEEK_SET) == 0);
+    if (!ok) {
+        fclose(internals->file);
+        internals->file = NULL;
+    }
+    return ok;
+}
+
+// Maps the entire file read-only. Fails for files larger than the address space (32-bit), then file I/O is used.
+static bool mapFile(floatDecoderInternals *internals, const char *path, int64_t size) {
+    if ((size <= 0) || ((uint64_t)size > (uint64_t)SIZE_MAX)) return false;
+    internals->mappedBytes = (size_t)size;
+    internals->advisedUntil = 0;
+#if _WIN32
+    internals->mapFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (internals->mapFile == INVALID_HANDLE_VALUE) return false;
+    internals->mapping = CreateFileMappingA(internals->mapFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    internals->mapped = internals->mapping ? (const unsigned char *)MapViewOfFile(internals->mapping, FILE_MAP_READ, 0, 0, internals->mappedBytes) : NULL;
+    if (internals->mapped) return true;
+    if (internals->mapping) CloseHandle(internals->mapping);
+    CloseHandle(internals->mapFile);
+#else
+    const int file = open(path, O_RDONLY);
+    if (file < 0) return false;
+    void *data = mmap(NULL, internals->mappedBytes, PROT_READ, MAP_SHARED, file, 0);
+    close(file); // The mapping keeps a reference to the file.
+    if (data != MAP_FAILED) {
+        internals->mapped = (const unsigned char *)data;
+        madvise(data, internals->mappedBytes, MADV_SEQUENTIAL);
+        return true;
+    }
+#endif
+    return false;
+}
+
+static void unmapFile(floatDecoderInternals *internals) {
+    if (!internals->mapped) return;
+#if _WIN32
+    UnmapViewOfFile(internals->mapped);
+    CloseHandle(internals->mapping);
+    CloseHandle(internals->mapFile);
+#else
+    munmap((void *)internals->mapped, internals->mappedBytes);
+#endif
+    internals->mapped = NULL;
+}
+
+// Asks the kernel to read a range of the mapping ahead, so the first access doesn't block on a page fault.
+static void willNeed(floatDecoderInternals *internals, size_t offset, size_t bytes) {
+#if !_WIN32
+    static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    if (offset >= internals->mappedBytes) return;
+    const size_t start = offset - offset % pageSize;
+    bytes += offset - start;
+    if (bytes > internals->mappedBytes - start) bytes = internals->mappedBytes - start;
+    madvise((void *)(internals->mapped + start), bytes, MADV_WILLNEED);
+#endif
+}
+
+static void closeFile(floatDecoderInternals *internals) {
+    delete internals->decoder;
+    internals->decoder = NULL;
+    if (internals->file) fclose(internals->file);
+    internals->file = NULL;
+    unmapFile(internals);
+    free(internals->buffer);
+    internals->buffer = NULL;
+    internals->samplerate = internals->durationFrames = internals->position = internals->pcmStart = internals->pcmEnd = 0;
+    internals->numChannels = 2;
+    internals->bitsPerSample = 16;
+}
+
+FloatDecoder::FloatDecoder() {
+    internals = new floatDecoderInternals;
+    internals->decoder = NULL;
+    internals->file = NULL;
+    internals->mapped = NULL;
+    internals->buffer = NULL;
+    closeFile(internals);
+}
+
+FloatDecoder::~FloatDecoder() {
+    closeFile(internals);
+    delete internals;
+}
+
+int FloatDecoder::open(const char *path, bool memoryMap) {
+    closeFile(internals);
+
+    if (openPCM(internals, path)) {
+        if (memoryMap && mapFile(internals, path, fileSize(internals->file))) {
+            fclose(internals->file);
+            internals->file = NULL;
+        }
+        internals->buffer = (unsigned char *)malloc((size_t)readBufferFrames * internals->frameBytes);
+        if (!internals->buffer) {
+            closeFile(internals);
+            return Decoder::OpenError_OutOfMemory;
+        }
+        return Decoder::OpenSuccess;
+    }
+
+    internals->numChannels = 2;
+    internals->bitsPerSample = 16;
+    internals->decoder = new Decoder();
+    const int result = internals->decoder->open(path);
+    if (result == Decoder::OpenSuccess) {
+        internals->samplerate = internals->decoder->getSamplerate();
+        internals->framesPerChunk = internals->decoder->getFramesPerChunk();
+        internals->buffer = (unsigned char *)malloc(internals->framesPerChunk * 4 + 16384);
+        if (internals->buffer) return Decoder::OpenSuccess;
+        closeFile(internals);
+        return Decoder::OpenError_OutOfMemory;
+    }
+    closeFile(internals);
+    return result;
+}
+
+static void swapBytes(unsigned char *data, unsigned int numberOfSamples, unsigned int bytesPerSample) {
+    switch (bytesPerSample) {
+        case 2: for (unsigned int n = 0; n < numberOfSamples; n++, data += 2) { unsigned char t = data[0]; data[0] = data[1]; data[1] = t; } break;
+        case 3: for (unsigned int n = 0; n < numberOfSamples; n++, data += 3) { unsigned char t = data[0]; data[0] = data[2]; data[2] = t; } break;
+        case 4: for (unsigned int n = 0; n < numberOfSamples; n++, data += 4) {
+            unsigned char t = data[0]; data[0] = data[3]; data[3] = t;
+            t = data[1]; data[1] = data[2]; data[2] = t;
+        } break;
+        case 8: for (unsigned int n = 0; n < numberOfSamples; n++, data += 8) {
+            for (int i = 0; i < 4; i++) { unsigned char t = data[i]; data[i] = data[7 - i]; data[7 - i] = t; }
+        } break;
+    }
+}
+
+// Converts little endian (or byte swapped) PCM to float. The integer formats are scaled as in SIMD::IntToFloatGetPeaks(). The input is not changed, it may be a read-only mapping.
+static void pcmToFloat(floatDecoderInternals *internals, const unsigned char *input, float *output, unsigned int numberOfFrames) {
+    const unsigned int numberOfSamples = numberOfFrames * internals->numChannels;
+    switch (internals->encoding) {
+        case pcmEncoding_UInt8: for (unsigned int n = 0; n < numberOfSamples; n++) output[n] = float(int(input[n]) - 128) * (1.0f / 128.0f); break;
+        case pcmEncoding_Int8: for (unsigned int n = 0; n < numberOfSamples; n++) output[n] = float((signed char)input[n]) * (1.0f / 128.0f); break;
+        case pcmEncoding_Int:
+            SIMD::IntToFloatGetPeaks((void *)input, (internals->bytesPerSample == 2) ? SIMD::SampleFormat_Int16 : ((internals->bytesPerSample == 3) ? SIMD::SampleFormat_Int24 : SIMD::SampleFormat_Int32), output, numberOfFrames, internals->numChannels);
+            break;
+        case pcmEncoding_Float:
+            if (internals->bytesPerSample == 4) memcpy(output, input, (size_t)numberOfSamples * 4);
+            else for (unsigned int n = 0; n < numberOfSamples; n++, input += 8) {
+                double sample;
+                memcpy(&sample, input, 8); // The data may be unaligned in a mapping.
+                output[n] = (float)sample;
+            }
+            break;
+    }
+}
+
+static int decodePCM(floatDecoderInternals *internals, float *output, unsigned int numberOfFrames) {
+    if (internals->position >= internals->durationFrames) return Decoder::EndOfFile;
+    if (numberOfFrames > internals->durationFrames - internals->position) numberOfFrames = internals->durationFrames - internals->position;
+
+    const unsigned char *mapped = NULL;
+    if (internals->mapped) {
+        const size_t start = (size_t)internals->dataOffset + (size_t)internals->position * internals->frameBytes, end = start + (size_t)numberOfFrames * internals->frameBytes;
+        mapped = internals->mapped + start;
+        // Keeps the read ahead readAheadBytes in front of the reading position.
+        if (end + readAheadBytes / 2 > internals->advisedUntil) {
+            const size_t from = (internals->advisedUntil > start) ? internals->advisedUntil : start;
+            willNeed(internals, from, end + readAheadBytes - from);
+            internals->advisedUntil = end + readAheadBytes;
+        }
+    }
+
+    unsigned int decoded = 0;
+    while (decoded < numberOfFrames) {
+        unsigned int frames = numberOfFrames - decoded;
+        const unsigned char *input = internals->buffer;
+        float *out = output + (size_t)decoded * internals->numChannels;
+
+        if (mapped && !internals->bigEndian) { // Converted straight from the mapping.
+            pcmToFloat(internals, mapped, out, frames);
+            decoded += frames;
+            break;
+        }
+        if (frames > readBufferFrames) frames = readBufferFrames;
+        if (mapped) {
+            memcpy(internals->buffer, mapped, (size_t)frames * internals->frameBytes);
+            mapped += (size_t)frames * internals->frameBytes;
+        } else {
+            frames = (unsigned int)fread(internals->buffer, internals->frameBytes, frames, internals->file);
+            if (!frames) break;
+        }
+        if (internals->bigEndian) swapBytes(internals->buffer, frames * internals->numChannels, internals->bytesPerSample);
+        pcmToFloat(internals, input, out, frames);
+        decoded += frames;
+    }
+    internals->position += decoded;
+    if (decoded) return (int)decoded;
+    return (internals->file && ferror(internals->file)) ? Decoder::Error : Decoder::EndOfFile;
+}
+
+// Decoder output is converted chunk by chunk. The frames not consumed yet are kept for the next call.
+static int decodeCompressed(floatDecoderInternals *internals, float *output, unsigned int numberOfFrames) {
+    short int *pcm = (short int *)internals->buffer;
+    unsigned int decoded = 0;
+    while (decoded < numberOfFrames) {
+        if (internals->pcmStart >= internals->pcmEnd) {
+            const int result = internals->decoder->decodeAudio(pcm, internals->framesPerChunk);
+            if (result <= 0) {
+                if (decoded) break;
+                return result;
+            }
+            internals->pcmStart = 0;
+            internals->pcmEnd = (unsigned int)result;
+        }
+        unsigned int frames = internals->pcmEnd - internals->pcmStart;
+        if (frames > numberOfFrames - decoded) frames = numberOfFrames - decoded;
+        SIMD::ShortIntToFloat(pcm + internals->pcmStart * 2, output + (size_t)decoded * 2, frames, 2);
+        internals->pcmStart += frames;
+        decoded += frames;
+    }
+    internals->position += decoded;
+    return (int)decoded;
+}
+
+int FloatDecoder::decodeAudioFloat(float *output, unsigned int numberOfFrames) {
+    if (!internals->buffer) return Decoder::Error;
+    if (!numberOfFrames) return 0;
+    return internals->decoder ? decodeCompressed(internals, output, numberOfFrames) : decodePCM(internals, output, numberOfFrames);
+}
+
+bool FloatDecoder::setPositionPrecise(unsigned int frame) {
+    if (!internals->buffer) return false;
+    if (internals->decoder) {
+        if (!internals->decoder->setPositionPrecise((int)frame)) return false;
+        internals->pcmStart = internals->pcmEnd = 0;
+    } else {
+        if (frame > internals->durationFrames) return false;
+        if (internals->file && (fseek64(internals->file, internals->dataOffset + (int64_t)frame * internals->frameBytes, SEEK_SET) != 0)) return false;
+        internals->advisedUntil = 0;
+    }
+    internals->position = frame;
+    return true;
+}
+
+unsigned int FloatDecoder::getPositionFrames() {
+    return internals->position;
+}
+
+int FloatDecoder::getDurationFrames() {
+    return internals->decoder ? internals->decoder->getDurationFrames() : (int)internals->durationFrames;
+}
+
+unsigned int FloatDecoder::getSamplerate() {
+    return internals->samplerate;
+}
+
+unsigned int FloatDecoder::getNumberOfChannels() {
+    return internals->numChannels;
+}
+
+unsigned int FloatDecoder::getBitsPerSample() {
+    return internals->bitsPerSample;
+}
+
+bool FloatDecoder::isNativePCM() {
+    return internals->file || internals->mapped;
+}
+
+bool FloatDecoder::isMemoryMapped() {
+    return internals->mapped != NULL;
+}
+
+const float *FloatDecoder::getFloatPointer(unsigned int frame, unsigned int numberOfFrames) {
+    if (!internals->mapped || (internals->encoding != pcmEncoding_Float) || (internals->bytesPerSample != 4) || internals->bigEndian || (internals->dataOffset & 3)) return NULL;
+    if ((frame > internals->durationFrames) || (numberOfFrames > internals->durationFrames - frame)) return NULL;
+    const size_t offset = (size_t)internals->dataOffset + (size_t)frame * internals->frameBytes;
+    willNeed(internals, offset, (size_t)numberOfFrames * internals->frameBytes);
+    return (const float *)(internals->mapped + offset);
+}
+
+void FloatDecoder::prefetch(unsigned int frame, unsigned int numberOfFrames) {
+    if (!internals->mapped || (frame >= internals->durationFrames)) return;
+    if (numberOfFrames > internals->durationFrames - frame) numberOfFrames = internals->durationFrames - frame;
+    willNeed(internals, (size_t)internals->dataOffset + (size_t)frame * internals->frameBytes, (size_t)numberOfFrames * internals->frameBytes);
+}
+
+Decoder *FloatDecoder::getDecoder() {
+    return internals->decoder;
+}
+
+}
@@ -0,0 +1,79 @@
+#ifndef Header_SuperpoweredFloatDecoder
+#define Header_SuperpoweredFloatDecoder
+
+namespace Superpowered {
+
+class Decoder;
+struct floatDecoderInternals;
+
+/// @brief Audio file decoder with 32-bit floating point output, for offline analysis and processing.
+/// WAV (8, 16, 24 and 32-bit integer, 32 and 64-bit floating point, WAVE_FORMAT_EXTENSIBLE) and AIFF/AIFC (8, 16, 24 and 32-bit integer, little endian "sowt", 32 and 64-bit floating point) files are read and converted directly, in the number of channels of the file, without the 16-bit round trip of Decoder::decodeAudio().
+/// Every other format (MP3, AAC, etc.) is decoded by Decoder and converted to float, stereo.
+/// WAV and AIFF files can be memory mapped instead of read with file I/O: the samples are converted straight from the page cache to the output, and 32-bit floating point content can be accessed in place with getFloatPointer(), without any copy. Sequential access is hinted to the kernel (madvise), and the next 4 MB are read ahead while decoding.
+/// The methods may block and allocate, do not call them in the audio processing thread. One instance can not be used on multiple threads concurrently.
+class FloatDecoder {
+public:
+    FloatDecoder();
+    ~FloatDecoder();
+
+/// @brief Opens a file. PCM WAV and AIFF files are read directly, other formats are opened with Decoder.
+/// @return Returns with Decoder::OpenSuccess or the return value of Decoder::open().
+/// @param path Full file system path or progressive download path (http or https).
+/// @param memoryMap Memory map WAV and AIFF files. If the file can not be mapped (for example larger than the address space of a 32-bit process), file I/O is used. No effect on other formats.
+    int open(const char *path, bool memoryMap = false);
+
+/// @brief Decodes the next frames.
+/// @return Returns with the number of frames decoded (less than numberOfFrames at the end of the file), Decoder::EndOfFile, or the negative return value of Decoder::decodeAudio() (Decoder::BufferingTryAgainLater, Decoder::NetworkError or Decoder::Error).
+/// @param output Pointer to floating point numbers. 32-bit interleaved output, numberOfFrames * getNumberOfChannels() big. 0 dB is 1.0f.
+/// @param numberOfFrames The number of frames to decode.
+    int decodeAudioFloat(float *output, unsigned int numberOfFrames);
+
+/// @brief Jumps to a specific position. Precise for WAV and AIFF, see Decoder::setPositionPrecise() for the other formats.
+/// @return Returns with true if successful, false if frame is beyond the end of the file.
+/// @param frame The position in frames.
+    bool setPositionPrecise(unsigned int frame);
+
+/// @return Returns with the current position in frames.
+    unsigned int getPositionFrames();
+
+/// @return Returns with the duration of the current file in frames, see Decoder::getDurationFrames().
+    int getDurationFrames();
+
+/// @return Returns with the sample rate of the current file.
+    unsigned int getSamplerate();
+
+/// @return Returns with the number of channels in the output: the number of channels of a WAV or AIFF file, 2 for the other formats.
+    unsigned int getNumberOfChannels();
+
+/// @return Returns with the bits per sample of a WAV or AIFF file, 16 for the other formats.
+    unsigned int getBitsPerSample();
+
+/// @return Returns with true if the current file is a PCM WAV or AIFF file, read without Decoder.
+    bool isNativePCM();
+
+/// @return Returns with true if the current file is memory mapped.
+    bool isMemoryMapped();
+
+/// @brief Zero-copy access to the samples of a memory mapped 32-bit floating point WAV file. Doesn't change the decoding position.
+/// @return Returns with a pointer to the interleaved samples of frame in the mapping, or NULL if the file is not a memory mapped 32-bit float WAV file (AIFC floats are big endian), the samples are not 4-byte aligned in the file, or the range is beyond the end of the file. The pointer is valid until the next open() or the destruction of this instance, the memory is read-only.
+/// @param frame The first frame.
+/// @param numberOfFrames The number of frames the caller will read. The kernel is asked to read them ahead.
+    const float *getFloatPointer(unsigned int frame, unsigned int numberOfFrames);
+
+/// @brief Asks the kernel to read a range of a memory mapped file ahead (madvise MADV_WILLNEED), for example the start of the samples a sampler may play next. Returns immediately. No effect if the file is not memory mapped or on Windows.
+/// @param frame The first frame.
+/// @param numberOfFrames The number of frames.
+    void prefetch(unsigned int frame, unsigned int numberOfFrames);
+
+/// @return Returns with the Decoder of a compressed file for metadata, or NULL for WAV and AIFF. Don't delete it, and don't decode or seek with it.
+    Decoder *getDecoder();
+
+private:
+    floatDecoderInternals *internals;
+    FloatDecoder(const FloatDecoder&);
+    FloatDecoder& operator=(const FloatDecoder&);
+};
+
+}
+
+#endif
@@ -0,0 +1,114 @@
+#include "SuperpoweredHalfAudio.h"
+#include "SuperpoweredSIMD.h"
+#include "SuperpoweredDecoder.h"
+#include <stdlib.h>
+
+namespace Superpowered {
+
+struct halfAudioInternals {
+    unsigned short *data;
+    unsigned int samplerate, numChannels, durationFrames, capacityFrames;
+    HalfAudio::Format format;
+};
+
+// Decoding chunk size if the decoder reports a smaller one.
+static const unsigned int minimumDecodeFrames = 1024;
+
+static bool reserve(halfAudioInternals *internals, unsigned int frames) {
+    if (frames <= internals->capacityFrames) return true;
+    unsigned int capacity = internals->capacityFrames * 2;
+    if (capacity < frames) capacity = frames;
+    unsigned short *data = (unsigned short *)realloc(internals->data, (size_t)capacity * internals->numChannels * sizeof(unsigned short));
+    if (!data) return false;
+    internals->data = data;
+    internals->capacityFrames = capacity;
+    return true;
+}
+
+HalfAudio::HalfAudio(unsigned int samplerate, unsigned int numChannels, Format format, unsigned int capacityFrames) {
+    internals = new halfAudioInternals;
+    internals->data = NULL;
+    internals->samplerate = samplerate;
+    internals->numChannels = numChannels ? numChannels : 1;
+    internals->durationFrames = internals->capacityFrames = 0;
+    internals->format = format;
+    reserve(internals, capacityFrames);
+}
+
+HalfAudio::~HalfAudio() {
+    free(internals->data);
+    delete internals;
+}
+
+bool HalfAudio::append(float *input, unsigned int numberOfFrames) {
+    if (!reserve(internals, internals->durationFrames + numberOfFrames)) return false;
+    unsigned short *output = internals->data + (size_t)internals->durationFrames * internals->numChannels;
+    const unsigned int numberOfValues = numberOfFrames * internals->numChannels;
+    if (internals->format == Format_Half) SIMD::FloatToHalf(input, output, numberOfValues); else SIMD::FloatToBFloat16(input, output, numberOfValues);
+    internals->durationFrames += numberOfFrames;
+    return true;
+}
+
+unsigned int HalfAudio::read(float *output, unsigned int startFrame, unsigned int numberOfFrames) {
+    if (startFrame >= internals->durationFrames) return 0;
+    if (numberOfFrames > internals->durationFrames - startFrame) numberOfFrames = internals->durationFrames - startFrame;
+    unsigned short *input = internals->data + (size_t)startFrame * internals->numChannels;
+    const unsigned int numberOfValues = numberOfFrames * internals->numChannels;
+    if (internals->format == Format_Half) SIMD::HalfToFloat(input, output, numberOfValues); else SIMD::BFloat16ToFloat(input, output, numberOfValues);
+    return numberOfFrames;
+}
+
+int HalfAudio::decode(Decoder *decoder) {
+    if (internals->numChannels != 2) return Decoder::Error;
+    const int duration = decoder->getDurationFrames();
+    if ((duration > 0) && !reserve(internals, (unsigned int)duration)) return Decoder::Error;
+
+    unsigned int framesPerChunk = decoder->getFramesPerChunk();
+    if (framesPerChunk < minimumDecodeFrames) framesPerChunk = minimumDecodeFrames;
+    short int *pcm = (short int *)malloc(framesPerChunk * 4 + 16384);
+    float *floats = (float *)malloc(framesPerChunk * 2 * sizeof(float));
+    int result = Decoder::Error;
+
+    if (pcm && floats) while (true) {
+        result = decoder->decodeAudio(pcm, framesPerChunk);
+        if (result <= 0) break;
+        SIMD::ShortIntToFloat(pcm, floats, (unsigned int)result, 2);
+        if (!append(floats, (unsigned int)result)) {
+            result = Decoder::Error;
+            break;
+        }
+    }
+    free(pcm);
+    free(floats);
+    return result;
+}
+
+void HalfAudio::clear() {
+    internals->durationFrames = 0;
+}
+
+unsigned int HalfAudio::getDurationFrames() {
+    return internals->durationFrames;
+}
+
+unsigned int HalfAudio::getSamplerate() {
+    return internals->samplerate;
+}
+
+unsigned int HalfAudio::getNumChannels() {
+    return internals->numChannels;
+}
+
+HalfAudio::Format HalfAudio::getFormat() {
+    return internals->format;
+}
+
+unsigned short *HalfAudio::getData() {
+    return internals->data;
+}
+
+unsigned int HalfAudio::getMemoryBytes() {
+    return internals->capacityFrames * internals->numChannels * (unsigned int)sizeof(unsigned short);
+}
+
+}
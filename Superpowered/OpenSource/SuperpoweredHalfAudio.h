@@ -0,0 +1,75 @@
+#ifndef Header_SuperpoweredHalfAudio
+#define Header_SuperpoweredHalfAudio
+
+namespace Superpowered {
+
+class Decoder;
+struct halfAudioInternals;
+
+/// @brief Interleaved audio kept in memory with 16-bit floating point samples, for sampler content, caches and previews.
+/// Needs half the memory of 32-bit float audio. Half precision (fp16) has 11 bits of precision and headroom up to 65504, so processed or boosted audio can be stored without clipping.
+/// append() and decode() are not thread safe with read(), load the audio before sharing it with the audio processing thread.
+class HalfAudio {
+public:
+    /// @brief Sample formats.
+    typedef enum Format {
+        Format_Half = 0,    ///< IEEE 754 half precision (fp16). 11 bits of precision, range up to 65504.
+        Format_BFloat16 = 1 ///< bfloat16. 8 bits of precision, same range as float.
+    } Format;
+
+/// @brief Constructor.
+/// @param samplerate The sample rate of the audio in Hz.
+/// @param numChannels The number of channels.
+/// @param format Sample format.
+/// @param capacityFrames Memory to allocate in advance, in frames. The buffer grows automatically if needed.
+    HalfAudio(unsigned int samplerate, unsigned int numChannels = 2, Format format = Format_Half, unsigned int capacityFrames = 0);
+    ~HalfAudio();
+
+/// @brief Appends audio to the end.
+/// @return Returns with false if memory allocation failed. Nothing is appended in this case.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input with getNumChannels() channels.
+/// @param numberOfFrames The number of frames to append.
+    bool append(float *input, unsigned int numberOfFrames);
+
+/// @brief Converts stored audio back to 32-bit float.
+/// @return The number of frames read. Less than numberOfFrames at the end of the audio.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output with getNumChannels() channels.
+/// @param startFrame The first frame to read.
+/// @param numberOfFrames The number of frames to read.
+    unsigned int read(float *output, unsigned int startFrame, unsigned int numberOfFrames);
+
+/// @brief Decodes audio from an opened Decoder and appends it. The Decoder outputs stereo, so getNumChannels() must be 2.
+/// @return The result of the last Decoder::decodeAudio() call: Decoder::EndOfFile after all audio was decoded, Decoder::BufferingTryAgainLater if decode() should be called again later to continue, or an error code. Decoder::Error is also returned if memory allocation failed or the number of channels is not 2.
+/// @param decoder The decoder. It's not deleted or closed.
+    int decode(Decoder *decoder);
+
+/// @brief Removes all audio. The allocated memory is kept.
+    void clear();
+
+/// @return Returns with the number of frames stored.
+    unsigned int getDurationFrames();
+
+/// @return Returns with the sample rate in Hz.
+    unsigned int getSamplerate();
+
+/// @return Returns with the number of channels.
+    unsigned int getNumChannels();
+
+/// @return Returns with the sample format.
+    Format getFormat();
+
+/// @return Returns with the stored samples. getDurationFrames() * getNumChannels() values in the sample format.
+    unsigned short *getData();
+
+/// @return Returns with the size of the allocated memory in bytes.
+    unsigned int getMemoryBytes();
+
+private:
+    halfAudioInternals *internals;
+    HalfAudio(const HalfAudio&);
+    HalfAudio& operator=(const HalfAudio&);
+};
+
+}
+
+#endif
@@ -0,0 +1,539 @@
+#include "SuperpoweredIndexedDecoder.h"
+#include "SuperpoweredDecoder.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if _WIN32
+#include <windows.h>
+#include <process.h>
+#define fseek64 _fseeki64
+#define getpid _getpid
+#else
+#include <unistd.h>
+#define fseek64 fseeko
+#endif
+
+namespace Superpowered {
+
+static const unsigned int indexVersion = 1, headerBytes = 64;
+static const unsigned int windowFrames = 1024;        // The number of frames a Decoder is opened on. Smaller windows open faster, larger windows reopen less often.
+static const unsigned int maximumPrimingFrames = 16;  // The maximum number of frames decoded and discarded before the position.
+static const unsigned int maximumSilentFrames = 1024; // The maximum number of frames without main data skipped before the position, to find the last frame with main data.
+static const unsigned int maximumFrameBytes = 1441;   // Layer III, 320 kbps at 32000 Hz or 160 kbps at 8000 Hz, padded.
+static const unsigned int scanBufferBytes = 1024 * 1024;
+static const int64_t maximumFileBytes = 0x7fffffff;   // Decoder::open() takes int offsets.
+
+// The frames of an MP3 file.
+struct seekIndex {
+    uint32_t *offsets;  // The byte offset of every frame and the end of the last frame, numFrames + 1 entries.
+    unsigned int numFrames, samplerate, samplesPerFrame;
+};
+
+struct indexedDecoderInternals {
+    Decoder *decoder;
+    FILE *file;                 // Indexed files: reads the side information of the frames before a position.
+    char *path, *cacheDirectory;
+    short int *pcm;             // decodeAudio() output, framesPerChunk * 4 + 16384 bytes.
+    unsigned char *frameBuffer; // maximumPrimingFrames * maximumFrameBytes.
+    seekIndex index;            // offsets is NULL if the file is not indexed.
+    unsigned int framesPerChunk, position, decoderPosition, discard, pcmStart, pcmEnd;
+};
+
+struct mp3Header {
+    unsigned int bytes, samplerate, samplesPerFrame, sideInfoOffset, sideInfoBytes, streamKey;
+    bool mpeg1, mono;
+};
+
+// Parses an MPEG Layer III frame header. Returns false for anything else, including free format frames.
+static bool parseHeader(const unsigned char *h, mp3Header *header) {
+    static const unsigned short bitrates1[15] = { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 }, bitrates2[15] = { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 };
+    static const unsigned int samplerates[3] = { 44100, 48000, 32000 };
+    if ((h[0] != 0xff) || ((h[1] & 0xe0) != 0xe0)) return false;
+    const unsigned int version = (h[1] >> 3) & 3, layer = (h[1] >> 1) & 3, bitrateIndex = h[2] >> 4, samplerateIndex = (h[2] >> 2) & 3;
+    if ((version == 1) || (layer != 1) || !bitrateIndex || (bitrateIndex == 15) || (samplerateIndex == 3)) return false;
+
+    header->mpeg1 = (version == 3);
+    header->samplerate = samplerates[samplerateIndex] >> (header->mpeg1 ? 0 : ((version == 2) ? 1 : 2));
+    header->samplesPerFrame = header->mpeg1 ? 1152 : 576;
+    const unsigned int bitrate = (header->mpeg1 ? bitrates1 : bitrates2)[bitrateIndex] * 1000;
+    header->bytes = (header->mpeg1 ? 144 : 72) * bitrate / header->samplerate + ((h[2] >> 1) & 1);
+    header->sideInfoOffset = (h[1] & 1) ? 4 : 6; // CRC.
+    header->mono = ((h[3] >> 6) == 3);
+    header->sideInfoBytes = header->mpeg1 ? (header->mono ? 17 : 32) : (header->mono ? 9 : 17);
+    header->streamKey = ((h[1] & 0xfe) << 8) | (h[2] & 0x0c); // Version, layer and sample rate, the same in every frame.
+    return header->bytes > header->sideInfoOffset + header->sideInfoBytes;
+}
+
+// Sequential reads of the file through a large buffer.
+struct scanReader {
+    FILE *file;
+    unsigned char *data;
+    int64_t start, size;
+    unsigned int bytes;
+};
+
+// Returns with a pointer to bytes at offset, or NULL if the file is shorter.
+static const unsigned char *peek(scanReader *reader, int64_t offset, unsigned int bytes) {
+    if (offset + bytes > reader->size) return NULL;
+    if ((offset < reader->start) || (offset + bytes > reader->start + reader->bytes)) {
+        if (fseek64(reader->file, offset, SEEK_SET) != 0) return NULL;
+        reader->start = offset;
+        reader->bytes = (unsigned int)fread(reader->data, 1, scanBufferBytes, reader->file);
+        if (reader->bytes < bytes) return NULL;
+    }
+    return reader->data + (offset - reader->start);
+}
+
+// A frame is accepted if the next two frames follow it, when locking on the stream first and after losing sync.
+static bool isSynced(scanReader *reader, int64_t offset, const mp3Header *header) {
+    mp3Header next = *header;
+    for (int n = 0; n < 2; n++) {
+        offset += next.bytes;
+        if (offset == reader->size) return true;
+        const unsigned char *h = peek(reader, offset, 4);
+        if (!h || !parseHeader(h, &next) || (next.streamKey != header->streamKey)) return false;
+    }
+    return true;
+}
+
+static bool appendFrame(seekIndex *index, unsigned int *capacity, uint32_t offset) {
+    if (index->numFrames + 1 >= *capacity) {
+        *capacity = *capacity * 2 + 4096;
+        uint32_t *offsets = (uint32_t *)realloc(index->offsets, *capacity * sizeof(uint32_t));
+        if (!offsets) return false;
+        index->offsets = offsets;
+    }
+    index->offsets[index->numFrames++] = offset;
+    return true;
+}
+
+// Finds every frame of a Layer III file. Returns false for other formats.
+static bool scanFrames(const char *path, int64_t size, seekIndex *index) {
+    scanReader reader;
+    reader.file = fopen(path, "rb");
+    if (!reader.file) return false;
+    reader.data = (unsigned char *)malloc(scanBufferBytes);
+    reader.size = size;
+    reader.start = 0;
+    reader.bytes = 0;
+
+    int64_t offset = 0, end = 0;
+    const unsigned char *h;
+    // ID3v2 tags: 10 bytes header with a syncsafe size, plus a 10 bytes footer if flagged.
+    while (reader.data && (h = peek(&reader, offset, 10)) && !memcmp(h, "ID3", 3)) offset += 10 + ((h[5] & 0x10) ? 10 : 0) + (((h[6] & 0x7f) << 21) | ((h[7] & 0x7f) << 14) | ((h[8] & 0x7f) << 7) | (h[9] & 0x7f));
+    // The first frame must be close to the start, other formats may contain something similar to an MP3 frame anywhere.
+    const int64_t firstFrameLimit = offset + 65536;
+
+    unsigned int capacity = 0, streamKey = 0;
+    bool synced = false, ok = (reader.data != NULL);
+    index->offsets = NULL;
+    index->numFrames = 0;
+    mp3Header header;
+    while (ok && (h = peek(&reader, offset, 4))) {
+        if (parseHeader(h, &header) && (!index->numFrames || (header.streamKey == streamKey)) && (offset + header.bytes <= size) && (synced || isSynced(&reader, offset, &header))) {
+            if (!index->numFrames) {
+                streamKey = header.streamKey;
+                index->samplerate = header.samplerate;
+                index->samplesPerFrame = header.samplesPerFrame;
+            }
+            ok = appendFrame(index, &capacity, (uint32_t)offset);
+            offset += header.bytes;
+            end = offset;
+            synced = true;
+        } else {
+            if (!index->numFrames && (offset >= firstFrameLimit)) break;
+            synced = false; // Junk or a tag, search for the next frame.
+            offset++;
+        }
+    }
+    if (ok && index->numFrames) index->offsets[index->numFrames] = (uint32_t)end; // appendFrame() keeps room for it.
+    free(reader.data);
+    fclose(reader.file);
+    if (!ok || !index->numFrames) {
+        free(index->offsets);
+        index->offsets = NULL;
+        return false;
+    }
+    return true;
+}
+
+static void writeLE32(unsigned char *p, uint32_t value) { for (int n = 0; n < 4; n++) p[n] = (unsigned char)(value >> (n * 8)); }
+static void writeLE64(unsigned char *p, uint64_t value) { for (int n = 0; n < 8; n++) p[n] = (unsigned char)(value >> (n * 8)); }
+static uint32_t readLE32(const unsigned char *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint64_t readLE64(const unsigned char *p) { return readLE32(p) | ((uint64_t)readLE32(p + 4) << 32); }
+
+// The size and modification time identify the version of the audio file.
+static bool fileInfo(const char *path, int64_t *size, int64_t *modified) {
+#if _WIN32
+    struct _stat64 info;
+    if (_stat64(path, &info) != 0) return false;
+#else
+    struct stat info;
+    if (stat(path, &info) != 0) return false;
+#endif
+    *size = (int64_t)info.st_size;
+    *modified = (int64_t)info.st_mtime;
+    return true;
+}
+
+// The sidecar path: path + ".spsi", or a hash (64-bit FNV-1a) of the path in cacheDirectory.
+static char *sidecarPath(const char *path, const char *cacheDirectory) {
+    const size_t length = strlen(path);
+    char *sidecar;
+    if (cacheDirectory) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t n = 0; n < length; n++) hash = (hash ^ (unsigned char)path[n]) * 1099511628211ULL;
+        sidecar = (char *)malloc(strlen(cacheDirectory) + 24);
+        if (sidecar) sprintf(sidecar, "%s/%016llx.spsi", cacheDirectory, (unsigned long long)hash);
+    } else {
+        sidecar = (char *)malloc(length + 6);
+        if (sidecar) sprintf(sidecar, "%s.spsi", path);
+    }
+    return sidecar;
+}
+
+static bool loadSidecar(const char *sidecar, int64_t size, int64_t modified, seekIndex *index) {
+    FILE *file = fopen(sidecar, "rb");
+    if (!file) return false;
+    unsigned char header[headerBytes];
+    unsigned char *sizes = NULL;
+    index->offsets = NULL;
+    bool ok = (fread(header, 1, headerBytes, file) == headerBytes) && !memcmp(header, "SPSI", 4) && (readLE32(header + 4) == indexVersion) && ((int64_t)readLE64(header + 8) == size) && ((int64_t)readLE64(header + 16) == modified);
+    if (ok) {
+        index->samplerate = readLE32(header + 24);
+        index->samplesPerFrame = readLE32(header + 28);
+        index->numFrames = readLE32(header + 32);
+        const uint32_t firstOffset = readLE32(header + 36);
+        ok = index->numFrames && index->samplerate && index->samplesPerFrame && ((int64_t)index->numFrames * 2 < size);
+        if (ok) {
+            sizes = (unsigned char *)malloc((size_t)index->numFrames * 2);
+            index->offsets = (uint32_t *)malloc(((size_t)index->numFrames + 1) * sizeof(uint32_t));
+            ok = sizes && index->offsets && (fread(sizes, 2, index->numFrames, file) == index->numFrames);
+        }
+        if (ok) {
+            int64_t offset = firstOffset;
+            for (unsigned int n = 0; n < index->numFrames; n++) {
+                index->offsets[n] = (uint32_t)offset;
+                offset += sizes[n * 2] | (sizes[n * 2 + 1] << 8);
+            }
+            index->offsets[index->numFrames] = (uint32_t)offset;
+            ok = (offset <= size);
+        }
+    }
+    free(sizes);
+    fclose(file);
+    if (!ok) {
+        free(index->offsets);
+        index->offsets = NULL;
+    }
+    return ok;
+}
+
+static bool saveSidecar(const char *sidecar, int64_t size, int64_t modified, const seekIndex *index) {
+    unsigned char *data = (unsigned char *)calloc(headerBytes + (size_t)index->numFrames * 2, 1);
+    if (!data) return false;
+    memcpy(data, "SPSI", 4);
+    writeLE32(data + 4, indexVersion);
+    writeLE64(data + 8, (uint64_t)size);
+    writeLE64(data + 16, (uint64_t)modified);
+    writeLE32(data + 24, index->samplerate);
+    writeLE32(data + 28, index->samplesPerFrame);
+    writeLE32(data + 32, index->numFrames);
+    writeLE32(data + 36, index->offsets[0]);
+    for (unsigned int n = 0; n < index->numFrames; n++) {
+        const uint32_t bytes = index->offsets[n + 1] - index->offsets[n];
+        data[headerBytes + n * 2] = (unsigned char)bytes;
+        data[headerBytes + n * 2 + 1] = (unsigned char)(bytes >> 8);
+    }
+    const size_t dataBytes = headerBytes + (size_t)index->numFrames * 2;
+
+    // Written to a temporary file in the same directory first, then renamed over the sidecar. Other processes loading the sidecar meanwhile see the previous or the new one, never a partial file.
+    // The process id keeps concurrent writers (the same file indexed by two processes) away from each other's temporary file.
+    char *temporary = (char *)malloc(strlen(sidecar) + 32);
+    FILE *file = NULL;
+    bool ok = (temporary != NULL);
+    if (ok) {
+        sprintf(temporary, "%s.%d.tmp", sidecar, (int)getpid());
+        file = fopen(temporary, "wb");
+        ok = file && (fwrite(data, 1, dataBytes, file) == dataBytes);
+        if (file && (fclose(file) != 0)) ok = false;
+    }
+#if _WIN32
+    if (ok) ok = (MoveFileExA(temporary, sidecar, MOVEFILE_REPLACE_EXISTING) != 0); // rename() doesn't replace existing files on Windows.
+#else
+    if (ok) ok = (rename(temporary, sidecar) == 0);
+#endif
+    if (!ok && file) remove(temporary);
+    free(temporary);
+    free(data);
+    return ok;
+}
+
+// Loads the index from the sidecar, or scans the file and saves the sidecar. Returns false if the file can not be indexed.
+static bool getIndex(const char *path, const char *cacheDirectory, seekIndex *index, bool *saved) {
+    int64_t size, modified;
+    *saved = false;
+    if (!fileInfo(path, &size, &modified) || (size > maximumFileBytes)) return false;
+    char *sidecar = sidecarPath(path, cacheDirectory);
+    if (!sidecar) return false;
+    bool ok = loadSidecar(sidecar, size, modified, index);
+    if (ok) *saved = true;
+    else if (scanFrames(path, size, index)) {
+        ok = true;
+        *saved = saveSidecar(sidecar, size, modified, index);
+    }
+    free(sidecar);
+    return ok;
+}
+
+static void closeFile(indexedDecoderInternals *internals) {
+    delete internals->decoder;
+    internals->decoder = NULL;
+    if (internals->file) fclose(internals->file);
+    internals->file = NULL;
+    free(internals->path);
+    internals->path = NULL;
+    free(internals->pcm);
+    internals->pcm = NULL;
+    free(internals->index.offsets);
+    internals->index.offsets = NULL;
+    internals->index.numFrames = internals->framesPerChunk = internals->position = internals->decoderPosition = internals->discard = internals->pcmStart = internals->pcmEnd = 0;
+}
+
+IndexedDecoder::IndexedDecoder(const char *cacheDirectory) {
+    internals = new indexedDecoderInternals;
+    internals->decoder = NULL;
+    internals->file = NULL;
+    internals->path = NULL;
+    internals->pcm = NULL;
+    internals->index.offsets = NULL;
+    internals->cacheDirectory = cacheDirectory ? strdup(cacheDirectory) : NULL;
+    internals->frameBuffer = (unsigned char *)malloc(maximumPrimingFrames * maximumFrameBytes);
+    closeFile(internals);
+}
+
+IndexedDecoder::~IndexedDecoder() {
+    closeFile(internals);
+    free(internals->cacheDirectory);
+    free(internals->frameBuffer);
+    delete internals;
+}
+
+// Reads the frames from first to last (exclusive) into frameBuffer.
+static bool readFrames(indexedDecoderInternals *internals, unsigned int first, unsigned int last) {
+    const uint32_t *offsets = internals->index.offsets;
+    const unsigned int bytes = offsets[last] - offsets[first];
+    return bytes && (bytes <= maximumPrimingFrames * maximumFrameBytes) && (fseek64(internals->file, offsets[first], SEEK_SET) == 0) && (fread(internals->frameBuffer, 1, bytes, internals->file) == bytes);
+}
+
+static unsigned int readBits(const unsigned char *data, unsigned int bit, unsigned int numBits) {
+    unsigned int value = 0;
+    for (unsigned int n = bit; n < bit + numBits; n++) value = (value << 1) | ((data[n >> 3] >> (7 - (n & 7))) & 1);
+    return value;
+}
+
+// Returns with the main_data_begin of a frame. A frame has no main data if the part2_3_length of every granule and channel is 0: digital silence, Xing/Info/LAME tag frames and the padding frame at the end of LAME encodes.
+// Decoder doesn't decode those frames. Their output is silence, and the overlap of the last frame with main data is added to the next frame with main data.
+static unsigned int mainDataBegin(const unsigned char *frame, const mp3Header *header, bool *hasMainData) {
+    const unsigned char *sideInfo = frame + header->sideInfoOffset;
+    const unsigned int channels = header->mono ? 1 : 2, granules = header->mpeg1 ? 2 : 1;
+    // part2_3_length follows main_data_begin, the private bits and scfsi, then comes every 59 (MPEG-1) or 63 (MPEG-2/2.5) bits.
+    unsigned int bit = header->mpeg1 ? (9 + (header->mono ? 5 : 3) + channels * 4) : (8 + (header->mono ? 1 : 2));
+    *hasMainData = false;
+    for (unsigned int n = 0; n < granules * channels; n++, bit += header->mpeg1 ? 59 : 63) if (readBits(sideInfo, bit, 12)) *hasMainData = true;
+    return readBits(sideInfo, 0, header->mpeg1 ? 9 : 8);
+}
+
+// The number of frames the decoder can not decode when opened at first, as their main data starts in a frame before (bit reservoir). Frames without main data are never dropped.
+static unsigned int droppedFrames(indexedDecoderInternals *internals, unsigned int first, unsigned int last) {
+    const uint32_t *offsets = internals->index.offsets;
+    if (!readFrames(internals, first, last)) return 0;
+
+    unsigned int dropped = 0, reservoir = 0;
+    for (unsigned int n = first; n < last; n++) {
+        const unsigned char *frame = internals->frameBuffer + (offsets[n] - offsets[first]);
+        mp3Header header;
+        bool hasMainData;
+        if (!parseHeader(frame, &header)) return dropped;
+        const unsigned int begin = mainDataBegin(frame, &header, &hasMainData);
+        if ((dropped == n - first) && hasMainData && (begin > reservoir)) dropped++;
+        reservoir += header.bytes - header.sideInfoOffset - header.sideInfoBytes;
+    }
+    return dropped;
+}
+
+// Returns with the last frame with main data before frame, or frame - 1 if there is none within maximumSilentFrames (or the file can not be read).
+static unsigned int lastFrameWithMainData(indexedDecoderInternals *internals, unsigned int frame) {
+    const uint32_t *offsets = internals->index.offsets;
+    const unsigned int limit = (frame > maximumSilentFrames) ? frame - maximumSilentFrames : 0;
+    unsigned int last = frame, blockFrames = 1; // Usually the frame before has main data.
+    while (last > limit) {
+        const unsigned int first = (last - limit > blockFrames) ? last - blockFrames : limit;
+        blockFrames = maximumPrimingFrames;
+        if (!readFrames(internals, first, last)) break;
+        for (unsigned int n = last; n-- > first; ) {
+            const unsigned char *data = internals->frameBuffer + (offsets[n] - offsets[first]);
+            mp3Header header;
+            bool hasMainData;
+            if (!parseHeader(data, &header)) return frame - 1;
+            mainDataBegin(data, &header, &hasMainData);
+            if (hasMainData) return n;
+        }
+        last = first;
+    }
+    return frame - 1;
+}
+
+// Opens the decoder on the window of frames around position. The frames before position are decoded and discarded.
+static int openAt(indexedDecoderInternals *internals, unsigned int position) {
+    const seekIndex *index = &internals->index;
+    const unsigned int duration = index->numFrames * index->samplesPerFrame;
+    internals->pcmStart = internals->pcmEnd = internals->discard = 0;
+    if (position >= duration) {
+        internals->decoderPosition = duration;
+        return Decoder::OpenSuccess;
+    }
+
+    // The output of a frame overlaps the next one, so the last frame with main data before position must be decoded: usually the frame before, more after silence.
+    // Start at that frame, or before if it is dropped.
+    const unsigned int frame = position / index->samplesPerFrame, decodeFrom = frame ? lastFrameWithMainData(internals, frame) : 0;
+    unsigned int first = decodeFrom, dropped = 0;
+    while (frame) {
+        dropped = droppedFrames(internals, first, decodeFrom + 1);
+        if ((first + dropped <= decodeFrom) || !first || (decodeFrom + 1 - first >= maximumPrimingFrames - 1)) break;
+        first--;
+    }
+    unsigned int last = frame + windowFrames;
+    if (last > index->numFrames) last = index->numFrames;
+
+    // A Decoder doesn't decode anything after reaching the end of a file, not even after another open().
+    delete internals->decoder;
+    internals->decoder = new Decoder();
+    const int result = internals->decoder->open(internals->path, false, (int)index->offsets[first], (int)(index->offsets[last] - index->offsets[first]));
+    if (result != Decoder::OpenSuccess) return result;
+    if (!internals->pcm) {
+        internals->framesPerChunk = internals->decoder->getFramesPerChunk();
+        internals->pcm = (short int *)malloc(internals->framesPerChunk * 4 + 16384);
+        if (!internals->pcm) return Decoder::OpenError_OutOfMemory;
+    }
+    internals->decoderPosition = (first + dropped) * index->samplesPerFrame;
+    internals->discard = (position > internals->decoderPosition) ? position - internals->decoderPosition : 0;
+    return Decoder::OpenSuccess;
+}
+
+int IndexedDecoder::open(const char *path) {
+    closeFile(internals);
+    internals->path = strdup(path);
+    internals->decoder = new Decoder();
+    bool saved;
+
+    if (strncmp(path, "http", 4) && getIndex(path, internals->cacheDirectory, &internals->index, &saved)) {
+        internals->file = fopen(path, "rb");
+        if (internals->file) {
+            const int result = openAt(internals, 0);
+            if (result != Decoder::OpenSuccess) closeFile(internals);
+            return result;
+        }
+        free(internals->index.offsets);
+        internals->index.offsets = NULL;
+    }
+
+    const int result = internals->decoder->open(path);
+    if (result == Decoder::OpenSuccess) {
+        internals->framesPerChunk = internals->decoder->getFramesPerChunk();
+        internals->pcm = (short int *)malloc(internals->framesPerChunk * 4 + 16384);
+        if (internals->pcm) return Decoder::OpenSuccess;
+        closeFile(internals);
+        return Decoder::OpenError_OutOfMemory;
+    }
+    closeFile(internals);
+    return result;
+}
+
+int IndexedDecoder::decodeAudio(short int *output, unsigned int numberOfFrames) {
+    if (!internals->pcm) return Decoder::Error;
+    const bool indexed = (internals->index.offsets != NULL);
+    const unsigned int duration = internals->index.numFrames * internals->index.samplesPerFrame;
+    unsigned int decoded = 0;
+    bool reopened = false;
+
+    while (decoded < numberOfFrames) {
+        if (internals->pcmStart >= internals->pcmEnd) {
+            if (indexed && (internals->decoderPosition >= duration)) break;
+            const int result = internals->decoder->decodeAudio(internals->pcm, internals->framesPerChunk);
+            if (result <= 0) {
+                // The end of the window, continue with the next one.
+                if (indexed && (result == Decoder::EndOfFile) && !reopened && (openAt(internals, internals->decoderPosition + internals->discard) == Decoder::OpenSuccess)) {
+                    reopened = true;
+                    continue;
+                }
+                if (decoded) break;
+                return result;
+            }
+            reopened = false;
+            internals->decoderPosition += (unsigned int)result;
+            if (internals->discard >= (unsigned int)result) {
+                internals->discard -= (unsigned int)result;
+                continue;
+            }
+            internals->pcmStart = internals->discard;
+            internals->pcmEnd = (unsigned int)result;
+            internals->discard = 0;
+        }
+        unsigned int frames = internals->pcmEnd - internals->pcmStart;
+        if (frames > numberOfFrames - decoded) frames = numberOfFrames - decoded;
+        memcpy(output + (size_t)decoded * 2, internals->pcm + internals->pcmStart * 2, (size_t)frames * 4);
+        internals->pcmStart += frames;
+        decoded += frames;
+    }
+    internals->position += decoded;
+    return decoded ? (int)decoded : Decoder::EndOfFile;
+}
+
+bool IndexedDecoder::setPositionPrecise(int frame) {
+    if (!internals->pcm || (frame < 0)) return false;
+    if (internals->index.offsets) {
+        if ((unsigned int)frame > internals->index.numFrames * internals->index.samplesPerFrame) return false;
+        if (openAt(internals, (unsigned int)frame) != Decoder::OpenSuccess) return false;
+    } else {
+        if (!internals->decoder->setPositionPrecise(frame)) return false;
+        internals->pcmStart = internals->pcmEnd = 0;
+    }
+    internals->position = (unsigned int)frame;
+    return true;
+}
+
+int IndexedDecoder::getPositionFrames() {
+    return (int)internals->position;
+}
+
+int IndexedDecoder::getDurationFrames() {
+    if (internals->index.offsets) return (int)(internals->index.numFrames * internals->index.samplesPerFrame);
+    return internals->decoder ? internals->decoder->getDurationFrames() : 0;
+}
+
+unsigned int IndexedDecoder::getSamplerate() {
+    if (internals->index.offsets) return internals->index.samplerate;
+    return internals->decoder ? internals->decoder->getSamplerate() : 0;
+}
+
+bool IndexedDecoder::isIndexed() {
+    return internals->index.offsets != NULL;
+}
+
+Decoder *IndexedDecoder::getDecoder() {
+    return internals->decoder;
+}
+
+bool IndexedDecoder::createIndex(const char *path, const char *cacheDirectory) {
+    seekIndex index;
+    bool saved;
+    if (!path || !getIndex(path, cacheDirectory, &index, &saved)) return false;
+    free(index.offsets);
+    return saved;
+}
+
+}
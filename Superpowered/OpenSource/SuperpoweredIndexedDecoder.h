@@ -0,0 +1,68 @@
+#ifndef Header_SuperpoweredIndexedDecoder
+#define Header_SuperpoweredIndexedDecoder
+
+namespace Superpowered {
+
+class Decoder;
+struct indexedDecoderInternals;
+
+/// @brief Decoder for long MP3 files (DJ mixes, podcasts) with a persistent seek index. Opening and precise seeking take the same short time anywhere in the file, across app restarts.
+/// Decoder::open() reads the entire file to find the frames of an MP3 file without a seek table. IndexedDecoder does this once, and saves the byte offset of every frame into a sidecar file. The next open() loads the sidecar instead of reading the audio file.
+/// The audio is decoded by a Decoder opened on a window of the file around the current position. The frames needed by the MP3 bit reservoir and the overlap of the previous frame are decoded and discarded before the position.
+/// Decoder doesn't decode frames without main data (digital silence, the padding frame at the end of an encode, Xing/Info tag frames), and adds the overlap of the last frame with main data to the next one, so the window reaches back to the last frame with main data. The output is the same as sequential decoding, unless more than 1024 frames without main data precede the position.
+/// The sidecar (version 1, little endian) is a 64 bytes header: "SPSI" (4 chars), version (uint32), size of the audio file (uint64), modification time of the audio file (int64, seconds), samplerate (uint32), samples per frame (uint32), number of frames (uint32), byte offset of the first frame (uint32), 24 bytes reserved (zeros), followed by the size of every frame in bytes (uint16). It is rebuilt when the audio file changes.
+/// Local MPEG-1/2/2.5 Layer III files smaller than 2 GB are indexed. Other formats and network streams are decoded by a Decoder opened on the entire file, without an index.
+/// The methods may block and allocate, do not call them in the audio processing thread. One instance can not be used on multiple threads concurrently.
+class IndexedDecoder {
+public:
+/// @brief Constructor.
+/// @param cacheDirectory The directory to save the sidecar files to, named by a hash of the audio file path. NULL saves the sidecar next to the audio file, with ".spsi" appended to the file name.
+    IndexedDecoder(const char *cacheDirectory = 0);
+    ~IndexedDecoder();
+
+/// @brief Opens a file. Loads the seek index of an MP3 file from the sidecar, or creates the index and saves the sidecar if it is missing or outdated. If the sidecar can not be saved, the index is used for this instance only.
+/// @return Returns with Decoder::OpenSuccess or the return value of Decoder::open().
+/// @param path Full file system path or progressive download path (http or https).
+    int open(const char *path);
+
+/// @brief Decodes the next frames.
+/// @return Returns with the number of frames decoded (less than numberOfFrames at the end of the file), Decoder::EndOfFile, or the negative return value of Decoder::decodeAudio() (Decoder::BufferingTryAgainLater, Decoder::NetworkError or Decoder::Error).
+/// @param output Pointer to allocated memory. 16-bit stereo interleaved output, numberOfFrames * 4 bytes big.
+/// @param numberOfFrames The number of frames to decode.
+    int decodeAudio(short int *output, unsigned int numberOfFrames);
+
+/// @brief Jumps to a specific position, precisely.
+/// @return Returns with true if successful, false if frame is beyond the end of the file or the file can not be opened.
+/// @param frame The position in frames.
+    bool setPositionPrecise(int frame);
+
+/// @return Returns with the current position in frames.
+    int getPositionFrames();
+
+/// @return Returns with the duration of the current file in frames.
+    int getDurationFrames();
+
+/// @return Returns with the sample rate of the current file.
+    unsigned int getSamplerate();
+
+/// @return Returns with true if the current file is decoded with a seek index.
+    bool isIndexed();
+
+/// @return Returns with the Decoder in use. It is opened on a window of an indexed file, the metadata (ID3 tags) of indexed files is not available. Don't delete it, and don't decode or seek with it.
+    Decoder *getDecoder();
+
+/// @brief Creates and saves the seek index of an MP3 file if the sidecar is missing or outdated, for example on a background thread after importing a file.
+/// @return Returns with true if a valid sidecar exists.
+/// @param path Full file system path.
+/// @param cacheDirectory The directory to save the sidecar file to, see the constructor.
+    static bool createIndex(const char *path, const char *cacheDirectory = 0);
+
+private:
+    indexedDecoderInternals *internals;
+    IndexedDecoder(const IndexedDecoder&);
+    IndexedDecoder& operator=(const IndexedDecoder&);
+};
+
+}
+
+#endif
@@ -0,0 +1,217 @@
+#include "SuperpoweredLargeFFT.h"
+#include "SuperpoweredFFT.h"
+#include "SuperpoweredRealFFTSplit.h"
+#include <math.h>
+#include <stdlib.h>
+
+namespace Superpowered {
+
+static const unsigned int minimumLogSize = 4, maximumLogSize = 20, maximumDirectComplexLogSize = 12, maximumDirectRealLogSize = 13;
+static const unsigned int blockSize = 16; // Columns (or rows) processed together. 16 floats are a 64-byte cache line.
+static const unsigned int padding = 16;   // The strides of the work buffers are padded by a cache line, so their rows don't map to the same cache set.
+
+// Two-level twiddle table for e^(i * 2 * pi * j / size): coarse[j >> shift] * fine[j & mask]. Only about 2 * sqrt(size) values, instead of size.
+struct twiddleTable {
+    float *coarseReal, *coarseImag, *fineReal, *fineImag;
+    unsigned int shift, mask;
+};
+
+struct largeFFTInternals {
+    twiddleTable table; // For the full size. Half-sized transforms use every second value.
+    double *columnStepReal, *columnStepImag; // e^(i * 2 * pi * n / size) for the first 2 * columns values, the twiddle steps of the column pass.
+    float *workReal, *workImag;   // The output of the column pass, rows x (columns + padding).
+    float *blockReal, *blockImag; // blockSize columns, (rows + padding) each.
+    unsigned int logSize;
+};
+
+static void createTable(twiddleTable *t, unsigned int logSize) {
+    t->shift = (logSize + 1) / 2;
+    t->mask = (1u << t->shift) - 1;
+    const unsigned int fineSize = 1u << t->shift, coarseSize = 1u << (logSize - t->shift);
+    const double step = 2.0 * M_PI / double(1u << logSize);
+    t->fineReal = new float[fineSize];
+    t->fineImag = new float[fineSize];
+    t->coarseReal = new float[coarseSize];
+    t->coarseImag = new float[coarseSize];
+    for (unsigned int n = 0; n < fineSize; n++) {
+        t->fineReal[n] = (float)cos(step * double(n));
+        t->fineImag[n] = (float)sin(step * double(n));
+    }
+    for (unsigned int n = 0; n < coarseSize; n++) {
+        t->coarseReal[n] = (float)cos(step * double(n << t->shift));
+        t->coarseImag[n] = (float)sin(step * double(n << t->shift));
+    }
+}
+
+static void destroyTable(twiddleTable *t) {
+    delete[] t->fineReal;
+    delete[] t->fineImag;
+    delete[] t->coarseReal;
+    delete[] t->coarseImag;
+}
+
+static inline void twiddle(const twiddleTable *t, unsigned int j, float *c, float *s) {
+    const unsigned int coarse = j >> t->shift, fine = j & t->mask;
+    *c = t->coarseReal[coarse] * t->fineReal[fine] - t->coarseImag[coarse] * t->fineImag[fine];
+    *s = t->coarseReal[coarse] * t->fineImag[fine] + t->coarseImag[coarse] * t->fineReal[fine];
+}
+
+// The twiddle source of RealFFTSplit.
+struct tableTwiddles {
+    const twiddleTable *table;
+    tableTwiddles(const twiddleTable *t) : table(t) {}
+    inline void get(unsigned int k, float &c, float &s) const { twiddle(table, k, &c, &s); }
+};
+
+// Complex FFT of 2^logSize points as a rows x columns matrix, input index n1 + columns * n2, output index k2 + rows * k1.
+// Column pass: FFT of every column (over n2), multiplied by the twiddle e^(-/+ i * 2 * pi * n1 * k2 / size), transposed into the work buffer.
+// Row pass: FFT of every row of the work buffer (over n1), transposed back to the input.
+// tableShift selects every (1 << tableShift)-th twiddle, for the half-sized transform of the real FFT.
+static void fourStep(largeFFTInternals *internals, float *real, float *imag, unsigned int logSize, unsigned int tableShift, bool forward) {
+    const unsigned int logColumns = (logSize + 1) / 2, logRows = logSize - logColumns, columns = 1u << logColumns, rows = 1u << logRows, workStride = columns + padding, blockStride = rows + padding;
+    const double sign = forward ? -1.0 : 1.0;
+    float *workReal = internals->workReal, *workImag = internals->workImag, *blockReal = internals->blockReal, *blockImag = internals->blockImag;
+
+    for (unsigned int column = 0; column < columns; column += blockSize) {
+        // Gather blockSize columns. Every row contributes one cache line.
+        for (unsigned int row = 0; row < rows; row++) {
+            const float *r = real + row * columns + column, *i = imag + row * columns + column;
+            for (unsigned int b = 0; b < blockSize; b++) {
+                blockReal[b * blockStride + row] = r[b];
+                blockImag[b * blockStride + row] = i[b];
+            }
+        }
+
+        // Column FFTs, then the twiddles e^(-/+ i * 2 * pi * n1 * k2 / size) are applied while scattering into the work buffer (transposed, one cache line per row again).
+        // The twiddles of every column are a double precision recurrence, vectorized over the columns of the block.
+        double twiddleReal[blockSize], twiddleImag[blockSize], stepReal[blockSize], stepImag[blockSize];
+        for (unsigned int b = 0; b < blockSize; b++) {
+            FFTComplex(blockReal + b * blockStride, blockImag + b * blockStride, (int)logRows, forward);
+            twiddleReal[b] = 1.0;
+            twiddleImag[b] = 0.0;
+            stepReal[b] = internals->columnStepReal[(column + b) << tableShift];
+            stepImag[b] = internals->columnStepImag[(column + b) << tableShift] * sign;
+        }
+        for (unsigned int k2 = 0; k2 < rows; k2++) {
+            float *r = workReal + k2 * workStride + column, *i = workImag + k2 * workStride + column;
+            for (unsigned int b = 0; b < blockSize; b++) {
+                const float re = blockReal[b * blockStride + k2], im = blockImag[b * blockStride + k2], c = (float)twiddleReal[b], s = (float)twiddleImag[b];
+                r[b] = re * c - im * s;
+                i[b] = re * s + im * c;
+                const double next = twiddleReal[b] * stepReal[b] - twiddleImag[b] * stepImag[b];
+                twiddleImag[b] = twiddleReal[b] * stepImag[b] + twiddleImag[b] * stepReal[b];
+                twiddleReal[b] = next;
+            }
+        }
+    }
+
+    for (unsigned int row = 0; row < rows; row += blockSize) {
+        for (unsigned int b = 0; b < blockSize; b++) FFTComplex(workReal + (row + b) * workStride, workImag + (row + b) * workStride, (int)logColumns, forward);
+        for (unsigned int k1 = 0; k1 < columns; k1++) {
+            float *r = real + k1 * rows + row, *i = imag + k1 * rows + row;
+            for (unsigned int b = 0; b < blockSize; b++) {
+                r[b] = workReal[(row + b) * workStride + k1];
+                i[b] = workImag[(row + b) * workStride + k1];
+            }
+        }
+    }
+}
+
+LargeFFT::LargeFFT(unsigned int logSize) {
+    if (logSize < minimumLogSize) logSize = minimumLogSize; else if (logSize > maximumLogSize) logSize = maximumLogSize;
+    internals = new largeFFTInternals;
+    internals->logSize = logSize;
+    createTable(&internals->table, logSize);
+
+    if (logSize > maximumDirectComplexLogSize) {
+        const unsigned int size = 1u << logSize, maximumRows = 1u << (logSize / 2), maximumColumns = 1u << ((logSize + 1) / 2);
+        internals->workReal = new float[maximumRows * (maximumColumns + padding)];
+        internals->workImag = new float[maximumRows * (maximumColumns + padding)];
+        internals->blockReal = new float[blockSize * (maximumRows + padding)];
+        internals->blockImag = new float[blockSize * (maximumRows + padding)];
+        const unsigned int numSteps = 2u << ((logSize + 1) / 2);
+        internals->columnStepReal = new double[numSteps];
+        internals->columnStepImag = new double[numSteps];
+        for (unsigned int n = 0; n < numSteps; n++) {
+            internals->columnStepReal[n] = cos(2.0 * M_PI * double(n) / double(size));
+            internals->columnStepImag[n] = sin(2.0 * M_PI * double(n) / double(size));
+        }
+    } else {
+        internals->workReal = internals->workImag = internals->blockReal = internals->blockImag = NULL;
+        internals->columnStepReal = internals->columnStepImag = NULL;
+    }
+}
+
+LargeFFT::~LargeFFT() {
+    destroyTable(&internals->table);
+    delete[] internals->workReal;
+    delete[] internals->workImag;
+    delete[] internals->blockReal;
+    delete[] internals->blockImag;
+    delete[] internals->columnStepReal;
+    delete[] internals->columnStepImag;
+    delete internals;
+}
+
+unsigned int LargeFFT::getSize() {
+    return 1u << internals->logSize;
+}
+
+unsigned int LargeFFT::getLogSize() {
+    return internals->logSize;
+}
+
+void LargeFFT::complexFFT(float *real, float *imag, bool forward) {
+    if (internals->logSize <= maximumDirectComplexLogSize) FFTComplex(real, imag, (int)internals->logSize, forward);
+    else fourStep(internals, real, imag, internals->logSize, 0, forward);
+}
+
+// The real FFT of size points is a complex FFT of size / 2 points with the split step of SuperpoweredRealFFTSplit.h.
+void LargeFFT::realFFT(float *real, float *imag, bool forward) {
+    const unsigned int logSize = internals->logSize;
+    if (logSize <= maximumDirectRealLogSize) {
+        FFTReal(real, imag, (int)logSize, forward);
+        return;
+    }
+    const unsigned int half = 1u << (logSize - 1);
+    const tableTwiddles twiddles(&internals->table);
+
+    if (forward) {
+        fourStep(internals, real, imag, logSize - 1, 1, true);
+        RealFFTSplit::forward(real, imag, half, twiddles);
+    } else {
+        RealFFTSplit::inverse(real, imag, half, twiddles);
+        fourStep(internals, real, imag, logSize - 1, 1, false);
+    }
+}
+
+void LargeFFT::polarFFT(float *mag, float *phase, bool forward, float valueOfPi) {
+    const unsigned int logSize = internals->logSize;
+    if (logSize <= maximumDirectRealLogSize) {
+        PolarFFT(mag, phase, (int)logSize, forward, valueOfPi);
+        return;
+    }
+    const unsigned int half = 1u << (logSize - 1);
+
+    if (forward) {
+        realFFT(mag, phase, true);
+        const float phaseMul = (valueOfPi == 0) ? 1.0f : valueOfPi / float(M_PI);
+        mag[0] = phase[0] = 0;
+        for (unsigned int n = 1; n < half; n++) {
+            const float r = mag[n], i = phase[n];
+            mag[n] = sqrtf(r * r + i * i);
+            phase[n] = atan2f(i, r) * phaseMul;
+        }
+    } else {
+        const float phaseMul = (valueOfPi == 0) ? 1.0f : float(M_PI) / valueOfPi;
+        mag[0] = phase[0] = 0; // Clears the DC offset (and the Nyquist bin).
+        for (unsigned int n = 1; n < half; n++) {
+            const float m = mag[n], p = phase[n] * phaseMul;
+            mag[n] = m * cosf(p);
+            phase[n] = m * sinf(p);
+        }
+        realFFT(mag, phase, false);
+    }
+}
+
+}
@@ -0,0 +1,53 @@
+#ifndef Header_SuperpoweredLargeFFT
+#define Header_SuperpoweredLargeFFT
+
+namespace Superpowered {
+
+struct largeFFTInternals;
+
+/// @brief FFT for large sizes (up to 2^20 points), for offline tasks such as long-window spectral analysis, fast convolution with long impulse responses or cross-correlation.
+/// Data packing, scaling and the results are the same as FFTComplex, FFTReal and PolarFFT in SuperpoweredFFT.h, those are used directly for the sizes they support.
+/// Larger transforms are split into two passes of FFTComplex-sized transforms (four-step/six-step FFT): columns are processed in cache-sized blocks, then the rows, so the working set stays small regardless of the FFT size.
+/// The methods are not allocating and not blocking. One instance can not be used on multiple threads concurrently, as it has an internal work buffer. It will not create any internal threads.
+class LargeFFT {
+public:
+/// @brief Constructor. Allocates the twiddle tables and the work buffer, about 8 * 2^logSize bytes.
+/// @param logSize FFT size is 2^logSize. Limited between 4 and 20 (16 - 1048576 points). The real and polar FFT need logSize 5 or more.
+    LargeFFT(unsigned int logSize);
+    ~LargeFFT();
+
+/// @brief Complex in-place FFT, the same as FFTComplex in SuperpoweredFFT.h.
+/// @param real Pointer to floating point numbers, 2^logSize big. Real part.
+/// @param imag Pointer to floating point numbers, 2^logSize big. Imaginary part.
+/// @param forward Forward or inverse. Not scaled in either direction.
+    void complexFFT(float *real, float *imag, bool forward);
+
+/// @brief Real in-place FFT, the same as FFTReal in SuperpoweredFFT.h.
+/// Data packing is same as Apple's vDSP: the input is split into real (even samples) and imag (odd samples). The output of the forward transform is 2x the DFT, with the Nyquist bin in imag[0]. The inverse transform returns with 2 * 2^logSize times the signal.
+/// @param real Pointer to floating point numbers, 2^logSize / 2 big. Real part.
+/// @param imag Pointer to floating point numbers, 2^logSize / 2 big. Imaginary part.
+/// @param forward Forward or inverse.
+    void realFFT(float *real, float *imag, bool forward);
+
+/// @brief Polar FFT, the same as PolarFFT in SuperpoweredFFT.h.
+/// @param mag Pointer to floating point numbers, 2^logSize / 2 big. Input: split real part. Output: magnitudes.
+/// @param phase Pointer to floating point numbers, 2^logSize / 2 big. Input: split real part. Output: phases.
+/// @param forward Forward or inverse. Inverse PolarFFT will clear (zero) the DC offset.
+/// @param valueOfPi The function can translate pi to any value (Google: the tau manifesto). Use 0 for M_PI.
+    void polarFFT(float *mag, float *phase, bool forward, float valueOfPi = 0);
+
+/// @return Returns with the FFT size (2^logSize).
+    unsigned int getSize();
+
+/// @return Returns with the log2 of the FFT size.
+    unsigned int getLogSize();
+
+private:
+    largeFFTInternals *internals;
+    LargeFFT(const LargeFFT&);
+    LargeFFT& operator=(const LargeFFT&);
+};
+
+}
+
+#endif
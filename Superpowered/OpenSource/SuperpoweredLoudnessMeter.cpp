@@ -0,0 +1,198 @@
+#include "SuperpoweredLoudnessMeter.h"
+#include "SuperpoweredSIMD.h"
+#include <math.h>
+#include <string.h>
+
+namespace Superpowered {
+
+// Block loudness histograms from the absolute gate (-70 LUFS) to +5 LUFS with 0.1 LU bins. Louder blocks go to the last bin.
+static const int histogramBins = 750;
+static const float histogramMinimum = -70.0f, histogramResolution = 10.0f; // Bins per LU.
+static const unsigned int subBlocksMomentary = 4, subBlocksShortTerm = 30; // 400 ms and 3 s in 100 ms steps.
+
+typedef struct loudnessHistogram {
+    double energy[histogramBins];
+    unsigned int count[histogramBins];
+    double totalEnergy;
+    unsigned int totalCount;
+} loudnessHistogram;
+
+struct loudnessMeterInternals {
+    loudnessHistogram momentary, shortTerm;
+    double subBlocks[subBlocksShortTerm]; // Ring of weighted mean square values of the last 100 ms sub-blocks.
+    float coefficients[10];
+    float *state, *sumOfSquares, *weights;
+    unsigned int numChannels, samplerate, subBlockFrames, framesInSubBlock, completedSubBlocks;
+};
+
+static inline float energyToLUFS(double energy) {
+    return (energy > 0) ? float(-0.691 + 10.0 * log10(energy)) : -INFINITY;
+}
+
+// K-weighting (BS.1770 pre-filter and RLB filter) redesigned for any sample rate with the bilinear transform.
+static void designKWeighting(float *coefficients, unsigned int samplerate) {
+    double f0 = 1681.974450955533, Q = 0.7071752369554196, K = tan(M_PI * f0 / double(samplerate));
+    const double Vh = pow(10.0, 3.999843853973347 / 20.0), Vb = pow(Vh, 0.4996667741545416);
+    double a0 = 1.0 + K / Q + K * K;
+    coefficients[0] = float((Vh + Vb * K / Q + K * K) / a0);
+    coefficients[1] = float(2.0 * (K * K - Vh) / a0);
+    coefficients[2] = float((Vh - Vb * K / Q + K * K) / a0);
+    coefficients[3] = float(2.0 * (K * K - 1.0) / a0);
+    coefficients[4] = float((1.0 - K / Q + K * K) / a0);
+
+    f0 = 38.13547087602444;
+    Q = 0.5003270373238773;
+    K = tan(M_PI * f0 / double(samplerate));
+    a0 = 1.0 + K / Q + K * K;
+    coefficients[5] = 1.0f;
+    coefficients[6] = -2.0f;
+    coefficients[7] = 1.0f;
+    coefficients[8] = float(2.0 * (K * K - 1.0) / a0);
+    coefficients[9] = float((1.0 - K / Q + K * K) / a0);
+}
+
+static void addToHistogram(loudnessHistogram *histogram, double energy, float lufs) {
+    if (lufs <= histogramMinimum) return; // Absolute gate.
+    int bin = int((lufs - histogramMinimum) * histogramResolution);
+    if (bin >= histogramBins) bin = histogramBins - 1;
+    histogram->energy[bin] += energy;
+    histogram->count[bin]++;
+    histogram->totalEnergy += energy;
+    histogram->totalCount++;
+}
+
+// The first bin at or above the relative gate.
+static int relativeGateBin(loudnessHistogram *histogram, float gateLU) {
+    const float gate = energyToLUFS(histogram->totalEnergy / double(histogram->totalCount)) + gateLU;
+    const int bin = (int)ceilf((gate - histogramMinimum) * histogramResolution);
+    return bin < 0 ? 0 : bin;
+}
+
+// BS.1770-4 integrated loudness: the mean of the blocks above the absolute gate and the relative gate (-10 LU).
+static float integratedLoudness(loudnessHistogram *histogram) {
+    if (!histogram->totalCount) return -INFINITY;
+    double energy = 0;
+    unsigned int count = 0;
+    for (int bin = relativeGateBin(histogram, -10.0f); bin < histogramBins; bin++) {
+        energy += histogram->energy[bin];
+        count += histogram->count[bin];
+    }
+    return count ? energyToLUFS(energy / double(count)) : -INFINITY;
+}
+
+// EBU Tech 3342 loudness range: the distance between the 10th and 95th percentiles of the short-term loudness values above the relative gate (-20 LU).
+static float loudnessRange(loudnessHistogram *histogram) {
+    if (!histogram->totalCount) return 0;
+    const int first = relativeGateBin(histogram, -20.0f);
+    unsigned int count = 0;
+    for (int bin = first; bin < histogramBins; bin++) count += histogram->count[bin];
+    if (!count) return 0;
+
+    const double low = double(count) * 0.1, high = double(count) * 0.95;
+    int lowBin = -1, highBin = -1;
+    unsigned int cumulative = 0;
+    for (int bin = first; bin < histogramBins; bin++) {
+        cumulative += histogram->count[bin];
+        if ((lowBin < 0) && (double(cumulative) > low)) lowBin = bin;
+        if (double(cumulative) >= high) {
+            highBin = bin;
+            break;
+        }
+    }
+    if (lowBin < 0) lowBin = first;
+    if (highBin < lowBin) highBin = lowBin;
+    return float(highBin - lowBin) / histogramResolution;
+}
+
+static double subBlockMean(loudnessMeterInternals *internals, unsigned int numSubBlocks) {
+    double sum = 0;
+    for (unsigned int n = 0; n < numSubBlocks; n++) sum += internals->subBlocks[(internals->completedSubBlocks - 1 - n) % subBlocksShortTerm];
+    return sum / double(numSubBlocks);
+}
+
+LoudnessMeter::LoudnessMeter(unsigned int samplerate, unsigned int numChannels) {
+    internals = new loudnessMeterInternals;
+    internals->numChannels = numChannels ? numChannels : 1;
+    internals->state = new float[internals->numChannels * 4];
+    internals->sumOfSquares = new float[internals->numChannels];
+    internals->weights = new float[internals->numChannels];
+    for (unsigned int ch = 0; ch < internals->numChannels; ch++) internals->weights[ch] = 1.0f;
+    if (internals->numChannels == 6) {
+        internals->weights[3] = 0.0f;
+        internals->weights[4] = internals->weights[5] = 1.41f;
+    }
+    setSamplerate(samplerate);
+}
+
+LoudnessMeter::~LoudnessMeter() {
+    delete[] internals->state;
+    delete[] internals->sumOfSquares;
+    delete[] internals->weights;
+    delete internals;
+}
+
+void LoudnessMeter::setChannelWeight(unsigned int channel, float weight) {
+    if (channel < internals->numChannels) internals->weights[channel] = weight;
+}
+
+void LoudnessMeter::setSamplerate(unsigned int samplerate) {
+    internals->samplerate = samplerate ? samplerate : 44100;
+    designKWeighting(internals->coefficients, internals->samplerate);
+    internals->subBlockFrames = (internals->samplerate + 5) / 10;
+    reset();
+}
+
+void LoudnessMeter::reset() {
+    memset(&internals->momentary, 0, sizeof(loudnessHistogram));
+    memset(&internals->shortTerm, 0, sizeof(loudnessHistogram));
+    memset(internals->state, 0, internals->numChannels * 4 * sizeof(float));
+    memset(internals->sumOfSquares, 0, internals->numChannels * sizeof(float));
+    internals->framesInSubBlock = internals->completedSubBlocks = 0;
+    momentaryLUFS = shortTermLUFS = integratedLUFS = maxMomentaryLUFS = maxShortTermLUFS = -INFINITY;
+    loudnessRangeLU = 0;
+}
+
+void LoudnessMeter::process(float *input, unsigned int numberOfFrames) {
+    const unsigned int numChannels = internals->numChannels;
+
+    while (numberOfFrames > 0) {
+        unsigned int frames = internals->subBlockFrames - internals->framesInSubBlock;
+        if (frames > numberOfFrames) frames = numberOfFrames;
+        SIMD::Biquad2SumOfSquares(input, frames, numChannels, internals->coefficients, internals->state, internals->sumOfSquares);
+        input += frames * numChannels;
+        numberOfFrames -= frames;
+        internals->framesInSubBlock += frames;
+        if (internals->framesInSubBlock < internals->subBlockFrames) break;
+
+        // A 100 ms sub-block is complete.
+        double energy = 0;
+        for (unsigned int ch = 0; ch < numChannels; ch++) {
+            energy += double(internals->weights[ch]) * double(internals->sumOfSquares[ch]);
+            internals->sumOfSquares[ch] = 0;
+        }
+        for (unsigned int n = 0; n < numChannels * 4; n++) if (fabsf(internals->state[n]) < 1e-15f) internals->state[n] = 0; // No denormals in silence.
+        internals->subBlocks[internals->completedSubBlocks % subBlocksShortTerm] = energy / double(internals->subBlockFrames);
+        internals->completedSubBlocks++;
+        internals->framesInSubBlock = 0;
+
+        // Gating blocks are 400 ms long with 75% overlap, short-term values are updated with the same 100 ms steps.
+        if (internals->completedSubBlocks >= subBlocksMomentary) {
+            const double e = subBlockMean(internals, subBlocksMomentary);
+            const float lufs = energyToLUFS(e);
+            momentaryLUFS = lufs;
+            if (lufs > maxMomentaryLUFS) maxMomentaryLUFS = lufs;
+            addToHistogram(&internals->momentary, e, lufs);
+            integratedLUFS = integratedLoudness(&internals->momentary);
+        }
+        if (internals->completedSubBlocks >= subBlocksShortTerm) {
+            const double e = subBlockMean(internals, subBlocksShortTerm);
+            const float lufs = energyToLUFS(e);
+            shortTermLUFS = lufs;
+            if (lufs > maxShortTermLUFS) maxShortTermLUFS = lufs;
+            addToHistogram(&internals->shortTerm, e, lufs);
+            loudnessRangeLU = loudnessRange(&internals->shortTerm);
+        }
+    }
+}
+
+}
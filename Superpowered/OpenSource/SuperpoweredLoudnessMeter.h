@@ -0,0 +1,52 @@
+#ifndef Header_SuperpoweredLoudnessMeter
+#define Header_SuperpoweredLoudnessMeter
+
+namespace Superpowered {
+
+struct loudnessMeterInternals;
+
+/// @brief Real-time loudness meter according to ITU-R BS.1770-4 and EBU R128 (EBU Tech 3341 and 3342).
+/// Measures K-weighted momentary (400 ms), short-term (3 s) and gated integrated loudness, and the loudness range (LRA).
+/// process() is not allocating and not blocking, so the meter can run in the audio processing callback, fed with the same buffers as the effects. The results are updated every 100 ms and can be read on any thread.
+/// Gating uses histograms with 0.1 LU resolution, so the memory doesn't grow with the length of the measurement.
+class LoudnessMeter {
+public:
+    float momentaryLUFS;    ///< Momentary loudness (last 400 ms) in LUFS. -INFINITY for silence or before the first 400 ms.
+    float shortTermLUFS;    ///< Short-term loudness (last 3 seconds) in LUFS. -INFINITY for silence or before the first 3 seconds.
+    float integratedLUFS;   ///< Integrated (gated) loudness since reset() in LUFS. -INFINITY if no audio is above the absolute gate of -70 LUFS.
+    float loudnessRangeLU;  ///< Loudness range (LRA) since reset() in LU.
+    float maxMomentaryLUFS; ///< The highest momentary loudness since reset() in LUFS.
+    float maxShortTermLUFS; ///< The highest short-term loudness since reset() in LUFS.
+
+/// @brief Constructor.
+/// @param samplerate The sample rate of the audio in Hz.
+/// @param numChannels The number of channels in the interleaved input. Every channel weight is 1, except if numChannels is 6: ITU-R BS.775 5.1 order (L, R, C, LFE, Ls, Rs) is assumed, LFE is excluded and the surround channels are weighted with +1.5 dB.
+    LoudnessMeter(unsigned int samplerate, unsigned int numChannels = 2);
+    ~LoudnessMeter();
+
+/// @brief Sets the weight of a channel in the sum of the channel powers. For example 1.41 (+1.5 dB) for surround channels, 0 to exclude a channel.
+/// @param channel The index of the channel.
+/// @param weight The weight.
+    void setChannelWeight(unsigned int channel, float weight);
+
+/// @brief Measures audio. Real-time safe.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input with numChannels channels.
+/// @param numberOfFrames The number of frames to process. Any number is accepted.
+    void process(float *input, unsigned int numberOfFrames);
+
+/// @brief Starts a new measurement. Doesn't change the sample rate and the channel weights. Don't call it concurrently with process().
+    void reset();
+
+/// @brief Changes the sample rate and starts a new measurement. Don't call it concurrently with process().
+/// @param samplerate The sample rate of the audio in Hz.
+    void setSamplerate(unsigned int samplerate);
+
+private:
+    loudnessMeterInternals *internals;
+    LoudnessMeter(const LoudnessMeter&);
+    LoudnessMeter& operator=(const LoudnessMeter&);
+};
+
+}
+
+#endif
@@ -0,0 +1,141 @@
+#include "SuperpoweredMixedRadixFFT.h"
+#include "SuperpoweredSIMD.h"
+#include "SuperpoweredRealFFTSplit.h"
+#include <math.h>
+#include <string.h>
+
+namespace Superpowered {
+
+static const unsigned int minimumSize = 2, maximumSize = 1u << 20, maximumStages = 20;
+
+// The stages of one transform size. Radix 4 is used for every pair of 2s.
+struct mixedRadixPlan {
+    float *twiddles[maximumStages]; // cos and sin of 2 * pi * k * p / n for every stage, see SIMD::FFTMixedRadixStage.
+    unsigned int radix[maximumStages], numStages, size;
+};
+
+struct mixedRadixFFTInternals {
+    mixedRadixPlan complexPlan, halfPlan; // For the complex FFT and the half-size complex FFT of the real FFT.
+    float *splitTwiddles; // cos and sin of 2 * pi * k / size for the split step of the real FFT.
+    float *workReal, *workImag;
+    unsigned int size;
+};
+
+static bool isSupported(unsigned int size) {
+    static const unsigned int primes[4] = { 2, 3, 5, 7 };
+    for (int n = 0; n < 4; n++) while ((size % primes[n]) == 0) size /= primes[n];
+    return size == 1;
+}
+
+// The radices in descending order, so the stride grows quickly and more stages run on full vectors.
+static void createPlan(mixedRadixPlan *plan, unsigned int size) {
+    static const unsigned int radices[5] = { 7, 5, 4, 3, 2 };
+    plan->size = size;
+    plan->numStages = 0;
+    unsigned int rest = size;
+    for (int r = 0; r < 5; r++) {
+        while ((rest % radices[r]) == 0) {
+            plan->radix[plan->numStages++] = radices[r];
+            rest /= radices[r];
+        }
+    }
+
+    unsigned int n = size;
+    for (unsigned int stage = 0; stage < plan->numStages; stage++) {
+        const unsigned int radix = plan->radix[stage], m = n / radix;
+        float *t = plan->twiddles[stage] = new float[m * (radix - 1) * 2];
+        for (unsigned int p = 0; p < m; p++) for (unsigned int k = 1; k < radix; k++, t += 2) {
+            const double angle = 2.0 * M_PI * double(k * p) / double(n);
+            t[0] = (float)cos(angle);
+            t[1] = (float)sin(angle);
+        }
+        n = m;
+    }
+}
+
+static void destroyPlan(mixedRadixPlan *plan) {
+    for (unsigned int stage = 0; stage < plan->numStages; stage++) delete[] plan->twiddles[stage];
+}
+
+// The stages alternate between the input and the work buffer.
+static void transform(mixedRadixFFTInternals *internals, const mixedRadixPlan *plan, float *real, float *imag, bool forward) {
+    float *inReal = real, *inImag = imag, *outReal = internals->workReal, *outImag = internals->workImag;
+    unsigned int n = plan->size, stride = 1;
+    for (unsigned int stage = 0; stage < plan->numStages; stage++) {
+        SIMD::FFTMixedRadixStage(inReal, inImag, outReal, outImag, n, stride, plan->radix[stage], plan->twiddles[stage], forward);
+        float *r = inReal, *i = inImag;
+        inReal = outReal;
+        inImag = outImag;
+        outReal = r;
+        outImag = i;
+        n /= plan->radix[stage];
+        stride *= plan->radix[stage];
+    }
+    if (inReal != real) {
+        memcpy(real, inReal, plan->size * sizeof(float));
+        memcpy(imag, inImag, plan->size * sizeof(float));
+    }
+}
+
+unsigned int MixedRadixFFT::nextSupportedSize(unsigned int size) {
+    if (size < minimumSize) return minimumSize;
+    if (size >= maximumSize) return maximumSize;
+    while (!isSupported(size)) size++;
+    return size;
+}
+
+MixedRadixFFT::MixedRadixFFT(unsigned int size) {
+    size = nextSupportedSize(size);
+    internals = new mixedRadixFFTInternals;
+    internals->size = size;
+    createPlan(&internals->complexPlan, size);
+    internals->workReal = new float[size];
+    internals->workImag = new float[size];
+
+    if ((size & 1) == 0) {
+        const unsigned int half = size / 2;
+        createPlan(&internals->halfPlan, half);
+        internals->splitTwiddles = new float[(half / 2 + 1) * 2];
+        for (unsigned int k = 0; k <= half / 2; k++) {
+            internals->splitTwiddles[k * 2] = (float)cos(2.0 * M_PI * double(k) / double(size));
+            internals->splitTwiddles[k * 2 + 1] = (float)sin(2.0 * M_PI * double(k) / double(size));
+        }
+    } else {
+        internals->halfPlan.numStages = 0;
+        internals->splitTwiddles = NULL;
+    }
+}
+
+MixedRadixFFT::~MixedRadixFFT() {
+    destroyPlan(&internals->complexPlan);
+    destroyPlan(&internals->halfPlan);
+    delete[] internals->splitTwiddles;
+    delete[] internals->workReal;
+    delete[] internals->workImag;
+    delete internals;
+}
+
+unsigned int MixedRadixFFT::getSize() {
+    return internals->size;
+}
+
+void MixedRadixFFT::complexFFT(float *real, float *imag, bool forward) {
+    transform(internals, &internals->complexPlan, real, imag, forward);
+}
+
+// The real FFT is a complex FFT of size / 2 points (even samples as real, odd samples as imaginary), with the split step of SuperpoweredRealFFTSplit.h.
+void MixedRadixFFT::realFFT(float *real, float *imag, bool forward) {
+    if (!internals->splitTwiddles) return;
+    const unsigned int half = internals->size / 2;
+    const RealFFTSplit::interleavedTwiddles<float> twiddles(internals->splitTwiddles);
+
+    if (forward) {
+        transform(internals, &internals->halfPlan, real, imag, true);
+        RealFFTSplit::forward(real, imag, half, twiddles);
+    } else {
+        RealFFTSplit::inverse(real, imag, half, twiddles);
+        transform(internals, &internals->halfPlan, real, imag, false);
+    }
+}
+
+}
@@ -0,0 +1,47 @@
+#ifndef Header_SuperpoweredMixedRadixFFT
+#define Header_SuperpoweredMixedRadixFFT
+
+namespace Superpowered {
+
+struct mixedRadixFFTInternals;
+
+/// @brief FFT plan for sizes that are not powers of two: any size with no prime factors other than 2, 3, 5 and 7, such as 480 and 960 (10 and 20 ms at 48 kHz), 441 and 882 (10 and 20 ms at 44.1 kHz).
+/// Saves the zero-padding or resampling of audio frames to a power of two size. Data packing and scaling are the same as FFTComplex and FFTReal in SuperpoweredFFT.h.
+/// The twiddles of every stage are precomputed in the constructor. The stages are radix 4, 2, 3, 5 and 7 codelets in SuperpoweredSIMD.h.
+/// The methods are not allocating and not blocking. One instance can not be used on multiple threads concurrently, as it has an internal work buffer. It will not create any internal threads.
+class MixedRadixFFT {
+public:
+/// @brief Constructor. Allocates the twiddle tables and the work buffer, about 32 * size bytes.
+/// @param size FFT size. Limited between 2 and 1048576. Sizes with other prime factors are rounded up to the next supported size, see getSize().
+    MixedRadixFFT(unsigned int size);
+    ~MixedRadixFFT();
+
+/// @brief Complex in-place FFT. The same as FFTComplex in SuperpoweredFFT.h, for the size of this plan.
+/// @param real Pointer to floating point numbers, size big. Real part.
+/// @param imag Pointer to floating point numbers, size big. Imaginary part.
+/// @param forward Forward or inverse. Not scaled in either direction.
+    void complexFFT(float *real, float *imag, bool forward);
+
+/// @brief Real in-place FFT, the same as FFTReal in SuperpoweredFFT.h. Needs an even size, does nothing for odd sizes.
+/// Data packing is same as Apple's vDSP: the input is split into real (even samples) and imag (odd samples). The output of the forward transform is 2x the DFT, with the Nyquist bin in imag[0]. The inverse transform returns with 2 * size times the signal.
+/// @param real Pointer to floating point numbers, size / 2 big. Real part.
+/// @param imag Pointer to floating point numbers, size / 2 big. Imaginary part.
+/// @param forward Forward or inverse.
+    void realFFT(float *real, float *imag, bool forward);
+
+/// @return Returns with the FFT size.
+    unsigned int getSize();
+
+/// @return Returns with the smallest supported FFT size greater than or equal to size.
+/// @param size The minimum size.
+    static unsigned int nextSupportedSize(unsigned int size);
+
+private:
+    mixedRadixFFTInternals *internals;
+    MixedRadixFFT(const MixedRadixFFT&);
+    MixedRadixFFT& operator=(const MixedRadixFFT&);
+};
+
+}
+
+#endif
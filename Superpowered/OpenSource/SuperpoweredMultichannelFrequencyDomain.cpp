@@ -0,0 +1,259 @@
+#include "SuperpoweredMultichannelFrequencyDomain.h"
+#include "SuperpoweredFFT.h"
+#include "SuperpoweredSIMD.h"
+#include "SuperpoweredSharedTables.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <string.h>
+
+namespace Superpowered {
+
+static const unsigned int minimumLogSize = 8, maximumLogSize = 13, maximumThreads = 64;
+
+struct multichannelFrequencyDomainInternals {
+    const float *window; // Periodic Hann, fftSize, shared between instances.
+    float **input;    // Planar input per channel, inputCapacity frames. The frames between inputStart and inputEnd are waiting.
+    float **overlap;  // Overlap-add output per channel, fftSize frames. The first frames are complete after a frequencyDomainToTimeDomain() call.
+    std::thread **threads;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<unsigned int> nextChannel, busy;
+    // The current job.
+    float **magnitudes, **phases;
+    float valueOfPi, synthesisScale;
+    unsigned int generation, numThreads, numChannels, allocatedChannels, fftLogSize, fftSize, step, inputStart, inputEnd, inputCapacity, shift;
+    bool forward, complexMode, quit;
+};
+
+// Windowed input to split real (even samples) and imag (odd samples), then the FFT in place.
+static void forwardChannel(multichannelFrequencyDomainInternals *internals, unsigned int channel) {
+    const float *input = internals->input[channel] + internals->inputStart, *window = internals->window;
+    float *real = internals->magnitudes[channel], *imag = internals->phases[channel];
+    for (unsigned int n = 0; n < internals->fftSize / 2; n++) {
+        real[n] = input[n * 2] * window[n * 2];
+        imag[n] = input[n * 2 + 1] * window[n * 2 + 1];
+    }
+    if (internals->complexMode) FFTReal(real, imag, (int)internals->fftLogSize, true);
+    else PolarFFT(real, imag, (int)internals->fftLogSize, true, internals->valueOfPi);
+}
+
+// Removes the frames returned by the previous call, then overlap-adds the windowed inverse FFT.
+static void inverseChannel(multichannelFrequencyDomainInternals *internals, unsigned int channel) {
+    float *overlap = internals->overlap[channel], *real = internals->magnitudes[channel], *imag = internals->phases[channel];
+    const unsigned int fftSize = internals->fftSize, shift = internals->shift;
+    if (shift) {
+        memmove(overlap, overlap + shift, (fftSize - shift) * sizeof(float));
+        memset(overlap + fftSize - shift, 0, shift * sizeof(float));
+    }
+
+    if (internals->complexMode) FFTReal(real, imag, (int)internals->fftLogSize, false);
+    else PolarFFT(real, imag, (int)internals->fftLogSize, false, internals->valueOfPi);
+    const float *window = internals->window, scale = internals->synthesisScale;
+    for (unsigned int n = 0; n < fftSize / 2; n++) {
+        overlap[n * 2] += real[n] * window[n * 2] * scale;
+        overlap[n * 2 + 1] += imag[n] * window[n * 2 + 1] * scale;
+    }
+}
+
+static void work(multichannelFrequencyDomainInternals *internals) {
+    unsigned int channel;
+    while ((channel = internals->nextChannel.fetch_add(1)) < internals->numChannels) {
+        if (internals->forward) forwardChannel(internals, channel); else inverseChannel(internals, channel);
+    }
+}
+
+static void worker(multichannelFrequencyDomainInternals *internals) {
+    std::unique_lock<std::mutex> lock(internals->mutex);
+    unsigned int generation = 0; // The thread may start after the first job was posted.
+    while (true) {
+        while (!internals->quit && (internals->generation == generation)) internals->condition.wait(lock);
+        if (internals->quit) return;
+        generation = internals->generation;
+        lock.unlock();
+        work(internals);
+        internals->busy.fetch_sub(1);
+        lock.lock();
+    }
+}
+
+// Every channel of the current job, on the calling thread and the workers. Returns when all channels are done.
+static void runJob(multichannelFrequencyDomainInternals *internals) {
+    internals->nextChannel.store(0);
+    if (internals->numThreads) {
+        {
+            std::lock_guard<std::mutex> lock(internals->mutex);
+            internals->busy.store(internals->numThreads);
+            internals->generation++;
+        }
+        internals->condition.notify_all();
+    }
+    work(internals);
+    while (internals->busy.load()) std::this_thread::yield();
+}
+
+static void freeChannels(multichannelFrequencyDomainInternals *internals) {
+    for (unsigned int n = 0; n < internals->allocatedChannels; n++) {
+        delete[] internals->input[n];
+        delete[] internals->overlap[n];
+    }
+    delete[] internals->input;
+    delete[] internals->overlap;
+    internals->input = internals->overlap = NULL;
+    internals->allocatedChannels = 0;
+}
+
+static void allocateChannels(multichannelFrequencyDomainInternals *internals, unsigned int numberOfChannels) {
+    internals->input = new float *[numberOfChannels];
+    internals->overlap = new float *[numberOfChannels];
+    for (unsigned int n = 0; n < numberOfChannels; n++) {
+        internals->input[n] = new float[internals->inputCapacity];
+        internals->overlap[n] = new float[internals->fftSize];
+    }
+    internals->allocatedChannels = numberOfChannels;
+}
+
+MultichannelFrequencyDomain::MultichannelFrequencyDomain(unsigned int numberOfChannels, unsigned int fftLogSize, unsigned int maxOverlap, unsigned int numberOfThreads, unsigned int inputBufferFrames) {
+    if (fftLogSize < minimumLogSize) fftLogSize = minimumLogSize; else if (fftLogSize > maximumLogSize) fftLogSize = maximumLogSize;
+    if (numberOfThreads > maximumThreads) numberOfThreads = maximumThreads;
+    if (numberOfChannels < 1) numberOfChannels = 1;
+    internals = new multichannelFrequencyDomainInternals;
+    internals->fftLogSize = fftLogSize;
+    internals->fftSize = 1u << fftLogSize;
+    internals->step = internals->fftSize / (maxOverlap < 1 ? 1 : (maxOverlap > internals->fftSize ? internals->fftSize : maxOverlap));
+    internals->inputCapacity = internals->fftSize + (inputBufferFrames < internals->step ? internals->step : inputBufferFrames);
+    internals->numChannels = numberOfChannels;
+    internals->allocatedChannels = 0;
+
+    internals->window = SharedTables::acquireHannWindow(internals->fftSize);
+    allocateChannels(internals, numberOfChannels);
+    reset();
+
+    internals->generation = 0;
+    internals->quit = false;
+    internals->busy.store(0);
+    internals->numThreads = numberOfThreads;
+    internals->threads = numberOfThreads ? new std::thread *[numberOfThreads] : NULL;
+    for (unsigned int n = 0; n < numberOfThreads; n++) internals->threads[n] = new std::thread(worker, internals);
+}
+
+MultichannelFrequencyDomain::~MultichannelFrequencyDomain() {
+    {
+        std::lock_guard<std::mutex> lock(internals->mutex);
+        internals->quit = true;
+    }
+    internals->condition.notify_all();
+    for (unsigned int n = 0; n < internals->numThreads; n++) {
+        internals->threads[n]->join();
+        delete internals->threads[n];
+    }
+    delete[] internals->threads;
+    freeChannels(internals);
+    SharedTables::release(internals->window);
+    delete internals;
+}
+
+unsigned int MultichannelFrequencyDomain::getNumberOfInputFramesNeeded() {
+    const unsigned int waiting = internals->inputEnd - internals->inputStart;
+    return (waiting < internals->fftSize) ? internals->fftSize - waiting : 0;
+}
+
+unsigned int MultichannelFrequencyDomain::getMemoryUsage() {
+    return (unsigned int)sizeof(multichannelFrequencyDomainInternals) + internals->numThreads * (unsigned int)(sizeof(std::thread) + sizeof(std::thread *)) + internals->allocatedChannels * ((internals->inputCapacity + internals->fftSize) * (unsigned int)sizeof(float) + 2 * (unsigned int)sizeof(float *));
+}
+
+unsigned int MultichannelFrequencyDomain::getNumberOfChannels() {
+    return internals->numChannels;
+}
+
+void MultichannelFrequencyDomain::setNumberOfChannels(unsigned int numberOfChannels, bool dontFree) {
+    if (numberOfChannels < 1) numberOfChannels = 1;
+    if ((numberOfChannels > internals->allocatedChannels) || ((numberOfChannels < internals->allocatedChannels) && !dontFree)) {
+        freeChannels(internals);
+        allocateChannels(internals, numberOfChannels);
+    }
+    internals->numChannels = numberOfChannels;
+    reset();
+}
+
+void MultichannelFrequencyDomain::reset() {
+    for (unsigned int n = 0; n < internals->allocatedChannels; n++) memset(internals->overlap[n], 0, internals->fftSize * sizeof(float));
+    internals->inputStart = internals->inputEnd = internals->shift = 0;
+}
+
+// Makes room for numberOfFrames more input frames. Moves the waiting frames to the start, and grows the buffers if that's not enough.
+static void prepareInput(multichannelFrequencyDomainInternals *internals, unsigned int numberOfFrames) {
+    if (internals->inputEnd + numberOfFrames <= internals->inputCapacity) return;
+    const unsigned int waiting = internals->inputEnd - internals->inputStart;
+    if (waiting + numberOfFrames > internals->inputCapacity) {
+        const unsigned int capacity = (waiting + numberOfFrames) * 2;
+        for (unsigned int n = 0; n < internals->allocatedChannels; n++) {
+            float *input = new float[capacity];
+            if (n < internals->numChannels) memcpy(input, internals->input[n] + internals->inputStart, waiting * sizeof(float));
+            delete[] internals->input[n];
+            internals->input[n] = input;
+        }
+        internals->inputCapacity = capacity;
+    } else for (unsigned int n = 0; n < internals->numChannels; n++) memmove(internals->input[n], internals->input[n] + internals->inputStart, waiting * sizeof(float));
+    internals->inputStart = 0;
+    internals->inputEnd = waiting;
+}
+
+void MultichannelFrequencyDomain::addInput(float *input, unsigned int numberOfFrames) {
+    if (!input || !numberOfFrames) return;
+    prepareInput(internals, numberOfFrames);
+    const unsigned int numChannels = internals->numChannels, start = internals->inputEnd;
+    if (numChannels == 2) SIMD::DeInterleave(input, internals->input[0] + start, internals->input[1] + start, numberOfFrames);
+    else for (unsigned int c = 0; c < numChannels; c++) {
+        float *channel = internals->input[c] + start;
+        for (unsigned int n = 0; n < numberOfFrames; n++) channel[n] = input[n * numChannels + c];
+    }
+    internals->inputEnd += numberOfFrames;
+}
+
+void MultichannelFrequencyDomain::addInput(float **inputs, unsigned int numberOfFrames) {
+    if (!inputs || !numberOfFrames) return;
+    prepareInput(internals, numberOfFrames);
+    for (unsigned int c = 0; c < internals->numChannels; c++) memcpy(internals->input[c] + internals->inputEnd, inputs[c], numberOfFrames * sizeof(float));
+    internals->inputEnd += numberOfFrames;
+}
+
+bool MultichannelFrequencyDomain::timeDomainToFrequencyDomain(float **magnitudes, float **phases, float valueOfPi, bool complexMode) {
+    if (internals->inputEnd - internals->inputStart < internals->fftSize) return false;
+    internals->magnitudes = magnitudes;
+    internals->phases = phases;
+    internals->valueOfPi = valueOfPi;
+    internals->complexMode = complexMode;
+    internals->forward = true;
+    runJob(internals);
+    return true;
+}
+
+void MultichannelFrequencyDomain::advance(unsigned int numberOfFrames) {
+    if (!numberOfFrames) numberOfFrames = internals->step;
+    const unsigned int waiting = internals->inputEnd - internals->inputStart;
+    internals->inputStart += (numberOfFrames < waiting) ? numberOfFrames : waiting;
+}
+
+void MultichannelFrequencyDomain::frequencyDomainToTimeDomain(float **magnitudes, float **phases, float *output, float valueOfPi, unsigned int incrementFrames, bool complexMode) {
+    const unsigned int fftSize = internals->fftSize, numChannels = internals->numChannels;
+    if (!incrementFrames) incrementFrames = internals->step; else if (incrementFrames > fftSize) incrementFrames = fftSize;
+    internals->magnitudes = magnitudes;
+    internals->phases = phases;
+    internals->valueOfPi = valueOfPi;
+    internals->complexMode = complexMode;
+    internals->forward = false;
+    // The inverse FFT returns with 2 * fftSize times the signal, and the squared Hann window sums to 3 / 8 * fftSize / incrementFrames.
+    internals->synthesisScale = float(double(incrementFrames) / (double(fftSize) * 0.375 * double(fftSize) * 2.0));
+    runJob(internals);
+    internals->shift = incrementFrames;
+
+    if (numChannels == 2) SIMD::Interleave(internals->overlap[0], internals->overlap[1], output, incrementFrames);
+    else for (unsigned int c = 0; c < numChannels; c++) {
+        const float *overlap = internals->overlap[c];
+        for (unsigned int n = 0; n < incrementFrames; n++) output[n * numChannels + c] = overlap[n];
+    }
+}
+
+}
@@ -0,0 +1,85 @@
+#ifndef Header_SuperpoweredMultichannelFrequencyDomain
+#define Header_SuperpoweredMultichannelFrequencyDomain
+
+namespace Superpowered {
+
+struct multichannelFrequencyDomainInternals;
+
+/// @brief FrequencyDomain for any number of channels, such as 16-32 channel spatial recordings. Buffering, windowing and overlap handling work the same as FrequencyDomain, but every channel is transformed in one call.
+/// The per-channel transforms can be spread over a pool of worker threads. The calling thread works too, and the calls return when every channel is done.
+/// The window is Hann on both the analysis and the synthesis side. For overlaps of 4:1 or more (powers of two, so the step is a whole number of frames) the round trip returns the input, except the first [FFT SIZE] frames which fade in. Polar mode loses the DC of every window, as inverse PolarFFT clears it.
+/// How to use:
+/// 1. Audio input using addInput().
+/// 2. Call timeDomainToFrequencyDomain(), if it returns false go back to 1.
+/// 3. The output of timeDomainToFrequencyDomain is frequency domain data of every channel you can work with.
+/// 4. Call advance() (if required).
+/// 5. Call frequencyDomainToTimeDomain() to create time domain audio from frequency domain data.
+class MultichannelFrequencyDomain {
+public:
+/// @brief Constructor.
+/// @param numberOfChannels The number of audio channels, at least 1.
+/// @param fftLogSize FFT log size, between 8 and 13 (FFT 256 - 8192).
+/// @param maxOverlap [Maximum overlap]:1 (default: 4:1).
+/// @param numberOfThreads The number of worker threads in addition to the calling thread. 0 processes every channel in the calling thread.
+/// @param inputBufferFrames The input buffer holds [FFT SIZE] + inputBufferFrames frames per channel (at least [FFT SIZE] / maxOverlap). For a lower memory footprint set it to the number of frames added between two timeDomainToFrequencyDomain() calls, such as the buffer size of the audio callback.
+    MultichannelFrequencyDomain(unsigned int numberOfChannels, unsigned int fftLogSize = 11, unsigned int maxOverlap = 4, unsigned int numberOfThreads = 0, unsigned int inputBufferFrames = 8192);
+    ~MultichannelFrequencyDomain();
+
+/// @return Returns with how many frames of input should be provided to produce some output.
+    unsigned int getNumberOfInputFramesNeeded();
+
+/// @return Returns with the memory used by this instance in bytes. The window is shared with the other instances of the same FFT size and not included, see SharedTables::getMemoryUsage().
+    unsigned int getMemoryUsage();
+
+/// @return Returns with the number of channels.
+    unsigned int getNumberOfChannels();
+
+/// @brief Changes the number of channels. Allocates memory and resets, do not call it concurrently with the other methods.
+/// @param numberOfChannels The number of audio channels, at least 1.
+/// @param dontFree If true, this function will not free up any memory if numberOfChannels is less than before, so no reallocation happens if numberOfChannels needs to be increased later.
+    void setNumberOfChannels(unsigned int numberOfChannels, bool dontFree = false);
+
+/// @brief Add some audio input. The input buffer grows (allocates) if more than [FFT SIZE] + inputBufferFrames frames are waiting.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input with numberOfChannels.
+/// @param numberOfFrames The number of input frames.
+    void addInput(float *input, unsigned int numberOfFrames);
+
+/// @brief Add some audio input. The input buffer grows (allocates) if more than [FFT SIZE] + inputBufferFrames frames are waiting.
+/// @param inputs Pointers to floating point numbers, numberOfChannels of them. 32-bit planar input.
+/// @param numberOfFrames The number of input frames.
+    void addInput(float **inputs, unsigned int numberOfFrames);
+
+/// @brief Converts the audio input (added by addInput()) of every channel to the frequency domain.
+/// Each frequency bin is (samplerate / [FFT SIZE] / 2) wide. The values are the same as PolarFFT or FFTReal returns with for the windowed input.
+/// @return True, if a conversion was possible (enough frames were available).
+/// @param magnitudes Pointers to floating point numbers, numberOfChannels of them. Magnitudes for each frequency bin. Each must be at least [FFT SIZE] / 2 big.
+/// @param phases Pointers to floating point numbers, numberOfChannels of them. Phases for each frequency bin. Each must be at least [FFT SIZE] / 2 big.
+/// @param valueOfPi Pi can be translated to any value (Google: the tau manifesto). Keep it at 0 for M_PI.
+/// @param complexMode If true, then it returns with complex numbers (magnitude: real, phase: imag). Performs polar transform otherwise (the output is magnitudes and phases).
+    bool timeDomainToFrequencyDomain(float **magnitudes, float **phases, float valueOfPi = 0, bool complexMode = false);
+
+/// @brief Advances the input buffer (removes the earliest frames).
+/// @param numberOfFrames For advanced use, if you know how window overlapping works. Use 0 (the default value) otherwise for a [FFT SIZE] / maxOverlap step.
+    void advance(unsigned int numberOfFrames = 0);
+
+/// @brief Converts frequency domain data of every channel to audio output. The contents of magnitudes and phases are destroyed.
+/// @param magnitudes Pointers to floating point numbers, numberOfChannels of them. Magnitudes for each frequency bin. Each must be at least [FFT SIZE] / 2 big.
+/// @param phases Pointers to floating point numbers, numberOfChannels of them. Phases for each frequency bin. Each must be at least [FFT SIZE] / 2 big.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output with numberOfChannels, incrementFrames long.
+/// @param valueOfPi Pi can be translated to any value (Google: the tau manifesto). Leave it at 0 for M_PI.
+/// @param incrementFrames For advanced use, if you know how window overlapping works. Use 0 (the default value) otherwise for a [FFT SIZE] / maxOverlap step.
+/// @param complexMode If true, then the magnitude and phase inputs represent complex numbers (magnitude: real, phase: imag).
+    void frequencyDomainToTimeDomain(float **magnitudes, float **phases, float *output, float valueOfPi = 0, unsigned int incrementFrames = 0, bool complexMode = false);
+
+/// @brief Reset all internals, sets the instance as good as new.
+    void reset();
+
+private:
+    multichannelFrequencyDomainInternals *internals;
+    MultichannelFrequencyDomain(const MultichannelFrequencyDomain&);
+    MultichannelFrequencyDomain& operator=(const MultichannelFrequencyDomain&);
+};
+
+}
+
+#endif
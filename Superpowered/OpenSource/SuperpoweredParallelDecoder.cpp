@@ -0,0 +1,256 @@
+#include "SuperpoweredParallelDecoder.h"
+#include "SuperpoweredDecoder.h"
+#include <thread>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace Superpowered {
+
+static const unsigned int maximumDecoders = 64, minimumDecodeFrames = 1024, minimumRegionFrames = 65536;
+
+// The frames one decoder is responsible for in the current call.
+struct decoderRegion {
+    short int *output;  // decode(): points into the output of the caller. decodeToAudioInMemory(): an AudioInMemory payload.
+    unsigned int startFrame, numberOfFrames, capacity, decoded;
+    int result;
+    bool toEnd;         // Decodes until the end of the file, growing output. The duration of some formats is an estimate until the end is reached.
+};
+
+struct parallelDecoderInternals {
+    Decoder **decoders;
+    short int **pcm;    // decodeAudio() output per decoder, framesPerChunk * 4 + 16384 bytes.
+    decoderRegion *regions;
+    int *openResults;
+    void *memoryTable;  // AudioInMemory main table of the file in memory, shared by every decoder. NULL for files on disk.
+    const char *path;
+    unsigned int numDecoders, framesPerChunk;
+};
+
+// Calls function with the decoder indexes 0 to count - 1, index 0 on the calling thread. Returns when all are done.
+static void forEachDecoder(parallelDecoderInternals *internals, unsigned int count, void (*function)(parallelDecoderInternals *, unsigned int)) {
+    std::thread **threads = (count > 1) ? new std::thread *[count] : NULL;
+    for (unsigned int n = 1; n < count; n++) threads[n] = new std::thread(function, internals, n);
+    function(internals, 0);
+    for (unsigned int n = 1; n < count; n++) {
+        threads[n]->join();
+        delete threads[n];
+    }
+    delete[] threads;
+}
+
+// The main table is [ ..., first buffer table ], the buffer table is [ payload, size, next, reserved ], see AudioInMemory. The retain count is not 0, so the decoders never free it.
+static void freeMemoryTable(parallelDecoderInternals *internals) {
+    if (!internals->memoryTable) return;
+    int64_t *table = (int64_t *)internals->memoryTable, *buffer = (int64_t *)(intptr_t)table[5];
+    if (buffer) {
+        free((void *)(intptr_t)buffer[0]);
+        free(buffer);
+    }
+    free(table);
+    internals->memoryTable = NULL;
+}
+
+// Fresh decoders for the next file. The previous ones may still read the previous file in memory.
+static void closeFile(parallelDecoderInternals *internals) {
+    for (unsigned int n = 0; n < internals->numDecoders; n++) {
+        delete internals->decoders[n];
+        internals->decoders[n] = new Decoder();
+        free(internals->pcm[n]);
+        internals->pcm[n] = NULL;
+    }
+    freeMemoryTable(internals);
+}
+
+ParallelDecoder::ParallelDecoder(unsigned int numberOfDecoders) {
+    if (!numberOfDecoders) numberOfDecoders = std::thread::hardware_concurrency();
+    if (numberOfDecoders < 1) numberOfDecoders = 1; else if (numberOfDecoders > maximumDecoders) numberOfDecoders = maximumDecoders;
+    internals = new parallelDecoderInternals;
+    internals->numDecoders = numberOfDecoders;
+    internals->decoders = new Decoder *[numberOfDecoders];
+    internals->pcm = new short int *[numberOfDecoders];
+    internals->regions = new decoderRegion[numberOfDecoders];
+    internals->openResults = new int[numberOfDecoders];
+    for (unsigned int n = 0; n < numberOfDecoders; n++) {
+        internals->decoders[n] = new Decoder();
+        internals->pcm[n] = NULL;
+    }
+    internals->memoryTable = NULL;
+    internals->path = NULL;
+    internals->framesPerChunk = minimumDecodeFrames;
+}
+
+ParallelDecoder::~ParallelDecoder() {
+    for (unsigned int n = 0; n < internals->numDecoders; n++) {
+        delete internals->decoders[n];
+        free(internals->pcm[n]);
+    }
+    freeMemoryTable(internals);
+    delete[] internals->decoders;
+    delete[] internals->pcm;
+    delete[] internals->regions;
+    delete[] internals->openResults;
+    delete internals;
+}
+
+static void openDecoder(parallelDecoderInternals *internals, unsigned int index) {
+    Decoder *decoder = internals->decoders[index];
+    internals->openResults[index] = internals->memoryTable ? decoder->openMemory(internals->memoryTable) : decoder->open(internals->path);
+}
+
+// Opens every decoder in parallel, then allocates the decodeAudio() buffers.
+static int openDecoders(parallelDecoderInternals *internals) {
+    forEachDecoder(internals, internals->numDecoders, openDecoder);
+    internals->path = NULL;
+    for (unsigned int n = 0; n < internals->numDecoders; n++) if (internals->openResults[n] != Decoder::OpenSuccess) return internals->openResults[n];
+
+    internals->framesPerChunk = internals->decoders[0]->getFramesPerChunk();
+    if (internals->framesPerChunk < minimumDecodeFrames) internals->framesPerChunk = minimumDecodeFrames;
+    for (unsigned int n = 0; n < internals->numDecoders; n++) {
+        internals->pcm[n] = (short int *)malloc(internals->framesPerChunk * 4 + 16384);
+        if (!internals->pcm[n]) return Decoder::OpenError_OutOfMemory;
+    }
+    return Decoder::OpenSuccess;
+}
+
+int ParallelDecoder::open(const char *path) {
+    closeFile(internals);
+    internals->path = path;
+    return openDecoders(internals);
+}
+
+int ParallelDecoder::openAudioFileInMemory(void *pointer, unsigned int sizeBytes) {
+    closeFile(internals);
+    internals->memoryTable = AudioInMemory::create(1, 0, sizeBytes, true);
+    if (!internals->memoryTable) {
+        free(pointer);
+        return Decoder::OpenError_OutOfMemory;
+    }
+    AudioInMemory::append(internals->memoryTable, pointer, sizeBytes);
+    return openDecoders(internals);
+}
+
+unsigned int ParallelDecoder::getNumberOfDecoders() {
+    return internals->numDecoders;
+}
+
+Decoder *ParallelDecoder::getDecoder(unsigned int index) {
+    return (index < internals->numDecoders) ? internals->decoders[index] : NULL;
+}
+
+int ParallelDecoder::getDurationFrames() {
+    return internals->decoders[0]->getDurationFrames();
+}
+
+unsigned int ParallelDecoder::getSamplerate() {
+    return internals->decoders[0]->getSamplerate();
+}
+
+static void decodeRegion(parallelDecoderInternals *internals, unsigned int index) {
+    decoderRegion *region = internals->regions + index;
+    Decoder *decoder = internals->decoders[index];
+    short int *pcm = internals->pcm[index];
+    region->decoded = 0;
+    region->result = Decoder::EndOfFile;
+    if (!pcm) {
+        region->result = Decoder::Error;
+        return;
+    }
+    if ((!region->numberOfFrames && !region->toEnd) || !decoder->setPositionPrecise((int)region->startFrame)) return;
+
+    while (region->toEnd || (region->decoded < region->numberOfFrames)) {
+        const int result = decoder->decodeAudio(pcm, internals->framesPerChunk);
+        if (result <= 0) {
+            region->result = result;
+            break;
+        }
+        unsigned int frames = (unsigned int)result;
+        if (region->toEnd) {
+            if (region->decoded + frames > region->capacity) {
+                const unsigned int capacity = (region->decoded + frames) * 2;
+                short int *output = (short int *)realloc(region->output, (size_t)capacity * 4);
+                if (!output) {
+                    region->result = Decoder::Error;
+                    break;
+                }
+                region->output = output;
+                region->capacity = capacity;
+            }
+        } else if (frames > region->numberOfFrames - region->decoded) frames = region->numberOfFrames - region->decoded;
+        memcpy(region->output + (size_t)region->decoded * 2, pcm, (size_t)frames * 4);
+        region->decoded += frames;
+    }
+}
+
+// Splits numberOfFrames from startFrame to the decoders, at least minimumRegionFrames each, as seeking and priming costs some decoding.
+static unsigned int splitRegions(parallelDecoderInternals *internals, unsigned int startFrame, unsigned int numberOfFrames) {
+    unsigned int numRegions = numberOfFrames / minimumRegionFrames;
+    if (numRegions > internals->numDecoders) numRegions = internals->numDecoders; else if (numRegions < 1) numRegions = 1;
+    const unsigned int regionFrames = numberOfFrames / numRegions;
+    for (unsigned int n = 0; n < internals->numDecoders; n++) {
+        decoderRegion *region = internals->regions + n;
+        region->startFrame = startFrame + n * regionFrames;
+        region->numberOfFrames = (n < numRegions) ? ((n == numRegions - 1) ? numberOfFrames - n * regionFrames : regionFrames) : 0;
+        region->output = NULL;
+        region->capacity = 0;
+        region->toEnd = false;
+    }
+    return numRegions;
+}
+
+int ParallelDecoder::decode(short int *output, unsigned int startFrame, unsigned int numberOfFrames) {
+    if (!output || !numberOfFrames) return 0;
+    const unsigned int numRegions = splitRegions(internals, startFrame, numberOfFrames);
+    for (unsigned int n = 0; n < numRegions; n++) internals->regions[n].output = output + (size_t)(internals->regions[n].startFrame - startFrame) * 2;
+    forEachDecoder(internals, numRegions, decodeRegion);
+
+    // The frames are valid until the first region that ended early.
+    unsigned int decoded = 0;
+    for (unsigned int n = 0; n < numRegions; n++) {
+        const decoderRegion *region = internals->regions + n;
+        if (region->result < Decoder::EndOfFile) return region->decoded ? int(decoded + region->decoded) : (decoded ? int(decoded) : region->result);
+        decoded += region->decoded;
+        if (region->decoded < region->numberOfFrames) break;
+    }
+    return decoded ? int(decoded) : Decoder::EndOfFile;
+}
+
+void *ParallelDecoder::decodeToAudioInMemory() {
+    const int duration = getDurationFrames();
+    const unsigned int samplerate = getSamplerate();
+    // The last region decodes until the end of the file, so an estimated duration doesn't cut the audio.
+    const unsigned int numRegions = splitRegions(internals, 0, (duration > 0) ? (unsigned int)duration : 0);
+    bool ok = true;
+    for (unsigned int n = 0; n < numRegions; n++) {
+        decoderRegion *region = internals->regions + n;
+        region->toEnd = (n == numRegions - 1);
+        region->capacity = region->numberOfFrames + (region->toEnd ? internals->framesPerChunk : 0);
+        region->output = (short int *)malloc((size_t)region->capacity * 4);
+        if (!region->output) ok = false;
+    }
+    if (ok) forEachDecoder(internals, numRegions, decodeRegion);
+
+    // Every region but the last must be complete.
+    unsigned int total = 0;
+    for (unsigned int n = 0; n < numRegions; n++) {
+        const decoderRegion *region = internals->regions + n;
+        if (!region->output || (region->result < Decoder::EndOfFile) || (!region->toEnd && (region->decoded < region->numberOfFrames))) ok = false;
+        total += region->decoded;
+    }
+    void *table = ok ? AudioInMemory::create(0, samplerate, total, false) : NULL;
+    for (unsigned int n = 0; n < numRegions; n++) {
+        decoderRegion *region = internals->regions + n;
+        if (table && region->decoded) AudioInMemory::append(table, region->output, region->decoded); else free(region->output);
+        region->output = NULL;
+    }
+    if (table) AudioInMemory::complete(table);
+    return table;
+}
+
+void *ParallelDecoder::decodeToAudioInMemory(void *pointer, unsigned int sizeBytes, unsigned int numberOfThreads) {
+    ParallelDecoder decoder(numberOfThreads);
+    if (decoder.openAudioFileInMemory(pointer, sizeBytes) != Decoder::OpenSuccess) return NULL;
+    return decoder.decodeToAudioInMemory();
+}
+
+}
@@ -0,0 +1,70 @@
+#ifndef Header_SuperpoweredParallelDecoder
+#define Header_SuperpoweredParallelDecoder
+
+namespace Superpowered {
+
+class Decoder;
+struct parallelDecoderInternals;
+
+/// @brief Decodes one audio file on several threads. Every thread has its own Decoder opened on the same file, and decodes a disjoint range of frames after a precise seek (setPositionPrecise handles the priming of the codec), so the result is the same as sequential decoding.
+/// A file in memory is shared between the decoders without copying, a file on disk is shared by the file system cache.
+/// Useful for loading long audio files (DJ mixes, podcasts) into memory quickly on many-core CPUs. Local files only, network streams are not supported.
+/// The methods are blocking and may allocate, do not call them in the audio processing thread. One instance can not be used on multiple threads concurrently.
+class ParallelDecoder {
+public:
+/// @brief Constructor.
+/// @param numberOfDecoders The number of decoders and threads, including the calling thread. 0 means the number of CPU cores.
+    ParallelDecoder(unsigned int numberOfDecoders = 0);
+    ~ParallelDecoder();
+
+/// @brief Opens a local file with every decoder.
+/// @return Returns with the return value of Decoder::open(), Decoder::OpenSuccess if every decoder opened the file.
+/// @param path Full file system path.
+    int open(const char *path);
+
+/// @brief Opens a file loaded into memory with every decoder, without copying it.
+/// @return Returns with the return value of Decoder::openMemory(), Decoder::OpenSuccess if every decoder opened the file.
+/// @param pointer Pointer to an audio file loaded onto the heap. Should be allocated using malloc(). The ParallelDecoder will take ownership on this data, even if opening fails.
+/// @param sizeBytes The audio file length in bytes.
+    int openAudioFileInMemory(void *pointer, unsigned int sizeBytes);
+
+/// @return Returns with the number of decoders.
+    unsigned int getNumberOfDecoders();
+
+/// @return Returns with one of the decoders, for metadata or sequential decoding. Don't delete it, and don't use it concurrently with decode() or decodeToAudioInMemory().
+/// @param index The index of the decoder, less than getNumberOfDecoders().
+    Decoder *getDecoder(unsigned int index);
+
+/// @return Returns with the duration of the current file in frames, see Decoder::getDurationFrames().
+    int getDurationFrames();
+
+/// @return Returns with the sample rate of the current file.
+    unsigned int getSamplerate();
+
+/// @brief Decodes a range of frames, split between the decoders.
+/// @return Returns with the number of frames decoded (less than numberOfFrames at the end of the file), Decoder::EndOfFile if startFrame is after the end of the file, or Decoder::Error.
+/// @param output Pointer to allocated memory. 16-bit stereo interleaved output, numberOfFrames * 4 bytes big.
+/// @param startFrame The first frame to decode.
+/// @param numberOfFrames The number of frames to decode.
+    int decode(short int *output, unsigned int startFrame, unsigned int numberOfFrames);
+
+/// @brief Decodes the entire file to AudioInMemory format (16-bit stereo PCM), split between the decoders. The output can be loaded by AdvancedAudioPlayer::openMemory().
+/// @return Pointer to the main table (with a retain count of 0, the AdvancedAudioPlayer takes ownership) or NULL on error.
+    void *decodeToAudioInMemory();
+
+/// @brief Parallel version of Decoder::decodeToAudioInMemory(): decodes an entire audio file in memory to AudioInMemory format in a single call. The output can be loaded by the AdvancedAudioPlayer.
+/// @return Pointer or NULL on error.
+/// @param pointer Pointer to an audio file loaded onto the heap. Should be allocated using malloc(). This function will free() this data.
+/// @param sizeBytes The audio file length in bytes.
+/// @param numberOfThreads The number of threads, including the calling thread. 0 means the number of CPU cores.
+    static void *decodeToAudioInMemory(void *pointer, unsigned int sizeBytes, unsigned int numberOfThreads = 0);
+
+private:
+    parallelDecoderInternals *internals;
+    ParallelDecoder(const ParallelDecoder&);
+    ParallelDecoder& operator=(const ParallelDecoder&);
+};
+
+}
+
+#endif
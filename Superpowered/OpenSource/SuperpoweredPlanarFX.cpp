@@ -0,0 +1,53 @@
+#include "SuperpoweredPlanarFX.h"
+
+namespace Superpowered {
+
+struct planarFXInternals {
+    float *buffer; // Interleaved stereo, the effect processes it in-place.
+    unsigned int blockFrames;
+};
+
+PlanarFX::PlanarFX(FX *_fx, unsigned int maximumBlockFrames) : fx(_fx) {
+    internals = new planarFXInternals;
+    internals->blockFrames = maximumBlockFrames ? maximumBlockFrames : 1;
+    internals->buffer = new float[internals->blockFrames * 2];
+}
+
+PlanarFX::~PlanarFX() {
+    delete[] internals->buffer;
+    delete internals;
+}
+
+bool PlanarFX::process(const SIMD::PlanarBuffer &input, const SIMD::PlanarBuffer &output) {
+    float *buffer = internals->buffer;
+    bool audio = false;
+
+    for (unsigned int first = 0; first < output.numberOfFrames; first += internals->blockFrames) {
+        const unsigned int frames = output.numberOfFrames - first < internals->blockFrames ? output.numberOfFrames - first : internals->blockFrames;
+        const SIMD::PlanarBuffer in = input.slice(first, frames), out = output.slice(first, frames);
+
+        if (in.numChannels == 1) {
+            float *mono = in.channel(0);
+            SIMD::Interleave(mono, mono, buffer, frames);
+        } else SIMD::Interleave(in.channel(0), in.channel(1), buffer, frames);
+
+        if (fx->process(buffer, buffer, frames)) {
+            // Silence was returned for the previous blocks, but the output can't be left unchanged anymore.
+            if (!audio && first) for (unsigned int ch = 0; ch < output.numChannels; ch++) {
+                float *o = output.channel(ch);
+                for (unsigned int n = 0; n < first; n++) o[n] = 0;
+            }
+            audio = true;
+            if (out.numChannels == 1) {
+                float *mono = out.channel(0);
+                for (unsigned int n = 0; n < frames; n++) mono[n] = (buffer[n * 2] + buffer[n * 2 + 1]) * 0.5f;
+            } else SIMD::DeInterleave(buffer, out.channel(0), out.channel(1), frames);
+        } else if (audio) for (unsigned int ch = 0; ch < out.numChannels; ch++) {
+            float *o = out.channel(ch);
+            for (unsigned int n = 0; n < frames; n++) o[n] = 0;
+        }
+    }
+    return audio;
+}
+
+}
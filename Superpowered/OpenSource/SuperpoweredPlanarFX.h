@@ -0,0 +1,38 @@
+#ifndef Header_SuperpoweredPlanarFX
+#define Header_SuperpoweredPlanarFX
+
+#include "SuperpoweredFX.h"
+#include "SuperpoweredSIMD.h"
+
+namespace Superpowered {
+
+struct planarFXInternals;
+
+/// @brief Runs any effect derived from Superpowered::FX on planar (non-interleaved) buffers.
+/// The effects process interleaved stereo internally, so the audio is converted in an internal buffer in blocks. The planar graph doesn't need any interleaved buffers or conversion calls around the effects.
+/// Mono input is sent to both effect channels, mono output receives the average of the effect channels.
+class PlanarFX {
+public:
+    FX *fx; ///< The effect. Not owned, it's not deleted by the destructor.
+
+/// @brief Constructor.
+/// @param fx The effect.
+/// @param maximumBlockFrames The size of the internal buffer in frames. Longer inputs are processed in blocks of this size, so it should satisfy the minimum and multiplier requirements of the effect (such as a multiply of 8).
+    PlanarFX(FX *fx, unsigned int maximumBlockFrames = 1024);
+    ~PlanarFX();
+
+/// @brief Processes the audio with the effect. Same real-time rules as the process() method of the effect.
+/// @return If process() returns with true, the contents of output are replaced with the audio output. If process() returns with false, it indicates silence and the contents of output are not changed.
+/// @param input Planar input with 1 or 2 channels and at least as many frames as output.
+/// @param output Planar output with 1 or 2 channels. The number of frames to process is taken from this view. Can be equal to input (in-place processing).
+    bool process(const SIMD::PlanarBuffer &input, const SIMD::PlanarBuffer &output);
+
+private:
+    planarFXInternals *internals;
+    PlanarFX(const PlanarFX&);
+    PlanarFX& operator=(const PlanarFX&);
+};
+
+}
+
+#endif
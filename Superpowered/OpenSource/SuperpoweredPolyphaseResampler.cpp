@@ -0,0 +1,253 @@
+#include "SuperpoweredPolyphaseResampler.h"
+#include "SuperpoweredSIMD.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace Superpowered {
+
+struct polyphaseResamplerInternals {
+    float *coefficients, *deltas; // numPhases rows of numTaps coefficients, and the difference to the next row.
+    float *history;               // Planar input history, channel ch starts at ch * capacity.
+    float **taps;                 // The first tap of every channel for the current output frame.
+    unsigned long long inputFrames, outputFrames; // Totals since reset(), for flush().
+    unsigned int numChannels, maximumInputFrames, capacity, count, numTaps, numPhases;
+    unsigned int inputFramesUsed; // By the last process() call.
+    unsigned int inputSamplerate, outputSamplerate, up, down; // The ratio is up / down (output / input), reduced.
+    unsigned int index, remainder; // The first tap of the next output frame is at history frame index + remainder / up.
+    PolyphaseResampler::Quality quality;
+};
+
+// Taps, phases, Kaiser beta and cutoff (relative to Nyquist) for every quality preset.
+// The cutoff is the center of the transition band, which ends at Nyquist.
+static const struct { unsigned int taps, phases; double beta, cutoff; } presets[4] = {
+    { 16, 64, 5.65, 0.775 },
+    { 32, 256, 7.86, 0.845 },
+    { 64, 512, 10.06, 0.9 },
+    { 128, 1024, 12.27, 0.939 }
+};
+
+static const unsigned int maximumRatio = 16;
+
+// Zeroth order modified Bessel function of the first kind, for the Kaiser window.
+static double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    const double q = x * x * 0.25;
+    for (int k = 1; k < 64; k++) {
+        term *= q / double(k * k);
+        sum += term;
+        if (term < sum * 1e-17) break;
+    }
+    return sum;
+}
+
+static unsigned int greatestCommonDivisor(unsigned int a, unsigned int b) {
+    while (b) {
+        const unsigned int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// One phase of the filter: the first tap is (numTaps / 2 - 1 + fraction) frames before the output position, rows are normalized to unity gain.
+static void designPhase(double *row, unsigned int numTaps, double fraction, double cutoff, double beta) {
+    const double half = double(numTaps / 2), i0beta = 1.0 / besselI0(beta);
+    double sum = 0;
+    for (unsigned int k = 0; k < numTaps; k++) {
+        const double x = double(k) - (half - 1.0) - fraction, w = x / half;
+        const double window = (w * w < 1.0) ? besselI0(beta * sqrt(1.0 - w * w)) * i0beta : 0;
+        const double sinc = (fabs(x) < 1e-12) ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+        row[k] = cutoff * sinc * window;
+        sum += row[k];
+    }
+    for (unsigned int k = 0; k < numTaps; k++) row[k] /= sum;
+}
+
+// Allocates and designs the filter for the current rates. The old filter is kept if allocation fails.
+static bool designFilter(polyphaseResamplerInternals *internals, unsigned int inputSamplerate, unsigned int outputSamplerate) {
+    if (!inputSamplerate || !outputSamplerate || (inputSamplerate > outputSamplerate * maximumRatio) || (outputSamplerate > inputSamplerate * maximumRatio)) return false;
+    const unsigned int gcd = greatestCommonDivisor(inputSamplerate, outputSamplerate), up = outputSamplerate / gcd, down = inputSamplerate / gcd;
+    const double ratio = double(outputSamplerate) / double(inputSamplerate);
+    unsigned int numTaps = presets[internals->quality].taps, numPhases = presets[internals->quality].phases;
+    double cutoff = presets[internals->quality].cutoff;
+
+    // Downsampling: the cutoff moves to the output Nyquist, the filter is stretched by the same amount. The stretched filter is smoother, so less phases are needed.
+    if (ratio < 1.0) {
+        numTaps = ((unsigned int)ceil(double(numTaps) / ratio) + 7) & ~7u;
+        numPhases = (unsigned int)ceil(double(numPhases) * ratio);
+        if (numPhases < 32) numPhases = 32;
+        cutoff *= ratio;
+    }
+
+    const unsigned int capacity = numTaps + internals->maximumInputFrames * 2;
+    float *coefficients = (float *)malloc((size_t)numPhases * numTaps * sizeof(float));
+    float *deltas = (float *)malloc((size_t)numPhases * numTaps * sizeof(float));
+    float *history = (float *)malloc((size_t)capacity * internals->numChannels * sizeof(float));
+    double *rows = (double *)malloc((size_t)numTaps * 2 * sizeof(double));
+    if (!coefficients || !deltas || !history || !rows) {
+        free(coefficients);
+        free(deltas);
+        free(history);
+        free(rows);
+        return false;
+    }
+
+    const double beta = presets[internals->quality].beta;
+    double *row = rows, *next = rows + numTaps;
+    designPhase(row, numTaps, 0, cutoff, beta);
+    for (unsigned int phase = 0; phase < numPhases; phase++) {
+        designPhase(next, numTaps, double(phase + 1) / double(numPhases), cutoff, beta);
+        float *c = coefficients + (size_t)phase * numTaps, *d = deltas + (size_t)phase * numTaps;
+        for (unsigned int k = 0; k < numTaps; k++) {
+            c[k] = float(row[k]);
+            d[k] = float(next[k] - row[k]);
+        }
+        double *t = row;
+        row = next;
+        next = t;
+    }
+    free(rows);
+
+    free(internals->coefficients);
+    free(internals->deltas);
+    free(internals->history);
+    internals->coefficients = coefficients;
+    internals->deltas = deltas;
+    internals->history = history;
+    internals->capacity = capacity;
+    internals->numTaps = numTaps;
+    internals->numPhases = numPhases;
+    internals->inputSamplerate = inputSamplerate;
+    internals->outputSamplerate = outputSamplerate;
+    internals->up = up;
+    internals->down = down;
+    return true;
+}
+
+// Produces output frames while the history has enough input, then drops the input not needed anymore.
+static unsigned int produce(polyphaseResamplerInternals *internals, float *output, unsigned int maximumOutputFrames) {
+    const unsigned int numChannels = internals->numChannels, numTaps = internals->numTaps, numPhases = internals->numPhases, up = internals->up;
+    const float fractionMul = 1.0f / float(up);
+    unsigned int frames = 0;
+
+    while ((frames < maximumOutputFrames) && (internals->index + numTaps <= internals->count)) {
+        const unsigned long long phasePosition = (unsigned long long)internals->remainder * numPhases;
+        const unsigned int phase = (unsigned int)(phasePosition / up);
+        for (unsigned int ch = 0; ch < numChannels; ch++) internals->taps[ch] = internals->history + (size_t)ch * internals->capacity + internals->index;
+        SIMD::PolyphaseFIR(internals->taps, numChannels, internals->coefficients + (size_t)phase * numTaps, internals->deltas + (size_t)phase * numTaps, float(phasePosition % up) * fractionMul, numTaps, output + (size_t)frames * numChannels);
+        frames++;
+
+        internals->remainder += internals->down;
+        internals->index += internals->remainder / up;
+        internals->remainder %= up;
+    }
+
+    const unsigned int consumed = internals->index < internals->count ? internals->index : internals->count;
+    if (consumed) {
+        for (unsigned int ch = 0; ch < numChannels; ch++) {
+            float *h = internals->history + (size_t)ch * internals->capacity;
+            memmove(h, h + consumed, (internals->count - consumed) * sizeof(float));
+        }
+        internals->count -= consumed;
+        internals->index -= consumed;
+    }
+    internals->outputFrames += frames;
+    return frames;
+}
+
+PolyphaseResampler::PolyphaseResampler(unsigned int numChannels, unsigned int inputSamplerate, unsigned int outputSamplerate, Quality quality, unsigned int maximumInputFrames) {
+    internals = new polyphaseResamplerInternals;
+    memset(internals, 0, sizeof(polyphaseResamplerInternals));
+    internals->numChannels = numChannels ? numChannels : 1;
+    internals->maximumInputFrames = maximumInputFrames ? maximumInputFrames : 1;
+    internals->quality = ((quality >= Quality_Low) && (quality <= Quality_Best)) ? quality : Quality_Normal;
+    internals->taps = new float *[internals->numChannels];
+    if (!designFilter(internals, inputSamplerate, outputSamplerate)) designFilter(internals, 44100, 44100);
+    reset();
+}
+
+PolyphaseResampler::~PolyphaseResampler() {
+    free(internals->coefficients);
+    free(internals->deltas);
+    free(internals->history);
+    delete[] internals->taps;
+    delete internals;
+}
+
+bool PolyphaseResampler::setSamplerates(unsigned int inputSamplerate, unsigned int outputSamplerate) {
+    if (!designFilter(internals, inputSamplerate, outputSamplerate)) return false;
+    reset();
+    return true;
+}
+
+void PolyphaseResampler::reset() {
+    // The history starts with numTaps / 2 - 1 frames of silence, so the first output frame is at the first input frame.
+    internals->count = internals->numTaps / 2 - 1;
+    for (unsigned int ch = 0; ch < internals->numChannels; ch++) memset(internals->history + (size_t)ch * internals->capacity, 0, internals->count * sizeof(float));
+    internals->index = internals->remainder = internals->inputFramesUsed = 0;
+    internals->inputFrames = internals->outputFrames = 0;
+}
+
+unsigned int PolyphaseResampler::process(float *input, unsigned int numberOfInputFrames, float *output, unsigned int maximumOutputFrames) {
+    const unsigned int space = internals->capacity - internals->count, numChannels = internals->numChannels;
+    if (numberOfInputFrames > space) numberOfInputFrames = space;
+
+    float *history = internals->history + internals->count;
+    if (numChannels == 2) SIMD::DeInterleave(input, history, history + internals->capacity, numberOfInputFrames);
+    else for (unsigned int ch = 0; ch < numChannels; ch++) {
+        float *h = history + (size_t)ch * internals->capacity, *i = input + ch;
+        for (unsigned int n = 0; n < numberOfInputFrames; n++, i += numChannels) h[n] = *i;
+    }
+    internals->count += numberOfInputFrames;
+    internals->inputFrames += numberOfInputFrames;
+    internals->inputFramesUsed = numberOfInputFrames;
+    return produce(internals, output, maximumOutputFrames);
+}
+
+unsigned int PolyphaseResampler::flush(float *output, unsigned int maximumOutputFrames) {
+    const unsigned long long expected = (internals->inputFrames * internals->up + internals->down - 1) / internals->down;
+    if (expected <= internals->outputFrames) return 0;
+    if (expected - internals->outputFrames < maximumOutputFrames) maximumOutputFrames = (unsigned int)(expected - internals->outputFrames);
+
+    // Silence after the end of the input, not counted as input.
+    unsigned int silence = getRequiredInputFrames(maximumOutputFrames);
+    if (silence > internals->capacity - internals->count) silence = internals->capacity - internals->count;
+    for (unsigned int ch = 0; ch < internals->numChannels; ch++) memset(internals->history + (size_t)ch * internals->capacity + internals->count, 0, silence * sizeof(float));
+    internals->count += silence;
+    return produce(internals, output, maximumOutputFrames);
+}
+
+unsigned int PolyphaseResampler::getMaxOutputFrames(unsigned int numberOfInputFrames) {
+    const unsigned int space = internals->capacity - internals->count;
+    const unsigned long long available = (unsigned long long)internals->count + (numberOfInputFrames < space ? numberOfInputFrames : space);
+    // Output frame k is possible if index + (remainder + k * down) / up + numTaps <= available.
+    if (internals->index + internals->numTaps > available) return 0;
+    const unsigned long long limit = (available - internals->numTaps - internals->index + 1) * internals->up - internals->remainder;
+    return (unsigned int)((limit + internals->down - 1) / internals->down);
+}
+
+unsigned int PolyphaseResampler::getRequiredInputFrames(unsigned int numberOfOutputFrames) {
+    if (!numberOfOutputFrames) return 0;
+    const unsigned long long last = internals->index + ((unsigned long long)internals->remainder + (unsigned long long)(numberOfOutputFrames - 1) * internals->down) / internals->up;
+    const unsigned long long needed = last + internals->numTaps;
+    return (needed > internals->count) ? (unsigned int)(needed - internals->count) : 0;
+}
+
+unsigned int PolyphaseResampler::getInputFramesUsed() {
+    return internals->inputFramesUsed;
+}
+
+unsigned int PolyphaseResampler::getLatencyFrames() {
+    return internals->numTaps / 2;
+}
+
+unsigned int PolyphaseResampler::getNumTaps() {
+    return internals->numTaps;
+}
+
+unsigned int PolyphaseResampler::getNumChannels() {
+    return internals->numChannels;
+}
+
+}
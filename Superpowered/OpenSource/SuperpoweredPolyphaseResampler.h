@@ -0,0 +1,81 @@
+#ifndef Header_SuperpoweredPolyphaseResampler
+#define Header_SuperpoweredPolyphaseResampler
+
+namespace Superpowered {
+
+struct polyphaseResamplerInternals;
+
+/// @brief High quality sample rate converter for any ratio, with 32-bit floating point input and any number of channels.
+/// Windowed-sinc (Kaiser) polyphase filter with linear interpolation between the filter phases. Downsampling lowers the cutoff frequency and lengthens the filter to keep the aliasing rejection.
+/// Can be used in real-time (process() is not allocating and not blocking) and offline (process() in chunks, then flush() to get the end of the audio with sample accurate length).
+class PolyphaseResampler {
+public:
+    /// @brief Quality presets. Higher quality means a steeper filter, more stopband rejection, more CPU and more latency.
+    typedef enum Quality {
+        Quality_Low = 0,    ///< 16 taps, about 60 dB stopband rejection. Low latency (8 frames).
+        Quality_Normal = 1, ///< 32 taps, about 80 dB stopband rejection. 16 frames latency.
+        Quality_High = 2,   ///< 64 taps, about 100 dB stopband rejection. 32 frames latency.
+        Quality_Best = 3    ///< 128 taps, about 120 dB stopband rejection. 64 frames latency.
+    } Quality;
+
+/// @brief Constructor.
+/// @param numChannels The number of channels in the interleaved input and output.
+/// @param inputSamplerate Input sample rate in Hz.
+/// @param outputSamplerate Output sample rate in Hz.
+/// @param quality Quality preset.
+/// @param maximumInputFrames The maximum number of input frames for process().
+    PolyphaseResampler(unsigned int numChannels, unsigned int inputSamplerate, unsigned int outputSamplerate, Quality quality = Quality_Normal, unsigned int maximumInputFrames = 4096);
+    ~PolyphaseResampler();
+
+/// @brief Sets new sample rates and rebuilds the filter. Allocates memory, don't call it concurrently with process(). Calls reset().
+/// @return Returns with false if the ratio is outside 1:16 - 16:1 or memory allocation failed. The previous rates are kept in this case.
+/// @param inputSamplerate Input sample rate in Hz.
+/// @param outputSamplerate Output sample rate in Hz.
+    bool setSamplerates(unsigned int inputSamplerate, unsigned int outputSamplerate);
+
+/// @brief Clears the filter history and the frame counters. Call it if the audio is not continuous anymore, such as after a seek.
+    void reset();
+
+/// @brief Resamples audio.
+/// @return The number of output frames.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input with getNumChannels() channels.
+/// @param numberOfInputFrames The number of input frames, maximum maximumInputFrames. Input which can not produce output because of maximumOutputFrames is kept for the next call.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output with getNumChannels() channels.
+/// @param maximumOutputFrames The capacity of output in frames. getMaxOutputFrames(numberOfInputFrames) is always enough. If it is less, the kept input may fill the internal buffer and process() may take less input, see getInputFramesUsed().
+    unsigned int process(float *input, unsigned int numberOfInputFrames, float *output, unsigned int maximumOutputFrames);
+
+/// @return Returns with the number of input frames the last process() call has taken. Always numberOfInputFrames if maximumOutputFrames was at least getMaxOutputFrames(numberOfInputFrames). If less, pass the rest of the input to the next process() call, with more output space or after reading the output.
+    unsigned int getInputFramesUsed();
+
+/// @brief Offline processing: returns with the end of the audio after the last process() call, so the total output length is exactly (total input frames * output rate / input rate), rounded up. Call it repeatedly until it returns with 0.
+/// @return The number of output frames.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output with getNumChannels() channels.
+/// @param maximumOutputFrames The capacity of output in frames.
+    unsigned int flush(float *output, unsigned int maximumOutputFrames);
+
+/// @return Returns with the maximum number of output frames process() can return for numberOfInputFrames input frames.
+/// @param numberOfInputFrames The number of input frames.
+    unsigned int getMaxOutputFrames(unsigned int numberOfInputFrames);
+
+/// @return Returns with the number of input frames process() needs to output exactly numberOfOutputFrames frames with maximumOutputFrames = numberOfOutputFrames. Useful for real-time playback, where the output size is fixed.
+/// @param numberOfOutputFrames The number of output frames.
+    unsigned int getRequiredInputFrames(unsigned int numberOfOutputFrames);
+
+/// @return Returns with the latency in input frames: the filter needs this many frames after an input sample before the output around it can be produced.
+    unsigned int getLatencyFrames();
+
+/// @return Returns with the number of filter taps for the current sample rates.
+    unsigned int getNumTaps();
+
+/// @return Returns with the number of channels.
+    unsigned int getNumChannels();
+
+private:
+    polyphaseResamplerInternals *internals;
+    PolyphaseResampler(const PolyphaseResampler&);
+    PolyphaseResampler& operator=(const PolyphaseResampler&);
+};
+
+}
+
+#endif
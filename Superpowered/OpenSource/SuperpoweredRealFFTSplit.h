@@ -0,0 +1,68 @@
+#ifndef Header_SuperpoweredRealFFTSplit
+#define Header_SuperpoweredRealFFTSplit
+
+// The split step of the real FFTs in LargeFFT, MixedRadixFFT and DoubleFFT, for float and double.
+// A real FFT of size points is a complex FFT of size / 2 points (even samples as real, odd samples as imaginary), with this step for every bin pair k and size / 2 - k.
+// The output is packed like vDSP: 2 * DC in real[0], 2 * Nyquist in imag[0]. Internal header, not part of the public API.
+// The twiddle source is a class with a get(unsigned int k, T &c, T &s) method returning with cos and sin of 2 * pi * k / size.
+
+namespace Superpowered {
+namespace RealFFTSplit {
+
+// Twiddles stored as cos, sin pairs for k = 0 .. size / 4.
+template <typename T> struct interleavedTwiddles {
+    const T *twiddles;
+    interleavedTwiddles(const T *t) : twiddles(t) {}
+    inline void get(unsigned int k, T &c, T &s) const {
+        c = twiddles[k * 2];
+        s = twiddles[k * 2 + 1];
+    }
+};
+
+// After the forward complex FFT of size / 2 points.
+template <typename T, class Twiddles> static inline void forward(T *real, T *imag, unsigned int half, const Twiddles &twiddles) {
+    const T dc = real[0] + imag[0], nyquist = real[0] - imag[0];
+    real[0] = dc * T(2);
+    imag[0] = nyquist * T(2);
+
+    // S[k] = A + B + W^k * -i * (A - B), S[half - k] = conj(A + B - W^k * -i * (A - B)), where A = Z[k], B = conj(Z[half - k]), W = e^(-i * 2 * pi / size).
+    for (unsigned int k = 1; k <= half / 2; k++) {
+        const unsigned int m = half - k;
+        const T ar = real[k], ai = imag[k], br = real[m], bi = -imag[m];
+        const T sr = ar + br, si = ai + bi, dr = ai - bi, di = br - ar; // d = -i * (A - B)
+        T c, s;
+        twiddles.get(k, c, s);
+        const T tr = dr * c + di * s, ti = di * c - dr * s; // d * conj(e^(i * 2 * pi * k / size))
+        real[k] = sr + tr;
+        imag[k] = si + ti;
+        real[m] = sr - tr;
+        imag[m] = -(si - ti);
+    }
+}
+
+// Before the inverse complex FFT of size / 2 points.
+// 4 * Z[k] = P + T, 4 * Z[half - k] = conj(P - T), where P = S[k] + conj(S[half - k]), T = i * conj(W^k) * (S[k] - conj(S[half - k])).
+// The inverse complex FFT of 4 * Z returns with 2 * size times the signal, the same scaling as FFTReal.
+template <typename T, class Twiddles> static inline void inverse(T *real, T *imag, unsigned int half, const Twiddles &twiddles) {
+    const T dc = real[0], nyquist = imag[0];
+    real[0] = dc + nyquist;
+    imag[0] = dc - nyquist;
+
+    for (unsigned int k = 1; k <= half / 2; k++) {
+        const unsigned int m = half - k;
+        const T ar = real[k], ai = imag[k], br = real[m], bi = -imag[m];
+        const T pr = ar + br, pi = ai + bi, qr = ar - br, qi = ai - bi;
+        T c, s;
+        twiddles.get(k, c, s);
+        const T wr = qr * c - qi * s, wi = qi * c + qr * s; // conj(W^k) * Q, conj(W^k) = e^(i * 2 * pi * k / size)
+        real[k] = pr - wi;
+        imag[k] = pi + wr;
+        real[m] = pr + wi;
+        imag[m] = -(pi - wr);
+    }
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,1446 @@
+#include "SuperpoweredSIMD.h"
+#include <atomic>
+#include <math.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define SIMD_X86 0
+#endif
+
+namespace Superpowered {
+namespace SIMD {
+
+struct ditherInternals {
+    unsigned int *random;   // xorshift32 states. TPDF uses the first 16 (one per vector lane), noise shaping uses one per channel.
+    float *error;           // Quantization error history for noise shaping, 5 taps * numChannels. Tap k of the previous frames is at ((head + k) % 5) * numChannels.
+    unsigned int numChannels, head;
+    Dither::Mode mode;
+};
+
+// Every path provides one of these. The active table is selected on the first call.
+typedef struct kernelTable {
+    void (*Volume)(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames);
+    void (*ChangeVolume)(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames);
+    void (*VolumeAdd)(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames);
+    void (*ChangeVolumeAdd)(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames);
+    void (*CrossStereo)(float *inputA, float *inputB, float *output, float inputAGainStart, float inputAGainEnd, float inputBGainStart, float inputBGainEnd, unsigned int numberOfFrames);
+    void (*Interleave)(float *left, float *right, float *output, unsigned int numberOfFrames);
+    void (*DeInterleave)(float *input, float *left, float *right, unsigned int numberOfFrames);
+    void (*ShortIntToFloat)(short int *input, float *output, unsigned int numberOfFrames, unsigned int numChannels);
+    void (*FloatToShortInt)(float *input, short int *output, unsigned int numberOfFrames, unsigned int numChannels);
+    void (*Add1)(float *input, float *output, unsigned int numberOfItems);
+    void (*Add2)(float *inputA, float *inputB, float *output, unsigned int numberOfItems);
+    void (*Add4)(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfItems);
+    float (*DotProduct)(float *inputA, float *inputB, unsigned int numValues);
+    float (*Peak)(float *input, unsigned int numberOfValues);
+    void (*VolumeMultichannel)(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfFrames, unsigned int numChannels);
+    void (*ChangeVolumeMultichannel)(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfFrames, unsigned int numChannels);
+    void (*VolumeAddMultichannel)(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfFrames, unsigned int numChannels);
+    void (*ChangeVolumeAddMultichannel)(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfFrames, unsigned int numChannels);
+    void (*IntToFloatGetPeaks)(void *input, SampleFormat format, float *output, unsigned int numberOfFrames, unsigned int numChannels, float volumeStart, float volumeEnd, float *peaks, float *rms);
+    void (*dither)(ditherInternals *internals, float *input, void *output, unsigned int numberOfFrames, bool bit24);
+    float (*MixN)(float **inputs, unsigned int numInputs, float *output, float *gainStart, float *gainEnd, unsigned int numberOfFrames, unsigned int numChannels, bool addToOutput);
+    void (*FloatToHalf)(float *input, unsigned short *output, unsigned int numberOfValues);
+    void (*HalfToFloat)(unsigned short *input, float *output, unsigned int numberOfValues);
+    void (*FloatToBFloat16)(float *input, unsigned short *output, unsigned int numberOfValues);
+    void (*BFloat16ToFloat)(unsigned short *input, float *output, unsigned int numberOfValues);
+    void (*PolyphaseFIR)(float **inputs, unsigned int numChannels, float *coefficients, float *deltas, float fraction, unsigned int numTaps, float *output);
+    void (*Biquad2SumOfSquares)(float *input, unsigned int numberOfFrames, unsigned int numChannels, float *coefficients, float *state, float *sumOfSquares);
+    float (*TruePeak4x)(float *input, unsigned int numberOfFrames, float *framePeaks);
+    void (*FFTBatchInterleave)(float **inputs, unsigned int numValues, float *output);
+    void (*FFTBatchDeInterleave)(float *input, float **outputs, unsigned int numValues);
+    void (*FFTBatchRadix4)(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, float *twiddles, unsigned int twiddleStride, bool forward);
+    void (*FFTBatchRadix2)(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int stride);
+    void (*FFTBatchRealSplit)(float *real, float *imag, unsigned int half, float *twiddles, bool forward);
+    void (*FFTMixedRadixStage)(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, unsigned int radix, float *twiddles, bool forward);
+    void (*FFTDoubleRadix4)(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int n, unsigned int stride, double *twiddles, unsigned int twiddleStride, bool forward);
+    void (*FFTDoubleRadix2)(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int stride);
+    void (*ComplexMultiplyAccumulate)(float **aReal, float **aImag, float **bReal, float **bImag, unsigned int numProducts, float *outReal, float *outImag, unsigned int numValues, bool realFFTPacking);
+    void (*SparseComplexDotProducts)(float *inReal, float *inImag, float *matrixReal, float *matrixImag, unsigned int *bandStart, unsigned int *bandLength, unsigned int numRows, float *outReal, float *outImag);
+} kernelTable;
+
+// Portable implementations. Used as the scalar path and for the tails of the vector kernels.
+namespace scalar {
+    // Same scaling as SuperpoweredSimple.h: 16-bit values are mapped to +-32767, conversion to integer truncates.
+    static const float shortToFloatMul = 1.0f / 32767.0f, floatToShortMul = 32767.0f;
+
+    template <bool add> static void volumeRamp(float *input, float *output, float gain, float gainStep, unsigned int numberOfFrames) {
+        for (unsigned int n = 0; n < numberOfFrames; n++, input += 2, output += 2) {
+            const float g = gain + gainStep * float(n);
+            if (add) {
+                output[0] += input[0] * g;
+                output[1] += input[1] * g;
+            } else {
+                output[0] = input[0] * g;
+                output[1] = input[1] * g;
+            }
+        }
+    }
+
+    static void crossStereo(float *inputA, float *inputB, float *output, float gainA, float stepA, float gainB, float stepB, unsigned int numberOfFrames) {
+        for (unsigned int n = 0; n < numberOfFrames; n++, inputA += 2, inputB += 2, output += 2) {
+            const float a = gainA + stepA * float(n), b = gainB + stepB * float(n);
+            output[0] = inputA[0] * a + inputB[0] * b;
+            output[1] = inputA[1] * a + inputB[1] * b;
+        }
+    }
+
+    // One frame of the multichannel volume ramp. The gain step is (end - start) * stepMul if endGains is true, the value of gainEndOrChange otherwise.
+    template <bool add, bool endGains> static inline void volumeFrame(float *input, float *output, const float *gainStart, const float *gainEndOrChange, float frame, float stepMul, unsigned int numChannels) {
+        for (unsigned int ch = 0; ch < numChannels; ch++) {
+            const float step = endGains ? (gainEndOrChange[ch] - gainStart[ch]) * stepMul : gainEndOrChange[ch], g = gainStart[ch] + step * frame;
+            if (add) output[ch] += input[ch] * g; else output[ch] = input[ch] * g;
+        }
+    }
+
+    template <bool add, bool endGains> static void volumeMultichannel(float *input, float *output, float *gainStart, float *gainEndOrChange, unsigned int numberOfFrames, unsigned int numChannels) {
+        if (!numberOfFrames) return;
+        const float stepMul = 1.0f / float(numberOfFrames);
+        for (unsigned int frame = 0; frame < numberOfFrames; frame++, input += numChannels, output += numChannels) volumeFrame<add, endGains>(input, output, gainStart, gainEndOrChange, float(frame), stepMul, numChannels);
+    }
+
+    // Integer sample formats are converted with the same scaling as SuperpoweredSimple.h: ShortIntToFloat, Bit24ToFloat and IntToFloat.
+    // 24-bit samples are read as (sample << 8), so 24-bit and 32-bit share the same multiplier.
+    static const float int32ToFloatMul = 1.0f / 2147483648.0f;
+
+    static inline int int24(const unsigned char *p) {
+        return (int)(((unsigned int)p[0] << 8) | ((unsigned int)p[1] << 16) | ((unsigned int)p[2] << 24));
+    }
+
+    template <int format> static inline float integerSample(const void *input, unsigned int index) {
+        if (format == SampleFormat_Int16) return float(((const short int *)input)[index]) * shortToFloatMul;
+        else if (format == SampleFormat_Int24) return float(int24((const unsigned char *)input + index * 3)) * int32ToFloatMul;
+        else return float(((const int *)input)[index]) * int32ToFloatMul;
+    }
+
+    // Converts frames [frame, numberOfFrames) and accumulates the peaks and the sum of squares per channel.
+    template <int format> static void integerToFloatFrames(const void *input, float *output, unsigned int frame, unsigned int numberOfFrames, unsigned int numChannels, float gainStart, float gainStep, float *peaks, float *sumOfSquares) {
+        for (; frame < numberOfFrames; frame++) {
+            const float g = gainStart + gainStep * float(frame);
+            for (unsigned int ch = 0, index = frame * numChannels; ch < numChannels; ch++, index++) {
+                const float v = integerSample<format>(input, index) * g;
+                output[index] = v;
+                if (peaks && (fabsf(v) > peaks[ch])) peaks[ch] = fabsf(v);
+                if (sumOfSquares) sumOfSquares[ch] += v * v;
+            }
+        }
+    }
+
+    static void finishRMS(float *rms, unsigned int numberOfFrames, unsigned int numChannels) {
+        const float mul = numberOfFrames ? 1.0f / float(numberOfFrames) : 0.0f;
+        for (unsigned int ch = 0; ch < numChannels; ch++) rms[ch] = sqrtf(rms[ch] * mul);
+    }
+
+    static void IntToFloatGetPeaks(void *input, SampleFormat format, float *output, unsigned int numberOfFrames, unsigned int numChannels, float volumeStart, float volumeEnd, float *peaks, float *rms) {
+        if (peaks) for (unsigned int ch = 0; ch < numChannels; ch++) peaks[ch] = 0;
+        if (rms) for (unsigned int ch = 0; ch < numChannels; ch++) rms[ch] = 0;
+        const float step = numberOfFrames ? (volumeEnd - volumeStart) / float(numberOfFrames) : 0.0f;
+        switch (format) {
+            case SampleFormat_Int16: integerToFloatFrames<SampleFormat_Int16>(input, output, 0, numberOfFrames, numChannels, volumeStart, step, peaks, rms); break;
+            case SampleFormat_Int24: integerToFloatFrames<SampleFormat_Int24>(input, output, 0, numberOfFrames, numChannels, volumeStart, step, peaks, rms); break;
+            default: integerToFloatFrames<SampleFormat_Int32>(input, output, 0, numberOfFrames, numChannels, volumeStart, step, peaks, rms);
+        }
+        if (rms) finishRMS(rms, numberOfFrames, numChannels);
+    }
+
+    // Dithered conversion. 24-bit output has the same scaling as Superpowered::FloatTo24bit(). Both round to the nearest value.
+    static const float floatTo24Mul = 8388608.0f, int24Max = 8388607.0f;
+    // Error feedback filter for noise shaping: Lipshitz et al. minimally audible 5-tap FIR, designed for 44.1 kHz.
+    static const float noiseShaping[5] = { 2.033f, -2.165f, 1.959f, -1.590f, 0.6149f };
+
+    static inline unsigned int xorshift(unsigned int &state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // TPDF dither between -1 and 1 LSB: the difference of the two 16-bit halves of a random number.
+    static inline float triangular(unsigned int r) {
+        return (float(r & 0xffff) - float(r >> 16)) * (1.0f / 65536.0f);
+    }
+
+    template <bool bit24> static inline void storeQuantized(void *output, unsigned int index, int q) {
+        const int maximum = bit24 ? 8388607 : 32767;
+        if (q > maximum) q = maximum; else if (q < -maximum - 1) q = -maximum - 1;
+        if (bit24) {
+            unsigned char *p = (unsigned char *)output + index * 3;
+            p[0] = (unsigned char)q;
+            p[1] = (unsigned char)(q >> 8);
+            p[2] = (unsigned char)(q >> 16);
+        } else ((short int *)output)[index] = (short int)q;
+    }
+
+    template <bool bit24> static void ditherTPDF(ditherInternals *internals, float *input, void *output, unsigned int first, unsigned int numberOfValues) {
+        const float scale = bit24 ? floatTo24Mul : floatToShortMul, limit = bit24 ? int24Max : floatToShortMul;
+        unsigned int &random = internals->random[0];
+        for (unsigned int n = first; n < numberOfValues; n++) {
+            float v = input[n] * scale + triangular(xorshift(random));
+            if (v > limit) v = limit; else if (v < -limit) v = -limit;
+            storeQuantized<bit24>(output, n, (int)rintf(v));
+        }
+    }
+
+    static inline void ditherTaps(ditherInternals *internals, float **taps) {
+        for (unsigned int k = 0; k < 5; k++) taps[k] = internals->error + ((internals->head + k) % 5) * internals->numChannels;
+    }
+
+    // Noise shaped dither for the channels [firstChannel, numChannels) of one frame. The new error overwrites the oldest tap.
+    // The shaped value is clamped before quantization, so clipping never feeds back into the error filter.
+    template <bool bit24> static inline void ditherShapedFrame(ditherInternals *internals, float *input, void *output, unsigned int frame, unsigned int firstChannel, float **taps) {
+        const float scale = bit24 ? floatTo24Mul : floatToShortMul, limit = bit24 ? int24Max : floatToShortMul;
+        for (unsigned int ch = firstChannel, index = frame * internals->numChannels + firstChannel; ch < internals->numChannels; ch++, index++) {
+            float v = input[index] * scale - (noiseShaping[0] * taps[0][ch] + noiseShaping[1] * taps[1][ch] + noiseShaping[2] * taps[2][ch] + noiseShaping[3] * taps[3][ch] + noiseShaping[4] * taps[4][ch]);
+            if (v > limit) v = limit; else if (v < -limit) v = -limit;
+            const float q = rintf(v + triangular(xorshift(internals->random[ch])));
+            taps[4][ch] = q - v;
+            storeQuantized<bit24>(output, index, (int)q);
+        }
+    }
+
+    template <bool bit24> static void ditherShaped(ditherInternals *internals, float *input, void *output, unsigned int numberOfFrames) {
+        float *taps[5];
+        for (unsigned int frame = 0; frame < numberOfFrames; frame++) {
+            ditherTaps(internals, taps);
+            ditherShapedFrame<bit24>(internals, input, output, frame, 0, taps);
+            internals->head = (internals->head + 4) % 5;
+        }
+    }
+
+    static void dither(ditherInternals *internals, float *input, void *output, unsigned int numberOfFrames, bool bit24) {
+        if (internals->mode == Dither::Mode_NoiseShaped) {
+            if (bit24) ditherShaped<true>(internals, input, output, numberOfFrames); else ditherShaped<false>(internals, input, output, numberOfFrames);
+        } else {
+            const unsigned int numberOfValues = numberOfFrames * internals->numChannels;
+            if (bit24) ditherTPDF<true>(internals, input, output, 0, numberOfValues); else ditherTPDF<false>(internals, input, output, 0, numberOfValues);
+        }
+    }
+
+    // The gain ramp of MixN input k is start + step * frame. Missing gain arrays mean unity or constant gain.
+    static inline void mixGain(const float *gainStart, const float *gainEnd, unsigned int k, float stepMul, float &start, float &step) {
+        start = gainStart ? gainStart[k] : 1.0f;
+        step = (gainStart && gainEnd) ? (gainEnd[k] - gainStart[k]) * stepMul : 0;
+    }
+
+    // Adds the inputs [firstInput, lastInput) at index to sum.
+    static inline float mixValue(float **inputs, unsigned int firstInput, unsigned int lastInput, float sum, const float *gainStart, const float *gainEnd, float stepMul, unsigned int index, float frame) {
+        for (unsigned int k = firstInput; k < lastInput; k++) {
+            float start, step;
+            mixGain(gainStart, gainEnd, k, stepMul, start, step);
+            sum += inputs[k][index] * (start + step * frame);
+        }
+        return sum;
+    }
+
+    static float MixN(float **inputs, unsigned int numInputs, float *output, float *gainStart, float *gainEnd, unsigned int numberOfFrames, unsigned int numChannels, bool addToOutput) {
+        if (!numberOfFrames) return 0;
+        const float stepMul = 1.0f / float(numberOfFrames);
+        float peak = 0;
+        for (unsigned int frame = 0, index = 0; frame < numberOfFrames; frame++) for (unsigned int ch = 0; ch < numChannels; ch++, index++) {
+            output[index] = mixValue(inputs, 0, numInputs, addToOutput ? output[index] : 0, gainStart, gainEnd, stepMul, index, float(frame));
+            peak = fmaxf(peak, fabsf(output[index]));
+        }
+        return peak;
+    }
+
+    static inline unsigned int floatBits(float f) { unsigned int u; memcpy(&u, &f, 4); return u; }
+    static inline float bitsToFloat(unsigned int u) { float f; memcpy(&f, &u, 4); return f; }
+
+    // IEEE 754 half precision with round to nearest even, including denormals, infinity and NaN. Same results as F16C: NaN stays NaN, made quiet, with the top bits of the payload.
+    static inline unsigned short floatToHalf(float x) {
+        unsigned int f = floatBits(x), o;
+        const unsigned int sign = (f >> 16) & 0x8000;
+        f &= 0x7fffffff;
+        if (f >= 0x47800000) o = (f > 0x7f800000) ? (0x7e00 | ((f >> 13) & 0x3ff)) : 0x7c00; // Infinity for values too large. NaN stays NaN, quiet, with the top bits of the payload.
+        else if (f < 0x38800000) o = floatBits(bitsToFloat(f) + 0.5f) - 0x3f000000; // Denormal half: the float adder shifts and rounds the mantissa.
+        else o = (f + 0xc8000fff + ((f >> 13) & 1)) >> 13; // Exponent rebias and mantissa rounding in one add.
+        return (unsigned short)(o | sign);
+    }
+
+    static inline float halfToFloat(unsigned short h) {
+        unsigned int o = (unsigned int)(h & 0x7fff) << 13;
+        const unsigned int exponent = o & 0x0f800000;
+        o += 0x38000000; // Exponent rebias: (127 - 15) << 23.
+        if (exponent == 0x0f800000) o = (o + 0x38000000) | ((o & 0x007fffff) ? 0x00400000 : 0); // Infinity, or NaN made quiet with the payload kept, as F16C does.
+        else if (!exponent) o = floatBits(bitsToFloat(o + 0x00800000) - 6.103515625e-05f); // Zero or denormal: renormalize with the float adder (2^-14).
+        return bitsToFloat(o | ((unsigned int)(h & 0x8000) << 16));
+    }
+
+    // bfloat16 is the upper half of a float, rounded to nearest even.
+    static inline unsigned short floatToBFloat16(float x) {
+        const unsigned int f = floatBits(x);
+        if ((f & 0x7fffffff) > 0x7f800000) return (unsigned short)((f >> 16) | 0x40); // Quiet NaN.
+        return (unsigned short)((f + 0x7fff + ((f >> 16) & 1)) >> 16);
+    }
+
+    static inline float bfloat16ToFloat(unsigned short b) { return bitsToFloat((unsigned int)b << 16); }
+
+    static void FloatToHalf(float *input, unsigned short *output, unsigned int numberOfValues) {
+        for (unsigned int n = 0; n < numberOfValues; n++) output[n] = floatToHalf(input[n]);
+    }
+
+    static void HalfToFloat(unsigned short *input, float *output, unsigned int numberOfValues) {
+        for (unsigned int n = 0; n < numberOfValues; n++) output[n] = halfToFloat(input[n]);
+    }
+
+    static void FloatToBFloat16(float *input, unsigned short *output, unsigned int numberOfValues) {
+        for (unsigned int n = 0; n < numberOfValues; n++) output[n] = floatToBFloat16(input[n]);
+    }
+
+    static void BFloat16ToFloat(unsigned short *input, float *output, unsigned int numberOfValues) {
+        for (unsigned int n = 0; n < numberOfValues; n++) output[n] = bfloat16ToFloat(input[n]);
+    }
+
+    // One polyphase filter tap range for one channel, with the coefficients interpolated between two phases.
+    static inline float polyphaseTaps(const float *input, const float *coefficients, const float *deltas, float fraction, unsigned int numTaps) {
+        float sum = 0;
+        for (unsigned int k = 0; k < numTaps; k++) sum += input[k] * (coefficients[k] + deltas[k] * fraction);
+        return sum;
+    }
+
+    static void PolyphaseFIR(float **inputs, unsigned int numChannels, float *coefficients, float *deltas, float fraction, unsigned int numTaps, float *output) {
+        for (unsigned int ch = 0; ch < numChannels; ch++) output[ch] = polyphaseTaps(inputs[ch], coefficients, deltas, fraction, numTaps);
+    }
+
+    // Two cascaded biquads (transposed direct form II) for the channels [firstChannel, numChannels), with the sum of squares of the output.
+    // coefficients: b0, b1, b2, a1, a2 of the first biquad, then the second. state: z1 and z2 of the first biquad, then the second, numChannels values each.
+    static void biquad2SumOfSquares(float *input, unsigned int numberOfFrames, unsigned int numChannels, unsigned int firstChannel, const float *coefficients, float *state, float *sumOfSquares) {
+        const float *c = coefficients;
+        for (unsigned int ch = firstChannel; ch < numChannels; ch++) {
+            float z1 = state[ch], z2 = state[numChannels + ch], z3 = state[numChannels * 2 + ch], z4 = state[numChannels * 3 + ch], sum = 0;
+            for (unsigned int frame = 0, index = ch; frame < numberOfFrames; frame++, index += numChannels) {
+                const float x = input[index], y = c[0] * x + z1;
+                z1 = c[1] * x - c[3] * y + z2;
+                z2 = c[2] * x - c[4] * y;
+                const float o = c[5] * y + z3;
+                z3 = c[6] * y - c[8] * o + z4;
+                z4 = c[7] * y - c[9] * o;
+                sum += o * o;
+            }
+            state[ch] = z1;
+            state[numChannels + ch] = z2;
+            state[numChannels * 2 + ch] = z3;
+            state[numChannels * 3 + ch] = z4;
+            sumOfSquares[ch] += sum;
+        }
+    }
+
+    static void Biquad2SumOfSquares(float *input, unsigned int numberOfFrames, unsigned int numChannels, float *coefficients, float *state, float *sumOfSquares) {
+        biquad2SumOfSquares(input, numberOfFrames, numChannels, 0, coefficients, state, sumOfSquares);
+    }
+
+    // The responses of one biquad over a block of blockFrames frames (maximum 16), for the vector kernels processing one channel a block at a time. responses is blockFrames * 6 + 4 floats:
+    // - impulse (blockFrames * 2): blockFrames - 1 zeros, then the impulse response, so the output for input frame j starts at blockFrames - 1 - j.
+    // - fromZ1, fromZ2 (blockFrames each): the output for a state of z1 = 1 or z2 = 1 and no input.
+    // - toZ1, toZ2 (blockFrames each): z1 and z2 after the block for input frame j = 1 and no state.
+    // - feedback (4): z1 after the block for a state of z1 = 1 or z2 = 1 and no input, then z2 the same way.
+    // Every response is derived from g, the output without input for z1 = 1: fromZ2 is g delayed by one frame, and the impulse response is b0, then the output for the state the first frame leaves.
+    static void biquadBlockResponses(const float *c, unsigned int blockFrames, float *responses) {
+        const double b0 = c[0], a1 = c[3], a2 = c[4];
+        double g[18], h[18];
+        g[0] = 1.0;
+        g[1] = -a1;
+        for (unsigned int n = 2; n <= blockFrames; n++) g[n] = -a1 * g[n - 1] - a2 * g[n - 2];
+        const double z1 = double(c[1]) - a1 * b0, z2 = double(c[2]) - a2 * b0;
+        h[0] = b0;
+        h[1] = z1;
+        for (unsigned int n = 2; n <= blockFrames; n++) h[n] = z1 * g[n - 1] + z2 * g[n - 2];
+
+        float *impulse = responses, *fromZ1 = impulse + blockFrames * 2, *fromZ2 = fromZ1 + blockFrames, *toZ1 = fromZ2 + blockFrames, *toZ2 = toZ1 + blockFrames, *feedback = toZ2 + blockFrames;
+        for (unsigned int n = 0; n < blockFrames * 2; n++) impulse[n] = (n < blockFrames - 1) ? 0 : float(h[n - (blockFrames - 1)]);
+        for (unsigned int n = 0; n < blockFrames; n++) {
+            fromZ1[n] = float(g[n]);
+            fromZ2[n] = n ? float(g[n - 1]) : 0;
+            toZ1[n] = float(h[blockFrames - n]);
+            toZ2[n] = float(-a2 * h[blockFrames - n - 1] + ((n == blockFrames - 1) ? double(c[2]) : 0));
+        }
+        feedback[0] = float(g[blockFrames]);
+        feedback[1] = float(g[blockFrames - 1]);
+        feedback[2] = float(-a2 * g[blockFrames - 1]);
+        feedback[3] = float(-a2 * g[blockFrames - 2]);
+    }
+
+    // ITU-R BS.1770-4 Annex 2 true-peak interpolation filter: 48 taps, 4 phases of 12 taps. Coefficient k is for input[n - k], phase p is the signal at (6 - p / 4) frames before input[n].
+    // The filter passband is slightly below unity, so the sample value at phase 0 is added to the maximum: the true peak is never lower than the sample peak.
+    static const float truePeakCoefficients[4][12] = {
+        { 0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f, -0.0594482421875f, 0.1373291015625f, 0.9721679687500f, -0.1022949218750f, 0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f },
+        { -0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f, -0.1665039062500f, 0.4650878906250f, 0.7797851562500f, -0.2003173828125f, 0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f },
+        { -0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f, -0.2003173828125f, 0.7797851562500f, 0.4650878906250f, -0.1665039062500f, 0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f },
+        { -0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f, -0.1022949218750f, 0.9721679687500f, 0.1373291015625f, -0.0594482421875f, 0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f }
+    };
+
+    // The peak of the 4x oversampled frames [first, numberOfFrames).
+    static float truePeak4x(float *input, unsigned int first, unsigned int numberOfFrames, float *framePeaks) {
+        float peak = 0;
+        for (unsigned int n = first; n < numberOfFrames; n++) {
+            float framePeak = fabsf(input[(int)n - 6]);
+            for (unsigned int phase = 0; phase < 4; phase++) {
+                float sum = 0;
+                for (int k = 0; k < 12; k++) sum += input[(int)n - k] * truePeakCoefficients[phase][k];
+                framePeak = fmaxf(framePeak, fabsf(sum));
+            }
+            if (framePeaks) framePeaks[n] = fmaxf(framePeaks[n], framePeak);
+            peak = fmaxf(peak, framePeak);
+        }
+        return peak;
+    }
+
+    static float TruePeak4x(float *input, unsigned int numberOfFrames, float *framePeaks) {
+        return truePeak4x(input, 0, numberOfFrames, framePeaks);
+    }
+
+    // Batched FFT: 16 transforms are interleaved, value t of complex element k is at [k * 16 + t].
+    static void FFTBatchInterleave(float **inputs, unsigned int numValues, float *output) {
+        for (unsigned int n = 0; n < numValues; n++, output += 16) {
+            for (unsigned int t = 0; t < 16; t++) output[t] = inputs[t][n];
+        }
+    }
+
+    static void FFTBatchDeInterleave(float *input, float **outputs, unsigned int numValues) {
+        for (unsigned int n = 0; n < numValues; n++, input += 16) {
+            for (unsigned int t = 0; t < 16; t++) outputs[t][n] = input[t];
+        }
+    }
+
+    // One radix-4 decimation in frequency Stockham stage: y[q + stride * (4p + r)] = W^(r * p) * sum(x[q + stride * (p + j * n / 4)] * W4^(r * j)), W = e^(-/+ i * 2 * pi / n).
+    static void FFTBatchRadix4(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, float *twiddles, unsigned int twiddleStride, bool forward) {
+        const unsigned int m = n / 4, block = stride * 16, quarter = m * block, u = forward ? 1 : 3, v = 4 - u; // The -i * (b - d) term goes to row u, +i * (b - d) to row v.
+        const float sign = forward ? -1.0f : 1.0f;
+        for (unsigned int p = 0; p < m; p++) {
+            const float *t2 = twiddles + p * 2 * twiddleStride * 2, *tu = twiddles + p * u * twiddleStride * 2, *tv = twiddles + p * v * twiddleStride * 2;
+            const float w2r = t2[0], w2i = t2[1] * sign, wur = tu[0], wui = tu[1] * sign, wvr = tv[0], wvi = tv[1] * sign;
+            const float *xr = inReal + p * block, *xi = inImag + p * block;
+            float *yr = outReal + p * 4 * block, *yi = outImag + p * 4 * block;
+            for (unsigned int k = 0; k < block; k++) {
+                const float ar = xr[k], ai = xi[k], br = xr[quarter + k], bi = xi[quarter + k], cr = xr[quarter * 2 + k], ci = xi[quarter * 2 + k], dr = xr[quarter * 3 + k], di = xi[quarter * 3 + k];
+                const float apcr = ar + cr, apci = ai + ci, amcr = ar - cr, amci = ai - ci, bpdr = br + dr, bpdi = bi + di, bmdr = br - dr, bmdi = bi - di;
+                const float r2 = apcr - bpdr, i2 = apci - bpdi, ur = amcr + bmdi, ui = amci - bmdr, vr = amcr - bmdi, vi = amci + bmdr;
+                yr[k] = apcr + bpdr;
+                yi[k] = apci + bpdi;
+                yr[block * 2 + k] = r2 * w2r - i2 * w2i;
+                yi[block * 2 + k] = r2 * w2i + i2 * w2r;
+                yr[block * u + k] = ur * wur - ui * wui;
+                yi[block * u + k] = ur * wui + ui * wur;
+                yr[block * v + k] = vr * wvr - vi * wvi;
+                yi[block * v + k] = vr * wvi + vi * wvr;
+            }
+        }
+    }
+
+    static void FFTBatchRadix2(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int stride) {
+        const unsigned int block = stride * 16;
+        for (unsigned int k = 0; k < block; k++) {
+            const float ar = inReal[k], ai = inImag[k], br = inReal[block + k], bi = inImag[block + k];
+            outReal[k] = ar + br;
+            outImag[k] = ai + bi;
+            outReal[block + k] = ar - br;
+            outImag[block + k] = ai - bi;
+        }
+    }
+
+    // The split step of the real FFT, the same as LargeFFT::realFFT, for every bin pair k and half - k of the 16 transforms.
+    static void FFTBatchRealSplit(float *real, float *imag, unsigned int half, float *twiddles, bool forward) {
+        for (unsigned int t = 0; t < 16; t++) {
+            const float dc = real[t], nyquist = imag[t];
+            real[t] = forward ? (dc + nyquist) * 2.0f : dc + nyquist;
+            imag[t] = forward ? (dc - nyquist) * 2.0f : dc - nyquist;
+        }
+        for (unsigned int k = 1; k <= half / 2; k++) {
+            float *rk = real + k * 16, *ik = imag + k * 16, *rm = real + (half - k) * 16, *im = imag + (half - k) * 16;
+            const float c = twiddles[k * 2], s = twiddles[k * 2 + 1];
+            for (unsigned int t = 0; t < 16; t++) {
+                const float ar = rk[t], ai = ik[t], br = rm[t], bi = -im[t];
+                if (forward) {
+                    const float sr = ar + br, si = ai + bi, dr = ai - bi, di = br - ar;
+                    const float tr = dr * c + di * s, ti = di * c - dr * s;
+                    rk[t] = sr + tr;
+                    ik[t] = si + ti;
+                    rm[t] = sr - tr;
+                    im[t] = ti - si;
+                } else {
+                    const float pr = ar + br, pi = ai + bi, qr = ar - br, qi = ai - bi;
+                    const float wr = qr * c - qi * s, wi = qi * c + qr * s;
+                    rk[t] = pr - wi;
+                    ik[t] = pi + wr;
+                    rm[t] = pr + wi;
+                    im[t] = wr - pi;
+                }
+            }
+        }
+    }
+
+    // cos and sin of 2 * pi * k / radix for the odd radices of the mixed-radix FFT, k = 1 to radix / 2.
+    static const float radix3Sin = 0.866025404f;
+    static const float radix5Cos[2] = { 0.309016994f, -0.809016994f }, radix5Sin[2] = { 0.951056516f, 0.587785252f };
+    static const float radix7Cos[3] = { 0.623489802f, -0.222520934f, -0.900968868f }, radix7Sin[3] = { 0.781831482f, 0.974927912f, 0.433883739f };
+
+    // In-place DFT of radix values, e = e^(-/+ i * 2 * pi / radix). Everything is written out with compile-time indices, so the values stay in registers without loop unrolling.
+    // The odd radices use the symmetry of the input pairs j and radix - j: y[k] = C + i * S, y[radix - k] = C - i * S, where C = x[0] + sum((x[j] + x[radix - j]) * cos), S = sum((x[j] - x[radix - j]) * sin).
+    template <unsigned int radix> static inline void mixedRadixDFT(float *re, float *im, bool forward) {
+        const float sign = forward ? -1.0f : 1.0f;
+        if (radix == 2) {
+            const float r = re[0] - re[1], i = im[0] - im[1];
+            re[0] += re[1];
+            im[0] += im[1];
+            re[1] = r;
+            im[1] = i;
+        } else if (radix == 3) {
+            const float ar = re[1] + re[2], ai = im[1] + im[2], s = radix3Sin * sign, sr = (re[1] - re[2]) * s, si = (im[1] - im[2]) * s;
+            const float cr = re[0] - 0.5f * ar, ci = im[0] - 0.5f * ai;
+            re[0] += ar;
+            im[0] += ai;
+            re[1] = cr - si;
+            im[1] = ci + sr;
+            re[2] = cr + si;
+            im[2] = ci - sr;
+        } else if (radix == 4) {
+            const float apcr = re[0] + re[2], apci = im[0] + im[2], amcr = re[0] - re[2], amci = im[0] - im[2];
+            const float bpdr = re[1] + re[3], bpdi = im[1] + im[3], bmdr = re[1] - re[3], bmdi = im[1] - im[3];
+            const float ur = amcr + bmdi, ui = amci - bmdr, vr = amcr - bmdi, vi = amci + bmdr; // u = a - c - i * (b - d), v = a - c + i * (b - d)
+            re[0] = apcr + bpdr;
+            im[0] = apci + bpdi;
+            re[2] = apcr - bpdr;
+            im[2] = apci - bpdi;
+            re[1] = forward ? ur : vr;
+            im[1] = forward ? ui : vi;
+            re[3] = forward ? vr : ur;
+            im[3] = forward ? vi : ui;
+        } else if (radix == 5) {
+            const float c1 = radix5Cos[0], c2 = radix5Cos[1], s1 = radix5Sin[0] * sign, s2 = radix5Sin[1] * sign;
+            const float a1r = re[1] + re[4], a1i = im[1] + im[4], b1r = re[1] - re[4], b1i = im[1] - im[4];
+            const float a2r = re[2] + re[3], a2i = im[2] + im[3], b2r = re[2] - re[3], b2i = im[2] - im[3];
+            const float c1r = re[0] + a1r * c1 + a2r * c2, c1i = im[0] + a1i * c1 + a2i * c2, s1r = b1r * s1 + b2r * s2, s1i = b1i * s1 + b2i * s2;
+            const float c2r = re[0] + a1r * c2 + a2r * c1, c2i = im[0] + a1i * c2 + a2i * c1, s2r = b1r * s2 - b2r * s1, s2i = b1i * s2 - b2i * s1;
+            re[0] += a1r + a2r;
+            im[0] += a1i + a2i;
+            re[1] = c1r - s1i;
+            im[1] = c1i + s1r;
+            re[4] = c1r + s1i;
+            im[4] = c1i - s1r;
+            re[2] = c2r - s2i;
+            im[2] = c2i + s2r;
+            re[3] = c2r + s2i;
+            im[3] = c2i - s2r;
+        } else if (radix == 7) {
+            const float c1 = radix7Cos[0], c2 = radix7Cos[1], c3 = radix7Cos[2], s1 = radix7Sin[0] * sign, s2 = radix7Sin[1] * sign, s3 = radix7Sin[2] * sign;
+            const float a1r = re[1] + re[6], a1i = im[1] + im[6], b1r = re[1] - re[6], b1i = im[1] - im[6];
+            const float a2r = re[2] + re[5], a2i = im[2] + im[5], b2r = re[2] - re[5], b2i = im[2] - im[5];
+            const float a3r = re[3] + re[4], a3i = im[3] + im[4], b3r = re[3] - re[4], b3i = im[3] - im[4];
+            const float c1r = re[0] + a1r * c1 + a2r * c2 + a3r * c3, c1i = im[0] + a1i * c1 + a2i * c2 + a3i * c3, s1r = b1r * s1 + b2r * s2 + b3r * s3, s1i = b1i * s1 + b2i * s2 + b3i * s3;
+            const float c2r = re[0] + a1r * c2 + a2r * c3 + a3r * c1, c2i = im[0] + a1i * c2 + a2i * c3 + a3i * c1, s2r = b1r * s2 - b2r * s3 - b3r * s1, s2i = b1i * s2 - b2i * s3 - b3i * s1;
+            const float c3r = re[0] + a1r * c3 + a2r * c1 + a3r * c2, c3i = im[0] + a1i * c3 + a2i * c1 + a3i * c2, s3r = b1r * s3 - b2r * s1 + b3r * s2, s3i = b1i * s3 - b2i * s1 + b3i * s2;
+            re[0] += a1r + a2r + a3r;
+            im[0] += a1i + a2i + a3i;
+            re[1] = c1r - s1i;
+            im[1] = c1i + s1r;
+            re[6] = c1r + s1i;
+            im[6] = c1i - s1r;
+            re[2] = c2r - s2i;
+            im[2] = c2i + s2r;
+            re[5] = c2r + s2i;
+            im[5] = c2i - s2r;
+            re[3] = c3r - s3i;
+            im[3] = c3i + s3r;
+            re[4] = c3r + s3i;
+            im[4] = c3i - s3r;
+        }
+    }
+
+    // y[k] * (w[0] + i * w[1] * sign), stored at k * stride.
+    template <unsigned int k> static inline void mixedRadixTwiddle(const float *re, const float *im, const float *twiddles, float sign, float *yr, float *yi, unsigned int stride) {
+        const float wr = twiddles[(k - 1) * 2], wi = twiddles[(k - 1) * 2 + 1] * sign;
+        yr[k * stride] = re[k] * wr - im[k] * wi;
+        yi[k * stride] = re[k] * wi + im[k] * wr;
+    }
+
+    // One mixed-radix Stockham stage for q in [first, stride): y[q + stride * (radix * p + k)] = W^(k * p) * sum(x[q + stride * (p + j * n / radix)] * e^(j * k)), W = e^(-/+ i * 2 * pi / n).
+    template <unsigned int radix> static void mixedRadixStage(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, unsigned int first, float *twiddles, bool forward) {
+        const unsigned int m = n / radix, step = m * stride;
+        const float sign = forward ? -1.0f : 1.0f;
+        for (unsigned int p = 0; p < m; p++, twiddles += (radix - 1) * 2) {
+            const float *xr = inReal + p * stride, *xi = inImag + p * stride;
+            float *yr = outReal + p * radix * stride, *yi = outImag + p * radix * stride;
+            for (unsigned int q = first; q < stride; q++) {
+                float re[radix], im[radix];
+                re[0] = xr[q]; im[0] = xi[q];
+                re[1] = xr[step + q]; im[1] = xi[step + q];
+                if (radix > 2) { re[2] = xr[step * 2 + q]; im[2] = xi[step * 2 + q]; }
+                if (radix > 3) { re[3] = xr[step * 3 + q]; im[3] = xi[step * 3 + q]; }
+                if (radix > 4) { re[4] = xr[step * 4 + q]; im[4] = xi[step * 4 + q]; }
+                if (radix > 5) { re[5] = xr[step * 5 + q]; im[5] = xi[step * 5 + q]; }
+                if (radix > 6) { re[6] = xr[step * 6 + q]; im[6] = xi[step * 6 + q]; }
+                mixedRadixDFT<radix>(re, im, forward);
+                yr[q] = re[0];
+                yi[q] = im[0];
+                mixedRadixTwiddle<1>(re, im, twiddles, sign, yr + q, yi + q, stride);
+                if (radix > 2) mixedRadixTwiddle<2>(re, im, twiddles, sign, yr + q, yi + q, stride);
+                if (radix > 3) mixedRadixTwiddle<3>(re, im, twiddles, sign, yr + q, yi + q, stride);
+                if (radix > 4) mixedRadixTwiddle<4>(re, im, twiddles, sign, yr + q, yi + q, stride);
+                if (radix > 5) mixedRadixTwiddle<5>(re, im, twiddles, sign, yr + q, yi + q, stride);
+                if (radix > 6) mixedRadixTwiddle<6>(re, im, twiddles, sign, yr + q, yi + q, stride);
+            }
+        }
+    }
+
+    static void FFTMixedRadixStage(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, unsigned int radix, float *twiddles, bool forward) {
+        switch (radix) {
+            case 2: mixedRadixStage<2>(inReal, inImag, outReal, outImag, n, stride, 0, twiddles, forward); break;
+            case 3: mixedRadixStage<3>(inReal, inImag, outReal, outImag, n, stride, 0, twiddles, forward); break;
+            case 4: mixedRadixStage<4>(inReal, inImag, outReal, outImag, n, stride, 0, twiddles, forward); break;
+            case 5: mixedRadixStage<5>(inReal, inImag, outReal, outImag, n, stride, 0, twiddles, forward); break;
+            case 7: mixedRadixStage<7>(inReal, inImag, outReal, outImag, n, stride, 0, twiddles, forward); break;
+            default: break;
+        }
+    }
+
+    // Double precision radix-4 Stockham stage, the same as FFTBatchRadix4 for one transform.
+    static void FFTDoubleRadix4(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int n, unsigned int stride, double *twiddles, unsigned int twiddleStride, bool forward) {
+        const unsigned int m = n / 4, quarter = m * stride, u = forward ? 1 : 3, v = 4 - u; // The -i * (b - d) term goes to row u, +i * (b - d) to row v.
+        const double sign = forward ? -1.0 : 1.0;
+        for (unsigned int p = 0; p < m; p++) {
+            const double *t2 = twiddles + p * 2 * twiddleStride * 2, *tu = twiddles + p * u * twiddleStride * 2, *tv = twiddles + p * v * twiddleStride * 2;
+            const double w2r = t2[0], w2i = t2[1] * sign, wur = tu[0], wui = tu[1] * sign, wvr = tv[0], wvi = tv[1] * sign;
+            const double *xr = inReal + p * stride, *xi = inImag + p * stride;
+            double *yr = outReal + p * 4 * stride, *yi = outImag + p * 4 * stride;
+            for (unsigned int q = 0; q < stride; q++) {
+                const double ar = xr[q], ai = xi[q], br = xr[quarter + q], bi = xi[quarter + q], cr = xr[quarter * 2 + q], ci = xi[quarter * 2 + q], dr = xr[quarter * 3 + q], di = xi[quarter * 3 + q];
+                const double apcr = ar + cr, apci = ai + ci, amcr = ar - cr, amci = ai - ci, bpdr = br + dr, bpdi = bi + di, bmdr = br - dr, bmdi = bi - di;
+                const double r2 = apcr - bpdr, i2 = apci - bpdi, ur = amcr + bmdi, ui = amci - bmdr, vr = amcr - bmdi, vi = amci + bmdr;
+                yr[q] = apcr + bpdr;
+                yi[q] = apci + bpdi;
+                yr[stride * 2 + q] = r2 * w2r - i2 * w2i;
+                yi[stride * 2 + q] = r2 * w2i + i2 * w2r;
+                yr[stride * u + q] = ur * wur - ui * wui;
+                yi[stride * u + q] = ur * wui + ui * wur;
+                yr[stride * v + q] = vr * wvr - vi * wvi;
+                yi[stride * v + q] = vr * wvi + vi * wvr;
+            }
+        }
+    }
+
+    static void FFTDoubleRadix2(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int stride) {
+        for (unsigned int q = 0; q < stride; q++) {
+            const double ar = inReal[q], ai = inImag[q], br = inReal[stride + q], bi = inImag[stride + q];
+            outReal[q] = ar + br;
+            outImag[q] = ai + bi;
+            outReal[stride + q] = ar - br;
+            outImag[stride + q] = ai - bi;
+        }
+    }
+
+    // Sums of complex products for the values from first, see SIMD::ComplexMultiplyAccumulate.
+    static void complexMultiplyAccumulate(float **aReal, float **aImag, float **bReal, float **bImag, unsigned int numProducts, float *outReal, float *outImag, unsigned int first, unsigned int numValues) {
+        for (unsigned int n = first; n < numValues; n++) {
+            float r = 0, i = 0;
+            for (unsigned int p = 0; p < numProducts; p++) {
+                r += aReal[p][n] * bReal[p][n] - aImag[p][n] * bImag[p][n];
+                i += aReal[p][n] * bImag[p][n] + aImag[p][n] * bReal[p][n];
+            }
+            outReal[n] = r;
+            outImag[n] = i;
+        }
+    }
+
+    // The DC and Nyquist of FFTReal are real numbers, packed into the first value.
+    static void realFFTPackedFirst(float **aReal, float **aImag, float **bReal, float **bImag, unsigned int numProducts, float *outReal, float *outImag) {
+        float dc = 0, nyquist = 0;
+        for (unsigned int p = 0; p < numProducts; p++) {
+            dc += aReal[p][0] * bReal[p][0];
+            nyquist += aImag[p][0] * bImag[p][0];
+        }
+        outReal[0] = dc;
+        outImag[0] = nyquist;
+    }
+
+    static void ComplexMultiplyAccumulate(float **aReal, float **aImag, float **bReal, float **bImag, unsigned int numProducts, float *outReal, float *outImag, unsigned int numValues, bool realFFTPacking) {
+        complexMultiplyAccumulate(aReal, aImag, bReal, bImag, numProducts, outReal, outImag, 0, numValues);
+        if (realFFTPacking && numValues) realFFTPackedFirst(aReal, aImag, bReal, bImag, numProducts, outReal, outImag);
+    }
+
+    // Complex dot product of the band of one row from first, see SIMD::SparseComplexDotProducts.
+    static inline void sparseComplexDotProduct(const float *inReal, const float *inImag, const float *matrixReal, const float *matrixImag, unsigned int first, unsigned int length, float &real, float &imag) {
+        for (unsigned int n = first; n < length; n++) {
+            real += inReal[n] * matrixReal[n] - inImag[n] * matrixImag[n];
+            imag += inReal[n] * matrixImag[n] + inImag[n] * matrixReal[n];
+        }
+    }
+
+    static void SparseComplexDotProducts(float *inReal, float *inImag, float *matrixReal, float *matrixImag, unsigned int *bandStart, unsigned int *bandLength, unsigned int numRows, float *outReal, float *outImag) {
+        for (unsigned int row = 0; row < numRows; row++) {
+            float real = 0, imag = 0;
+            sparseComplexDotProduct(inReal + bandStart[row], inImag + bandStart[row], matrixReal, matrixImag, 0, bandLength[row], real, imag);
+            outReal[row] = real;
+            outImag[row] = imag;
+            matrixReal += bandLength[row];
+            matrixImag += bandLength[row];
+        }
+    }
+
+    static void shortIntToFloat(short int *input, float *output, unsigned int numberOfValues) {
+        for (unsigned int n = 0; n < numberOfValues; n++) output[n] = float(input[n]) * shortToFloatMul;
+    }
+
+    static void floatToShortInt(float *input, short int *output, unsigned int numberOfValues) {
+        for (unsigned int n = 0; n < numberOfValues; n++) {
+            float v = input[n] * floatToShortMul;
+            if (v > floatToShortMul) v = floatToShortMul; else if (v < -floatToShortMul) v = -floatToShortMul;
+            output[n] = (short int)v;
+        }
+    }
+
+    static void Volume(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames) {
+        if (numberOfFrames) volumeRamp<false>(input, output, volumeStart, (volumeEnd - volumeStart) / float(numberOfFrames), numberOfFrames);
+    }
+
+    static void ChangeVolume(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames) {
+        volumeRamp<false>(input, output, volumeStart, volumeChange, numberOfFrames);
+    }
+
+    static void VolumeAdd(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames) {
+        if (numberOfFrames) volumeRamp<true>(input, output, volumeStart, (volumeEnd - volumeStart) / float(numberOfFrames), numberOfFrames);
+    }
+
+    static void ChangeVolumeAdd(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames) {
+        volumeRamp<true>(input, output, volumeStart, volumeChange, numberOfFrames);
+    }
+
+    static void CrossStereo(float *inputA, float *inputB, float *output, float inputAGainStart, float inputAGainEnd, float inputBGainStart, float inputBGainEnd, unsigned int numberOfFrames) {
+        if (numberOfFrames) crossStereo(inputA, inputB, output, inputAGainStart, (inputAGainEnd - inputAGainStart) / float(numberOfFrames), inputBGainStart, (inputBGainEnd - inputBGainStart) / float(numberOfFrames), numberOfFrames);
+    }
+
+    static void Interleave(float *left, float *right, float *output, unsigned int numberOfFrames) {
+        for (unsigned int n = 0; n < numberOfFrames; n++) {
+            output[n * 2] = left[n];
+            output[n * 2 + 1] = right[n];
+        }
+    }
+
+    static void DeInterleave(float *input, float *left, float *right, unsigned int numberOfFrames) {
+        for (unsigned int n = 0; n < numberOfFrames; n++) {
+            left[n] = input[n * 2];
+            right[n] = input[n * 2 + 1];
+        }
+    }
+
+    static void ShortIntToFloat(short int *input, float *output, unsigned int numberOfFrames, unsigned int numChannels) {
+        shortIntToFloat(input, output, numberOfFrames * numChannels);
+    }
+
+    static void FloatToShortInt(float *input, short int *output, unsigned int numberOfFrames, unsigned int numChannels) {
+        floatToShortInt(input, output, numberOfFrames * numChannels);
+    }
+
+    static void Add1(float *input, float *output, unsigned int numberOfItems) {
+        for (unsigned int n = 0; n < numberOfItems; n++) output[n] += input[n];
+    }
+
+    static void Add2(float *inputA, float *inputB, float *output, unsigned int numberOfItems) {
+        for (unsigned int n = 0; n < numberOfItems; n++) output[n] = inputA[n] + inputB[n];
+    }
+
+    static void Add4(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfItems) {
+        for (unsigned int n = 0; n < numberOfItems; n++) output[n] = inputA[n] + inputB[n] + inputC[n] + inputD[n];
+    }
+
+    static float DotProduct(float *inputA, float *inputB, unsigned int numValues) {
+        float sum = 0;
+        for (unsigned int n = 0; n < numValues; n++) sum += inputA[n] * inputB[n];
+        return sum;
+    }
+
+    static float Peak(float *input, unsigned int numberOfValues) {
+        float peak = 0;
+        for (unsigned int n = 0; n < numberOfValues; n++) {
+            const float v = fabsf(input[n]);
+            if (v > peak) peak = v;
+        }
+        return peak;
+    }
+
+    static const kernelTable table = {
+        Volume, ChangeVolume, VolumeAdd, ChangeVolumeAdd, CrossStereo, Interleave, DeInterleave, ShortIntToFloat, FloatToShortInt, Add1, Add2, Add4, DotProduct, Peak,
+        volumeMultichannel<false, true>, volumeMultichannel<false, false>, volumeMultichannel<true, true>, volumeMultichannel<true, false>,
+        IntToFloatGetPeaks, dither, MixN,
+        FloatToHalf, HalfToFloat, FloatToBFloat16, BFloat16ToFloat,
+        PolyphaseFIR, Biquad2SumOfSquares, TruePeak4x,
+        FFTBatchInterleave, FFTBatchDeInterleave, FFTBatchRadix4, FFTBatchRadix2, FFTBatchRealSplit, FFTMixedRadixStage,
+        FFTDoubleRadix4, FFTDoubleRadix2, ComplexMultiplyAccumulate, SparseComplexDotProducts
+    };
+}
+
+#if SIMD_X86
+
+// The vector paths are compiled with function level target attributes, so this file doesn't need any special compiler flags.
+// MSVC accepts any intrinsic without flags, so the pragmas are needed for GCC and Clang only.
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+namespace sse2 {
+    struct V {
+        typedef __m128 f;
+        static const unsigned int width = 4;
+        static inline f load(const float *p) { return _mm_loadu_ps(p); }
+        static inline void store(float *p, f a) { _mm_storeu_ps(p, a); }
+        static inline f set1(float a) { return _mm_set1_ps(a); }
+        static inline f add(f a, f b) { return _mm_add_ps(a, b); }
+        static inline f sub(f a, f b) { return _mm_sub_ps(a, b); }
+        static inline f mul(f a, f b) { return _mm_mul_ps(a, b); }
+        static inline f mla(f a, f b, f c) { return _mm_add_ps(a, _mm_mul_ps(b, c)); } // a + b * c
+        static inline f min(f a, f b) { return _mm_min_ps(a, b); }
+        static inline f max(f a, f b) { return _mm_max_ps(a, b); }
+        static inline f abs(f a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        static inline float sum(f a) {
+            a = _mm_add_ps(a, _mm_movehl_ps(a, a));
+            return _mm_cvtss_f32(_mm_add_ss(a, _mm_shuffle_ps(a, a, 1)));
+        }
+        static inline float maximum(f a) {
+            a = _mm_max_ps(a, _mm_movehl_ps(a, a));
+            return _mm_cvtss_f32(_mm_max_ss(a, _mm_shuffle_ps(a, a, 1)));
+        }
+        static inline f loadShort(const short int *p) {
+            __m128i i = _mm_loadl_epi64((const __m128i *)p);
+            return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(i, i), 16));
+        }
+        static inline void storeShort(short int *p, f a) {
+            __m128i i = _mm_cvttps_epi32(a);
+            _mm_storel_epi64((__m128i *)p, _mm_packs_epi32(i, i));
+        }
+        static inline void interleave(f a, f b, float *output) {
+            _mm_storeu_ps(output, _mm_unpacklo_ps(a, b));
+            _mm_storeu_ps(output + 4, _mm_unpackhi_ps(a, b));
+        }
+        static inline void deinterleave(const float *input, f &a, f &b) {
+            f x = _mm_loadu_ps(input), y = _mm_loadu_ps(input + 4);
+            a = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+            b = _mm_shuffle_ps(x, y, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+        static inline void transpose4(const float *in0, const float *in1, const float *in2, const float *in3, float *out0, float *out1, float *out2, float *out3) { // out_j[i] = in_i[j]
+            __m128 r0 = _mm_loadu_ps(in0), r1 = _mm_loadu_ps(in1), r2 = _mm_loadu_ps(in2), r3 = _mm_loadu_ps(in3);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(out0, r0);
+            _mm_storeu_ps(out1, r1);
+            _mm_storeu_ps(out2, r2);
+            _mm_storeu_ps(out3, r3);
+        }
+        typedef __m128i i;
+        static inline i loadInt(const int *p) { return _mm_loadu_si128((const __m128i *)p); }
+        static inline void storeInt(int *p, i a) { _mm_storeu_si128((__m128i *)p, a); }
+        static inline i roundToInt(f a) { return _mm_cvtps_epi32(a); }
+        static inline f intToFloat(i a) { return _mm_cvtepi32_ps(a); }
+        static inline void storeShortInt(short int *p, i a) { _mm_storel_epi64((__m128i *)p, _mm_packs_epi32(a, a)); }
+        static inline i xorshift(i &state) {
+            i x = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+            x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+            return state = _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+        }
+        static inline f triangular(i r) {
+            return _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(_mm_and_si128(r, _mm_set1_epi32(0xffff))), _mm_cvtepi32_ps(_mm_srli_epi32(r, 16))), _mm_set1_ps(1.0f / 65536.0f));
+        }
+        static inline i select(i mask, i a, i b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+        // No F16C here: scalar::floatToHalf() and scalar::halfToFloat() with all three cases computed and selected by masks.
+        static inline void storeHalf(unsigned short *p, f a) {
+            const __m128i sign = _mm_and_si128(_mm_srli_epi32(_mm_castps_si128(a), 16), _mm_set1_epi32(0x8000)), x = _mm_and_si128(_mm_castps_si128(a), _mm_set1_epi32(0x7fffffff));
+            const __m128i payload = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(0x3ff)), _mm_set1_epi32(0x200));
+            const __m128i infinityOrNaN = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(_mm_cmpgt_epi32(x, _mm_set1_epi32(0x7f800000)), payload));
+            const __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(x), _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3f000000));
+            const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(x, _mm_set1_epi32((int)0xc8000fff)), _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(1))), 13);
+            __m128i o = select(_mm_cmplt_epi32(x, _mm_set1_epi32(0x38800000)), denormal, normal);
+            o = _mm_or_si128(select(_mm_cmpgt_epi32(x, _mm_set1_epi32(0x477fffff)), infinityOrNaN, o), sign);
+            // The pack saturates signed values, so the 16-bit values are moved into the signed range and back.
+            o = _mm_packs_epi32(_mm_sub_epi32(o, _mm_set1_epi32(0x8000)), _mm_setzero_si128());
+            _mm_storel_epi64((__m128i *)p, _mm_xor_si128(o, _mm_set1_epi16((short)0x8000)));
+        }
+        static inline f loadHalf(const unsigned short *p) {
+            const __m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128());
+            __m128i o = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+            const __m128i exponent = _mm_and_si128(o, _mm_set1_epi32(0x0f800000));
+            o = _mm_add_epi32(o, _mm_set1_epi32(0x38000000));
+            const __m128i infinityOrNaN = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x0f800000));
+            const __m128i quiet = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(o, _mm_set1_epi32(0x007fffff)), _mm_setzero_si128()), _mm_and_si128(infinityOrNaN, _mm_set1_epi32(0x00400000)));
+            o = _mm_or_si128(_mm_add_epi32(o, _mm_and_si128(infinityOrNaN, _mm_set1_epi32(0x38000000))), quiet);
+            const __m128i denormal = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(0x00800000))), _mm_set1_ps(6.103515625e-05f)));
+            o = select(_mm_cmpeq_epi32(exponent, _mm_setzero_si128()), denormal, o);
+            return _mm_castsi128_ps(_mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16)));
+        }
+        static inline void storeBFloat16(unsigned short *p, f a) {
+            const __m128i x = _mm_castps_si128(a);
+            const __m128i rounded = _mm_srai_epi32(_mm_add_epi32(x, _mm_add_epi32(_mm_set1_epi32(0x7fff), _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(1)))), 16);
+            const __m128i o = select(_mm_castps_si128(_mm_cmpunord_ps(a, a)), _mm_or_si128(_mm_srai_epi32(x, 16), _mm_set1_epi32(0x40)), rounded);
+            _mm_storel_epi64((__m128i *)p, _mm_packs_epi32(o, o)); // Arithmetic shifts keep the values in the signed 16-bit range.
+        }
+        static inline f loadBFloat16(const unsigned short *p) { return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), _mm_loadl_epi64((const __m128i *)p))); }
+        static inline f loadInt32(const int *p) { return _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)p)); }
+        static inline f loadInt24(const unsigned char *p) { // Returns with sample << 8. SSE2 has no byte shuffle, so the samples are assembled one by one.
+            return _mm_cvtepi32_ps(_mm_setr_epi32(scalar::int24(p), scalar::int24(p + 3), scalar::int24(p + 6), scalar::int24(p + 9)));
+        }
+    };
+    // Double precision vectors for the double FFT.
+    struct D {
+        typedef __m128d d;
+        static const unsigned int width = 2;
+        static inline d load(const double *p) { return _mm_loadu_pd(p); }
+        static inline void store(double *p, d a) { _mm_storeu_pd(p, a); }
+        static inline d set1(double a) { return _mm_set1_pd(a); }
+        static inline d add(d a, d b) { return _mm_add_pd(a, b); }
+        static inline d sub(d a, d b) { return _mm_sub_pd(a, b); }
+        static inline d mul(d a, d b) { return _mm_mul_pd(a, b); }
+        static inline d mla(d a, d b, d c) { return _mm_add_pd(a, _mm_mul_pd(b, c)); } // a + b * c
+    };
+    #include "SuperpoweredSIMDKernels.h"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2,fma,f16c"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma,f16c")
+#endif
+namespace avx2 {
+    struct V {
+        typedef __m256 f;
+        static const unsigned int width = 8;
+        static inline f load(const float *p) { return _mm256_loadu_ps(p); }
+        static inline void store(float *p, f a) { _mm256_storeu_ps(p, a); }
+        static inline f set1(float a) { return _mm256_set1_ps(a); }
+        static inline f add(f a, f b) { return _mm256_add_ps(a, b); }
+        static inline f sub(f a, f b) { return _mm256_sub_ps(a, b); }
+        static inline f mul(f a, f b) { return _mm256_mul_ps(a, b); }
+        static inline f mla(f a, f b, f c) { return _mm256_fmadd_ps(b, c, a); }
+        static inline f min(f a, f b) { return _mm256_min_ps(a, b); }
+        static inline f max(f a, f b) { return _mm256_max_ps(a, b); }
+        static inline f abs(f a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+        static inline float sum(f a) {
+            __m128 s = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+            return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+        }
+        static inline float maximum(f a) {
+            __m128 s = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            s = _mm_max_ps(s, _mm_movehl_ps(s, s));
+            return _mm_cvtss_f32(_mm_max_ss(s, _mm_shuffle_ps(s, s, 1)));
+        }
+        static inline f loadShort(const short int *p) {
+            return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)p)));
+        }
+        static inline void storeShort(short int *p, f a) {
+            __m256i i = _mm256_cvttps_epi32(a);
+            _mm_storeu_si128((__m128i *)p, _mm_packs_epi32(_mm256_castsi256_si128(i), _mm256_extracti128_si256(i, 1)));
+        }
+        static inline void interleave(f a, f b, float *output) {
+            f lo = _mm256_unpacklo_ps(a, b), hi = _mm256_unpackhi_ps(a, b);
+            _mm256_storeu_ps(output, _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(output + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+        }
+        static inline void deinterleave(const float *input, f &a, f &b) {
+            f x = _mm256_loadu_ps(input), y = _mm256_loadu_ps(input + 8);
+            a = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+            b = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+        static inline void transpose4(const float *in0, const float *in1, const float *in2, const float *in3, float *out0, float *out1, float *out2, float *out3) { sse2::V::transpose4(in0, in1, in2, in3, out0, out1, out2, out3); }
+        typedef __m256i i;
+        static inline i loadInt(const int *p) { return _mm256_loadu_si256((const __m256i *)p); }
+        static inline void storeInt(int *p, i a) { _mm256_storeu_si256((__m256i *)p, a); }
+        static inline i roundToInt(f a) { return _mm256_cvtps_epi32(a); }
+        static inline f intToFloat(i a) { return _mm256_cvtepi32_ps(a); }
+        static inline void storeShortInt(short int *p, i a) { _mm_storeu_si128((__m128i *)p, _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1))); }
+        static inline i xorshift(i &state) {
+            i x = _mm256_xor_si256(state, _mm256_slli_epi32(state, 13));
+            x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+            return state = _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+        }
+        static inline f triangular(i r) {
+            return _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(r, _mm256_set1_epi32(0xffff))), _mm256_cvtepi32_ps(_mm256_srli_epi32(r, 16))), _mm256_set1_ps(1.0f / 65536.0f));
+        }
+        static inline void storeHalf(unsigned short *p, f a) { _mm_storeu_si128((__m128i *)p, _mm256_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT)); }
+        static inline f loadHalf(const unsigned short *p) { return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)p)); }
+        static inline void storeBFloat16(unsigned short *p, f a) {
+            const __m256i x = _mm256_castps_si256(a);
+            __m256i o = _mm256_srai_epi32(_mm256_add_epi32(x, _mm256_add_epi32(_mm256_set1_epi32(0x7fff), _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1)))), 16);
+            o = _mm256_blendv_epi8(o, _mm256_or_si256(_mm256_srai_epi32(x, 16), _mm256_set1_epi32(0x40)), _mm256_castps_si256(_mm256_cmp_ps(a, a, _CMP_UNORD_Q)));
+            _mm_storeu_si128((__m128i *)p, _mm_packs_epi32(_mm256_castsi256_si128(o), _mm256_extracti128_si256(o, 1)));
+        }
+        static inline f loadBFloat16(const unsigned short *p) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)p)), 16)); }
+        static inline f loadInt32(const int *p) { return _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *)p)); }
+        static inline f loadInt24(const unsigned char *p) { // Returns with sample << 8. Reads 32 bytes (8 bytes after the last sample).
+            const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i *)p), _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
+            const __m256i shuffle = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+            return _mm256_cvtepi32_ps(_mm256_shuffle_epi8(bytes, shuffle));
+        }
+    };
+    struct D {
+        typedef __m256d d;
+        static const unsigned int width = 4;
+        static inline d load(const double *p) { return _mm256_loadu_pd(p); }
+        static inline void store(double *p, d a) { _mm256_storeu_pd(p, a); }
+        static inline d set1(double a) { return _mm256_set1_pd(a); }
+        static inline d add(d a, d b) { return _mm256_add_pd(a, b); }
+        static inline d sub(d a, d b) { return _mm256_sub_pd(a, b); }
+        static inline d mul(d a, d b) { return _mm256_mul_pd(a, b); }
+        static inline d mla(d a, d b, d c) { return _mm256_fmadd_pd(b, c, a); }
+    };
+    #include "SuperpoweredSIMDKernels.h"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f,avx2,fma,f16c"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx2,fma,f16c")
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized" // False positives in GCC 12's avx512fintrin.h (_mm512_undefined_ps).
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+namespace avx512 {
+    struct V {
+        typedef __m512 f;
+        static const unsigned int width = 16;
+        static inline f load(const float *p) { return _mm512_loadu_ps(p); }
+        static inline void store(float *p, f a) { _mm512_storeu_ps(p, a); }
+        static inline f set1(float a) { return _mm512_set1_ps(a); }
+        static inline f add(f a, f b) { return _mm512_add_ps(a, b); }
+        static inline f sub(f a, f b) { return _mm512_sub_ps(a, b); }
+        static inline f mul(f a, f b) { return _mm512_mul_ps(a, b); }
+        static inline f mla(f a, f b, f c) { return _mm512_fmadd_ps(b, c, a); }
+        static inline f min(f a, f b) { return _mm512_min_ps(a, b); }
+        static inline f max(f a, f b) { return _mm512_max_ps(a, b); }
+        static inline f abs(f a) { return _mm512_abs_ps(a); }
+        static inline float sum(f a) { return _mm512_reduce_add_ps(a); }
+        static inline float maximum(f a) { return _mm512_reduce_max_ps(a); }
+        static inline f loadShort(const short int *p) {
+            return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)p)));
+        }
+        static inline void storeShort(short int *p, f a) {
+            _mm256_storeu_si256((__m256i *)p, _mm512_cvtsepi32_epi16(_mm512_cvttps_epi32(a)));
+        }
+        static inline void interleave(f a, f b, float *output) {
+            const __m512i lo = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+            const __m512i hi = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+            _mm512_storeu_ps(output, _mm512_permutex2var_ps(a, lo, b));
+            _mm512_storeu_ps(output + 16, _mm512_permutex2var_ps(a, hi, b));
+        }
+        static inline void deinterleave(const float *input, f &a, f &b) {
+            const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+            const __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+            f x = _mm512_loadu_ps(input), y = _mm512_loadu_ps(input + 16);
+            a = _mm512_permutex2var_ps(x, even, y);
+            b = _mm512_permutex2var_ps(x, odd, y);
+        }
+        static inline void transpose4(const float *in0, const float *in1, const float *in2, const float *in3, float *out0, float *out1, float *out2, float *out3) { sse2::V::transpose4(in0, in1, in2, in3, out0, out1, out2, out3); }
+        typedef __m512i i;
+        static inline i loadInt(const int *p) { return _mm512_loadu_si512(p); }
+        static inline void storeInt(int *p, i a) { _mm512_storeu_si512(p, a); }
+        static inline i roundToInt(f a) { return _mm512_cvtps_epi32(a); }
+        static inline f intToFloat(i a) { return _mm512_cvtepi32_ps(a); }
+        static inline void storeShortInt(short int *p, i a) { _mm256_storeu_si256((__m256i *)p, _mm512_cvtsepi32_epi16(a)); }
+        static inline i xorshift(i &state) {
+            i x = _mm512_xor_si512(state, _mm512_slli_epi32(state, 13));
+            x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 17));
+            return state = _mm512_xor_si512(x, _mm512_slli_epi32(x, 5));
+        }
+        static inline f triangular(i r) {
+            return _mm512_mul_ps(_mm512_sub_ps(_mm512_cvtepi32_ps(_mm512_and_si512(r, _mm512_set1_epi32(0xffff))), _mm512_cvtepi32_ps(_mm512_srli_epi32(r, 16))), _mm512_set1_ps(1.0f / 65536.0f));
+        }
+        static inline void storeHalf(unsigned short *p, f a) { _mm256_storeu_si256((__m256i *)p, _mm512_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)); }
+        static inline f loadHalf(const unsigned short *p) { return _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)p)); }
+        static inline void storeBFloat16(unsigned short *p, f a) {
+            const __m512i x = _mm512_castps_si512(a);
+            __m512i o = _mm512_srli_epi32(_mm512_add_epi32(x, _mm512_add_epi32(_mm512_set1_epi32(0x7fff), _mm512_and_si512(_mm512_srli_epi32(x, 16), _mm512_set1_epi32(1)))), 16);
+            o = _mm512_mask_mov_epi32(o, _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q), _mm512_or_si512(_mm512_srli_epi32(x, 16), _mm512_set1_epi32(0x40)));
+            _mm256_storeu_si256((__m256i *)p, _mm512_cvtepi32_epi16(o));
+        }
+        static inline f loadBFloat16(const unsigned short *p) { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)p)), 16)); }
+        static inline f loadInt32(const int *p) { return _mm512_cvtepi32_ps(_mm512_loadu_si512(p)); }
+        static inline f loadInt24(const unsigned char *p) { // Returns with sample << 8. Reads 4 bytes per sample (1 byte after the last sample).
+            const __m512i offsets = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45);
+            return _mm512_cvtepi32_ps(_mm512_slli_epi32(_mm512_i32gather_epi32(offsets, p, 1), 8));
+        }
+    };
+    struct D {
+        typedef __m512d d;
+        static const unsigned int width = 8;
+        static inline d load(const double *p) { return _mm512_loadu_pd(p); }
+        static inline void store(double *p, d a) { _mm512_storeu_pd(p, a); }
+        static inline d set1(double a) { return _mm512_set1_pd(a); }
+        static inline d add(d a, d b) { return _mm512_add_pd(a, b); }
+        static inline d sub(d a, d b) { return _mm512_sub_pd(a, b); }
+        static inline d mul(d a, d b) { return _mm512_mul_pd(a, b); }
+        static inline d mla(d a, d b, d c) { return _mm512_fmadd_pd(b, c, a); }
+    };
+    #include "SuperpoweredSIMDKernels.h"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+#endif
+
+static void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int *regs) {
+#if defined(_MSC_VER)
+    __cpuidex((int *)regs, (int)leaf, (int)subleaf);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Which register states the operating system saves on context switches.
+static unsigned long long xgetbv() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int lo, hi;
+    __asm__ __volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+    return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+
+static Path detectBestPath() {
+    unsigned int regs[4];
+    cpuid(0, 0, regs);
+    const unsigned int maxLeaf = regs[0];
+    if (maxLeaf < 1) return Path_Scalar;
+
+    cpuid(1, 0, regs);
+    if (!(regs[3] & (1 << 26))) return Path_Scalar; // SSE2
+    const bool osxsave = (regs[2] & (1 << 27)) != 0, avx = (regs[2] & (1 << 28)) != 0, fma = (regs[2] & (1 << 12)) != 0, f16c = (regs[2] & (1 << 29)) != 0;
+    if (!osxsave || !avx || !fma || !f16c || (maxLeaf < 7)) return Path_SSE2;
+
+    const unsigned long long xcr0 = xgetbv();
+    if ((xcr0 & 0x6) != 0x6) return Path_SSE2; // The OS doesn't save the YMM registers.
+
+    cpuid(7, 0, regs);
+    if (!(regs[1] & (1 << 5))) return Path_SSE2; // AVX2
+    if (!(regs[1] & (1 << 16)) || ((xcr0 & 0xe6) != 0xe6)) return Path_AVX2; // AVX-512 F, opmask and ZMM state.
+    return Path_AVX512;
+}
+
+static const kernelTable *tables[4] = { &scalar::table, &sse2::table, &avx2::table, &avx512::table };
+
+#else
+
+static Path detectBestPath() {
+    return Path_Scalar;
+}
+
+static const kernelTable *tables[4] = { &scalar::table, &scalar::table, &scalar::table, &scalar::table };
+
+#endif
+
+static std::atomic<const kernelTable *> activeTable(nullptr);
+static std::atomic<int> activePath(Path_Scalar);
+
+Path BestPath() {
+    static const Path best = detectBestPath();
+    return best;
+}
+
+bool SetPath(Path path) {
+    if ((path < Path_Scalar) || (path > BestPath())) return false;
+    activePath.store(path);
+    activeTable.store(tables[path]);
+    return true;
+}
+
+static inline const kernelTable *kernels() {
+    const kernelTable *table = activeTable.load(std::memory_order_acquire);
+    if (table) return table;
+    SetPath(BestPath());
+    return activeTable.load(std::memory_order_acquire);
+}
+
+Path ActivePath() {
+    kernels();
+    return (Path)activePath.load();
+}
+
+const char *PathToString(Path path) {
+    switch (path) {
+        case Path_Scalar: return "scalar";
+        case Path_SSE2: return "sse2";
+        case Path_AVX2: return "avx2";
+        case Path_AVX512: return "avx512";
+        default: return "unknown";
+    }
+}
+
+void Volume(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames) {
+    kernels()->Volume(input, output, volumeStart, volumeEnd, numberOfFrames);
+}
+
+void ChangeVolume(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames) {
+    kernels()->ChangeVolume(input, output, volumeStart, volumeChange, numberOfFrames);
+}
+
+void VolumeAdd(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames) {
+    kernels()->VolumeAdd(input, output, volumeStart, volumeEnd, numberOfFrames);
+}
+
+void ChangeVolumeAdd(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames) {
+    kernels()->ChangeVolumeAdd(input, output, volumeStart, volumeChange, numberOfFrames);
+}
+
+void CrossStereo(float *inputA, float *inputB, float *output, float inputAGainStart, float inputAGainEnd, float inputBGainStart, float inputBGainEnd, unsigned int numberOfFrames) {
+    kernels()->CrossStereo(inputA, inputB, output, inputAGainStart, inputAGainEnd, inputBGainStart, inputBGainEnd, numberOfFrames);
+}
+
+void Interleave(float *left, float *right, float *output, unsigned int numberOfFrames) {
+    kernels()->Interleave(left, right, output, numberOfFrames);
+}
+
+void DeInterleave(float *input, float *left, float *right, unsigned int numberOfFrames) {
+    kernels()->DeInterleave(input, left, right, numberOfFrames);
+}
+
+void ShortIntToFloat(short int *input, float *output, unsigned int numberOfFrames, unsigned int numChannels) {
+    kernels()->ShortIntToFloat(input, output, numberOfFrames, numChannels);
+}
+
+void FloatToShortInt(float *input, short int *output, unsigned int numberOfFrames, unsigned int numChannels) {
+    kernels()->FloatToShortInt(input, output, numberOfFrames, numChannels);
+}
+
+void Add1(float *input, float *output, unsigned int numberOfItems) {
+    kernels()->Add1(input, output, numberOfItems);
+}
+
+void Add2(float *inputA, float *inputB, float *output, unsigned int numberOfItems) {
+    kernels()->Add2(inputA, inputB, output, numberOfItems);
+}
+
+void Add4(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfItems) {
+    kernels()->Add4(inputA, inputB, inputC, inputD, output, numberOfItems);
+}
+
+float DotProduct(float *inputA, float *inputB, unsigned int numValues) {
+    return kernels()->DotProduct(inputA, inputB, numValues);
+}
+
+float Peak(float *input, unsigned int numberOfValues) {
+    return kernels()->Peak(input, numberOfValues);
+}
+
+void MixN(float **inputs, unsigned int numInputs, float *output, float *gainStart, float *gainEnd, unsigned int numberOfFrames, unsigned int numChannels, bool addToOutput, float *peak) {
+    const float p = kernels()->MixN(inputs, numInputs, output, gainStart, gainEnd, numberOfFrames, numChannels, addToOutput);
+    if (peak) *peak = p;
+}
+
+void AddN(float **inputs, unsigned int numInputs, float *output, unsigned int numberOfItems) {
+    kernels()->MixN(inputs, numInputs, output, 0, 0, numberOfItems, 1, false);
+}
+
+void FloatToHalf(float *input, unsigned short *output, unsigned int numberOfValues) {
+    kernels()->FloatToHalf(input, output, numberOfValues);
+}
+
+void HalfToFloat(unsigned short *input, float *output, unsigned int numberOfValues) {
+    kernels()->HalfToFloat(input, output, numberOfValues);
+}
+
+void FloatToBFloat16(float *input, unsigned short *output, unsigned int numberOfValues) {
+    kernels()->FloatToBFloat16(input, output, numberOfValues);
+}
+
+void BFloat16ToFloat(unsigned short *input, float *output, unsigned int numberOfValues) {
+    kernels()->BFloat16ToFloat(input, output, numberOfValues);
+}
+
+void PolyphaseFIR(float **inputs, unsigned int numChannels, float *coefficients, float *deltas, float fraction, unsigned int numTaps, float *output) {
+    kernels()->PolyphaseFIR(inputs, numChannels, coefficients, deltas, fraction, numTaps, output);
+}
+
+void Biquad2SumOfSquares(float *input, unsigned int numberOfFrames, unsigned int numChannels, float *coefficients, float *state, float *sumOfSquares) {
+    kernels()->Biquad2SumOfSquares(input, numberOfFrames, numChannels, coefficients, state, sumOfSquares);
+}
+
+float TruePeak4x(float *input, unsigned int numberOfFrames, float *framePeaks) {
+    return kernels()->TruePeak4x(input, numberOfFrames, framePeaks);
+}
+
+void FFTBatchInterleave(float **inputs, unsigned int numValues, float *output) {
+    kernels()->FFTBatchInterleave(inputs, numValues, output);
+}
+
+void FFTBatchDeInterleave(float *input, float **outputs, unsigned int numValues) {
+    kernels()->FFTBatchDeInterleave(input, outputs, numValues);
+}
+
+void FFTBatchRadix4(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, float *twiddles, unsigned int twiddleStride, bool forward) {
+    kernels()->FFTBatchRadix4(inReal, inImag, outReal, outImag, n, stride, twiddles, twiddleStride, forward);
+}
+
+void FFTBatchRadix2(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int stride) {
+    kernels()->FFTBatchRadix2(inReal, inImag, outReal, outImag, stride);
+}
+
+void FFTBatchRealSplit(float *real, float *imag, unsigned int half, float *twiddles, bool forward) {
+    kernels()->FFTBatchRealSplit(real, imag, half, twiddles, forward);
+}
+
+void FFTMixedRadixStage(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, unsigned int radix, float *twiddles, bool forward) {
+    kernels()->FFTMixedRadixStage(inReal, inImag, outReal, outImag, n, stride, radix, twiddles, forward);
+}
+
+void FFTDoubleRadix4(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int n, unsigned int stride, double *twiddles, unsigned int twiddleStride, bool forward) {
+    kernels()->FFTDoubleRadix4(inReal, inImag, outReal, outImag, n, stride, twiddles, twiddleStride, forward);
+}
+
+void FFTDoubleRadix2(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int stride) {
+    kernels()->FFTDoubleRadix2(inReal, inImag, outReal, outImag, stride);
+}
+
+void ComplexMultiplyAccumulate(float **aReal, float **aImag, float **bReal, float **bImag, unsigned int numProducts, float *outReal, float *outImag, unsigned int numValues, bool realFFTPacking) {
+    kernels()->ComplexMultiplyAccumulate(aReal, aImag, bReal, bImag, numProducts, outReal, outImag, numValues, realFFTPacking);
+}
+
+void SparseComplexDotProducts(float *inReal, float *inImag, float *matrixReal, float *matrixImag, unsigned int *bandStart, unsigned int *bandLength, unsigned int numRows, float *outReal, float *outImag) {
+    kernels()->SparseComplexDotProducts(inReal, inImag, matrixReal, matrixImag, bandStart, bandLength, numRows, outReal, outImag);
+}
+
+void VolumeMultichannel(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfFrames, unsigned int numChannels) {
+    kernels()->VolumeMultichannel(input, output, volumeStart, volumeEnd, numberOfFrames, numChannels);
+}
+
+void ChangeVolumeMultichannel(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfFrames, unsigned int numChannels) {
+    kernels()->ChangeVolumeMultichannel(input, output, volumeStart, volumeChange, numberOfFrames, numChannels);
+}
+
+void VolumeAddMultichannel(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfFrames, unsigned int numChannels) {
+    kernels()->VolumeAddMultichannel(input, output, volumeStart, volumeEnd, numberOfFrames, numChannels);
+}
+
+void ChangeVolumeAddMultichannel(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfFrames, unsigned int numChannels) {
+    kernels()->ChangeVolumeAddMultichannel(input, output, volumeStart, volumeChange, numberOfFrames, numChannels);
+}
+
+void IntToFloatGetPeaks(void *input, SampleFormat format, float *output, unsigned int numberOfFrames, unsigned int numChannels, float volumeStart, float volumeEnd, float *peaks, float *rms) {
+    kernels()->IntToFloatGetPeaks(input, format, output, numberOfFrames, numChannels, volumeStart, volumeEnd, peaks, rms);
+}
+
+// The planar functions run the interleaved kernels on every channel as a mono (1 channel) buffer.
+void Volume(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeEnd) {
+    const kernelTable *k = kernels();
+    for (unsigned int ch = 0; ch < output.numChannels; ch++) k->VolumeMultichannel(input.channel(ch), output.channel(ch), &volumeStart, &volumeEnd, output.numberOfFrames, 1);
+}
+
+void ChangeVolume(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeChange) {
+    const kernelTable *k = kernels();
+    for (unsigned int ch = 0; ch < output.numChannels; ch++) k->ChangeVolumeMultichannel(input.channel(ch), output.channel(ch), &volumeStart, &volumeChange, output.numberOfFrames, 1);
+}
+
+void VolumeAdd(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeEnd) {
+    const kernelTable *k = kernels();
+    for (unsigned int ch = 0; ch < output.numChannels; ch++) k->VolumeAddMultichannel(input.channel(ch), output.channel(ch), &volumeStart, &volumeEnd, output.numberOfFrames, 1);
+}
+
+void ChangeVolumeAdd(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeChange) {
+    const kernelTable *k = kernels();
+    for (unsigned int ch = 0; ch < output.numChannels; ch++) k->ChangeVolumeAddMultichannel(input.channel(ch), output.channel(ch), &volumeStart, &volumeChange, output.numberOfFrames, 1);
+}
+
+void CrossStereo(const PlanarBuffer &inputA, const PlanarBuffer &inputB, const PlanarBuffer &output, float inputAGainStart, float inputAGainEnd, float inputBGainStart, float inputBGainEnd) {
+    const kernelTable *k = kernels();
+    for (unsigned int ch = 0; ch < output.numChannels; ch++) {
+        float *a = inputA.channel(ch), *b = inputB.channel(ch), *o = output.channel(ch);
+        // The input sharing memory with the output is scaled first, so in-place processing works for both inputs.
+        if (o == b) {
+            k->VolumeMultichannel(b, o, &inputBGainStart, &inputBGainEnd, output.numberOfFrames, 1);
+            k->VolumeAddMultichannel(a, o, &inputAGainStart, &inputAGainEnd, output.numberOfFrames, 1);
+        } else {
+            k->VolumeMultichannel(a, o, &inputAGainStart, &inputAGainEnd, output.numberOfFrames, 1);
+            k->VolumeAddMultichannel(b, o, &inputBGainStart, &inputBGainEnd, output.numberOfFrames, 1);
+        }
+    }
+}
+
+void Interleave(const PlanarBuffer &input, float *output) {
+    if (input.numChannels == 2) kernels()->Interleave(input.channel(0), input.channel(1), output, input.numberOfFrames);
+    else for (unsigned int ch = 0; ch < input.numChannels; ch++) {
+        float *in = input.channel(ch), *out = output + ch;
+        for (unsigned int n = 0; n < input.numberOfFrames; n++, out += input.numChannels) *out = in[n];
+    }
+}
+
+void DeInterleave(float *input, const PlanarBuffer &output) {
+    if (output.numChannels == 2) kernels()->DeInterleave(input, output.channel(0), output.channel(1), output.numberOfFrames);
+    else for (unsigned int ch = 0; ch < output.numChannels; ch++) {
+        float *in = input + ch, *out = output.channel(ch);
+        for (unsigned int n = 0; n < output.numberOfFrames; n++, in += output.numChannels) out[n] = *in;
+    }
+}
+
+void Add1(const PlanarBuffer &input, const PlanarBuffer &output) {
+    const kernelTable *k = kernels();
+    for (unsigned int ch = 0; ch < output.numChannels; ch++) k->Add1(input.channel(ch), output.channel(ch), output.numberOfFrames);
+}
+
+float Peak(const PlanarBuffer &input) {
+    const kernelTable *k = kernels();
+    float peak = 0;
+    for (unsigned int ch = 0; ch < input.numChannels; ch++) {
+        const float p = k->Peak(input.channel(ch), input.numberOfFrames);
+        if (p > peak) peak = p;
+    }
+    return peak;
+}
+
+Dither::Dither(unsigned int numChannels, Mode mode, unsigned int seed) {
+    internals = new ditherInternals;
+    internals->numChannels = numChannels;
+    internals->mode = mode;
+    internals->random = new unsigned int[numChannels > 16 ? numChannels : 16];
+    internals->error = new float[numChannels * 5];
+
+    // Spread the seed over the generators (splitmix32 style). xorshift32 must never start from 0.
+    for (unsigned int n = 0, count = numChannels > 16 ? numChannels : 16; n < count; n++) {
+        unsigned int x = seed + n * 0x9e3779b9;
+        x = (x ^ (x >> 16)) * 0x85ebca6b;
+        x = (x ^ (x >> 13)) * 0xc2b2ae35;
+        x ^= x >> 16;
+        internals->random[n] = x ? x : 0x6b43a9b5;
+    }
+    reset();
+}
+
+Dither::~Dither() {
+    delete[] internals->random;
+    delete[] internals->error;
+    delete internals;
+}
+
+void Dither::reset() {
+    internals->head = 0;
+    for (unsigned int n = 0; n < internals->numChannels * 5; n++) internals->error[n] = 0;
+}
+
+void Dither::processShortInt(float *input, short int *output, unsigned int numberOfFrames) {
+    kernels()->dither(internals, input, output, numberOfFrames, false);
+}
+
+void Dither::process24bit(float *input, void *output, unsigned int numberOfFrames) {
+    kernels()->dither(internals, input, output, numberOfFrames, true);
+}
+
+}
+}
@@ -0,0 +1,550 @@
+#ifndef Header_SuperpoweredSIMD
+#define Header_SuperpoweredSIMD
+
+/// @file SuperpoweredSIMD.h
+/// @brief Runtime CPU dispatched versions of the SuperpoweredSimple.h kernels.
+/// Every function picks the widest instruction set available on the current CPU (SSE2, AVX2+FMA or AVX-512) on the first call. Results are the same as the SuperpoweredSimple.h functions with the same name.
+/// On non-x86 CPUs a portable C++ implementation is used.
+
+namespace Superpowered {
+namespace SIMD {
+
+/// @brief Instruction set (code path) used by the kernels.
+typedef enum Path {
+    Path_Scalar = 0, ///< Portable C++, no explicit vectorization.
+    Path_SSE2 = 1,   ///< 128-bit SSE2.
+    Path_AVX2 = 2,   ///< 256-bit AVX2 with FMA and F16C.
+    Path_AVX512 = 3  ///< 512-bit AVX-512 (F).
+} Path;
+
+/// @brief Integer sample formats for IntToFloatGetPeaks().
+typedef enum SampleFormat {
+    SampleFormat_Int16 = 0, ///< 16-bit signed integer (short int). Same scaling as ShortIntToFloat().
+    SampleFormat_Int24 = 1, ///< Packed 24-bit signed integer, 3 bytes per sample, little endian. Same scaling as Superpowered::Bit24ToFloat().
+    SampleFormat_Int32 = 2  ///< 32-bit signed integer. Same scaling as Superpowered::IntToFloat().
+} SampleFormat;
+
+/// @fn BestPath();
+/// @return Returns with the widest path supported by the CPU and the operating system.
+Path BestPath();
+
+/// @fn ActivePath();
+/// @return Returns with the path currently used by the kernels.
+Path ActivePath();
+
+/// @fn SetPath(Path path);
+/// @brief Forces a specific path, for benchmarking or testing. Don't call it concurrently with the kernels.
+/// @return Returns with false if the path is not supported by the CPU. The active path doesn't change in this case.
+/// @param path The path to use.
+bool SetPath(Path path);
+
+/// @fn PathToString(Path path);
+/// @return Returns with a human readable name of the path, such as "avx2".
+/// @param path The path.
+const char *PathToString(Path path);
+
+/// @fn Volume(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames);
+/// @brief Applies volume on a single stereo interleaved buffer: output = input * gain
+/// @param input Pointer to floating point numbers. 32-bit interleaved stereo input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved stereo output. Can be equal to input (in-place processing).
+/// @param volumeStart Volume for the first frame.
+/// @param volumeEnd Volume for the last frame. Volume will be smoothly calculated between the first and last frames.
+/// @param numberOfFrames The number of frames to process.
+void Volume(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames);
+
+/// @fn ChangeVolume(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames);
+/// @brief Applies volume on a single stereo interleaved buffer: output = input * gain
+/// @param input Pointer to floating point numbers. 32-bit interleaved stereo input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved stereo output. Can be equal to input (in-place processing).
+/// @param volumeStart Volume for the first frame.
+/// @param volumeChange Change volume by this amount for every frame.
+/// @param numberOfFrames The number of frames to process.
+void ChangeVolume(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames);
+
+/// @fn VolumeAdd(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames);
+/// @brief Applies volume on a single stereo interleaved buffer and adds it to the audio in the output buffer: output = output + input * gain
+/// @param input Pointer to floating point numbers. 32-bit interleaved stereo input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved stereo output.
+/// @param volumeStart Volume for the first frame.
+/// @param volumeEnd Volume for the last frame. Volume will be smoothly calculated between the first and last frames.
+/// @param numberOfFrames The number of frames to process.
+void VolumeAdd(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames);
+
+/// @fn ChangeVolumeAdd(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames);
+/// @brief Applies volume on a single stereo interleaved buffer and adds it to the audio in the output buffer: output = output + input * gain
+/// @param input Pointer to floating point numbers. 32-bit interleaved stereo input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved stereo output.
+/// @param volumeStart Volume for the first frame.
+/// @param volumeChange Change volume by this amount for every frame.
+/// @param numberOfFrames The number of frames to process.
+void ChangeVolumeAdd(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames);
+
+/// @fn CrossStereo(float *inputA, float *inputB, float *output, float inputAGainStart, float inputAGainEnd, float inputBGainStart, float inputBGainEnd, unsigned int numberOfFrames);
+/// @brief Crossfades two stereo inputs into a stereo output: output = inputA * gain + inputB + gain
+/// @param inputA Pointer to floating point numbers. Interleaved stereo input (first).
+/// @param inputB Pointer to floating point numbers. Interleaved stereo input (second).
+/// @param output Pointer to floating point numbers. Interleaved stereo output. Can be equal with one of the inputs (in-place processing).
+/// @param inputAGainStart Gain of the first sample on the first input.
+/// @param inputAGainEnd Gain for the last sample on the first input. Gain will be smoothly calculated between start end end.
+/// @param inputBGainStart Gain of the first sample on the second input.
+/// @param inputBGainEnd Gain for the last sample on the second input. Gain will be smoothly calculated between start end end.
+/// @param numberOfFrames The number of frames to process.
+void CrossStereo(float *inputA, float *inputB, float *output, float inputAGainStart, float inputAGainEnd, float inputBGainStart, float inputBGainEnd, unsigned int numberOfFrames);
+
+/// @fn Interleave(float *left, float *right, float *output, unsigned int numberOfFrames);
+/// @brief Makes an interleaved stereo output from two mono input channels: output = [L, R, L, R, ...]
+/// @param left Pointer to floating point numbers. Mono input for left channel.
+/// @param right Pointer to floating point numbers. Mono input for right channel.
+/// @param output Pointer to floating point numbers. Stereo interleaved output.
+/// @param numberOfFrames The number of frames to process.
+void Interleave(float *left, float *right, float *output, unsigned int numberOfFrames);
+
+/// @fn DeInterleave(float *input, float *left, float *right, unsigned int numberOfFrames);
+/// @brief Deinterleaves an interleaved stereo input to two mono output channels: left = [L, L, L, L, ...], right = [R, R, R, R, ...]
+/// @param input Pointer to floating point numbers. Stereo interleaved input.
+/// @param left Pointer to floating point numbers. Mono output for left channel.
+/// @param right Pointer to floating point numbers. Mono output for right channel.
+/// @param numberOfFrames The number of frames to process.
+void DeInterleave(float *input, float *left, float *right, unsigned int numberOfFrames);
+
+/// @fn ShortIntToFloat(short int *input, float *output, unsigned int numberOfFrames, unsigned int numChannels);
+/// @brief Converts 16-bit signed integer input to 32-bit float output.
+/// @param input Pointer to short integer numbers. Interleaved 16-bit input.
+/// @param output Pointer to floating point numbers. Interleaved 32-bit output.
+/// @param numberOfFrames The number of frames to process.
+/// @param numChannels The number of channels.
+void ShortIntToFloat(short int *input, float *output, unsigned int numberOfFrames, unsigned int numChannels = 2);
+
+/// @fn FloatToShortInt(float *input, short int *output, unsigned int numberOfFrames, unsigned int numChannels);
+/// @brief Converts 32-bit float input to 16-bit signed integer output.
+/// @param input Pointer to floating point numbers. 32-bit input.
+/// @param output Pointer to short integer numbers. 16-bit output.
+/// @param numberOfFrames The number of frames to process.
+/// @param numChannels The number of channels.
+void FloatToShortInt(float *input, short int *output, unsigned int numberOfFrames, unsigned int numChannels = 2);
+
+/// @fn Add1(float *input, float *output, unsigned int numberOfItems)
+/// @brief Adds the values in input to the values in output: output[n] += input[n]
+/// @param input Pointer to floating point numbers. Input data.
+/// @param output Pointer to floating point numbers. Output data.
+/// @param numberOfItems The length of input.
+void Add1(float *input, float *output, unsigned int numberOfItems);
+
+/// @fn Add2(float *inputA, float *inputB, float *output, unsigned int numberOfItems)
+/// @brief Adds the values in two inputs: output[n] = inputA[n] + inputB[n]
+/// @param inputA Pointer to floating point numbers. Input data.
+/// @param inputB Pointer to floating point numbers. Input data.
+/// @param output Pointer to floating point numbers. Output data.
+/// @param numberOfItems The length of input.
+void Add2(float *inputA, float *inputB, float *output, unsigned int numberOfItems);
+
+/// @fn Add4(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfItems)
+/// @brief Adds the values in four inputs: output[n] = inputA[n] + inputB[n] + inputC[n] + inputD[n]
+/// @param inputA Pointer to floating point numbers. Input data.
+/// @param inputB Pointer to floating point numbers. Input data.
+/// @param inputC Pointer to floating point numbers. Input data.
+/// @param inputD Pointer to floating point numbers. Input data.
+/// @param output Pointer to floating point numbers. Output data.
+/// @param numberOfItems The length of input.
+void Add4(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfItems);
+
+/// @fn DotProduct(float *inputA, float *inputB, unsigned int numValues)
+/// @brief Calculates the dot product of two vectors.
+/// @param inputA Pointer to floating point numbers. First input vector.
+/// @param inputB Pointer to floating point numbers. Second input vector.
+/// @param numValues Number of value pairs to process.
+/// @return The dot product.
+float DotProduct(float *inputA, float *inputB, unsigned int numValues);
+
+/// @fn Peak(float *input, unsigned int numberOfValues);
+/// @return Returns the peak absolute value. Useful for metering.
+/// @param input Pointer to floating point numbers.
+/// @param numberOfValues The number of values to process. For a stereo input this value should be 2 * numberOfFrames. Unlike Superpowered::Peak(), any value is accepted.
+float Peak(float *input, unsigned int numberOfValues);
+
+/// @fn MixN(float **inputs, unsigned int numInputs, float *output, float *gainStart, float *gainEnd, unsigned int numberOfFrames, unsigned int numChannels, bool addToOutput, float *peak);
+/// @brief Mixes any number of interleaved inputs with separate gain ramps: output = inputs[0] * gain[0] + inputs[1] * gain[1] + ...
+/// The inputs are summed in cache-sized tiles, so the output is written only once, regardless of the number of inputs.
+/// @param inputs Pointers to the inputs. Every input is interleaved with numChannels channels.
+/// @param numInputs The number of inputs. With 0 inputs the output is cleared (or left unchanged if addToOutput is true).
+/// @param output Pointer to floating point numbers. Interleaved output with numChannels channels. Can be equal to one of the inputs (in-place processing).
+/// @param gainStart Pointer to floating point numbers. Gain for the first frame, one value per input. NULL means unity gain for every input.
+/// @param gainEnd Pointer to floating point numbers. Gain for the last frame, one value per input. Gain will be smoothly calculated between the first and last frames. NULL means constant gain (gainStart).
+/// @param numberOfFrames The number of frames to process.
+/// @param numChannels The number of channels.
+/// @param addToOutput If true, the mix is added to the audio in output: output = output + inputs[0] * gain[0] + ...
+/// @param peak If not NULL, receives the peak absolute value of the output.
+void MixN(float **inputs, unsigned int numInputs, float *output, float *gainStart, float *gainEnd, unsigned int numberOfFrames, unsigned int numChannels = 2, bool addToOutput = false, float *peak = 0);
+
+/// @fn AddN(float **inputs, unsigned int numInputs, float *output, unsigned int numberOfItems)
+/// @brief Adds the values in any number of inputs: output[n] = inputs[0][n] + inputs[1][n] + ...
+/// @param inputs Pointers to the inputs.
+/// @param numInputs The number of inputs.
+/// @param output Pointer to floating point numbers. Output data.
+/// @param numberOfItems The length of every input.
+void AddN(float **inputs, unsigned int numInputs, float *output, unsigned int numberOfItems);
+
+/// @fn FloatToHalf(float *input, unsigned short *output, unsigned int numberOfValues);
+/// @brief Converts 32-bit float to IEEE 754 half precision (fp16), rounding to nearest even. Halves the memory of float audio, with 11 bits of precision and much more headroom than 16-bit integer. Values above 65504 become infinity.
+/// @param input Pointer to floating point numbers. 32-bit input.
+/// @param output Pointer to 16-bit half precision numbers.
+/// @param numberOfValues The number of values to convert. For a stereo input this value should be 2 * numberOfFrames.
+void FloatToHalf(float *input, unsigned short *output, unsigned int numberOfValues);
+
+/// @fn HalfToFloat(unsigned short *input, float *output, unsigned int numberOfValues);
+/// @brief Converts IEEE 754 half precision (fp16) to 32-bit float. Exact.
+/// @param input Pointer to 16-bit half precision numbers.
+/// @param output Pointer to floating point numbers. 32-bit output.
+/// @param numberOfValues The number of values to convert.
+void HalfToFloat(unsigned short *input, float *output, unsigned int numberOfValues);
+
+/// @fn FloatToBFloat16(float *input, unsigned short *output, unsigned int numberOfValues);
+/// @brief Converts 32-bit float to bfloat16 (the upper 16 bits of a float), rounding to nearest even. Same range as float with 8 bits of precision.
+/// @param input Pointer to floating point numbers. 32-bit input.
+/// @param output Pointer to 16-bit bfloat16 numbers.
+/// @param numberOfValues The number of values to convert.
+void FloatToBFloat16(float *input, unsigned short *output, unsigned int numberOfValues);
+
+/// @fn BFloat16ToFloat(unsigned short *input, float *output, unsigned int numberOfValues);
+/// @brief Converts bfloat16 to 32-bit float. Exact.
+/// @param input Pointer to 16-bit bfloat16 numbers.
+/// @param output Pointer to floating point numbers. 32-bit output.
+/// @param numberOfValues The number of values to convert.
+void BFloat16ToFloat(unsigned short *input, float *output, unsigned int numberOfValues);
+
+/// @fn PolyphaseFIR(float **inputs, unsigned int numChannels, float *coefficients, float *deltas, float fraction, unsigned int numTaps, float *output);
+/// @brief Computes one output frame of a polyphase FIR filter for every channel, with the coefficients linearly interpolated between two adjacent filter phases: output[ch] = sum(inputs[ch][k] * (coefficients[k] + deltas[k] * fraction))
+/// Used by PolyphaseResampler. Channels are processed in groups of 4 sharing the interpolated coefficients.
+/// @param inputs Pointers to the first input sample of every channel. Every channel needs numTaps contiguous samples.
+/// @param numChannels The number of channels.
+/// @param coefficients Pointer to floating point numbers. Coefficients of the first phase, numTaps values.
+/// @param deltas Pointer to floating point numbers. Coefficients of the next phase minus coefficients, numTaps values.
+/// @param fraction Position between the two phases (0 to 1).
+/// @param numTaps The number of filter taps.
+/// @param output Pointer to floating point numbers. One interleaved output frame, numChannels values.
+void PolyphaseFIR(float **inputs, unsigned int numChannels, float *coefficients, float *deltas, float fraction, unsigned int numTaps, float *output);
+
+/// @fn Biquad2SumOfSquares(float *input, unsigned int numberOfFrames, unsigned int numChannels, float *coefficients, float *state, float *sumOfSquares);
+/// @brief Filters every channel of an interleaved input with two cascaded biquad filters and adds the sum of squares of the filtered audio to sumOfSquares. The filtered audio is not stored. Used by LoudnessMeter for K-weighting.
+/// Groups of channels as many as the vector width are processed in parallel vector lanes. The remaining channels (mono and stereo on every path) are processed in blocks of frames as wide as a vector, where the output of a block is computed from the responses of the filter to the input and the state, so the recursion runs once per block. Buffers shorter than 8 vectors of frames use the scalar path for them.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input.
+/// @param numberOfFrames The number of frames to process.
+/// @param numChannels The number of channels.
+/// @param coefficients Pointer to 10 floating point numbers: b0, b1, b2, a1, a2 of the first filter, then the second filter. a0 is 1.
+/// @param state Pointer to floating point numbers, 4 * numChannels big. Filter state (z1 and z2 of the first filter, then the second, numChannels values each). Set to zero before the first call.
+/// @param sumOfSquares Pointer to floating point numbers, numChannels big. The sums are added to these values.
+void Biquad2SumOfSquares(float *input, unsigned int numberOfFrames, unsigned int numChannels, float *coefficients, float *state, float *sumOfSquares);
+
+/// @fn TruePeak4x(float *input, unsigned int numberOfFrames, float *framePeaks);
+/// @brief Measures the true peak of a single channel with the 4x oversampling interpolation filter of ITU-R BS.1770-4 Annex 2. Used by TruePeakMeter.
+/// @return Returns the peak absolute value of the oversampled signal, which includes the samples. Unlike Peak(), it catches inter-sample peaks above the sample values.
+/// @param input Pointer to floating point numbers. Mono input. The 11 values before input[0] are read too, they should be the previous samples of the channel (or zeros).
+/// @param numberOfFrames The number of frames to process.
+/// @param framePeaks Pointer to floating point numbers, numberOfFrames big. If not NULL, framePeaks[n] is set to the maximum of framePeaks[n] and the true peak between frames n - 6 and n - 5 (the filter delay), so the detector of several channels can be combined. Can be NULL.
+float TruePeak4x(float *input, unsigned int numberOfFrames, float *framePeaks = 0);
+
+/// @fn FFTBatchInterleave(float **inputs, unsigned int numValues, float *output);
+/// @brief Interleaves 16 buffers for the batched FFT kernels: output[n * 16 + t] = inputs[t][n]. Used by BatchFFT.
+/// @param inputs Pointers to 16 input buffers, numValues floating point numbers each.
+/// @param numValues The number of values in every input. Should be a multiple of 4.
+/// @param output Pointer to floating point numbers, 16 * numValues big.
+void FFTBatchInterleave(float **inputs, unsigned int numValues, float *output);
+
+/// @fn FFTBatchDeInterleave(float *input, float **outputs, unsigned int numValues);
+/// @brief The opposite of FFTBatchInterleave: outputs[t][n] = input[n * 16 + t]. Used by BatchFFT.
+/// @param input Pointer to floating point numbers, 16 * numValues big.
+/// @param outputs Pointers to 16 output buffers, numValues floating point numbers each.
+/// @param numValues The number of values in every output. Should be a multiple of 4.
+void FFTBatchDeInterleave(float *input, float **outputs, unsigned int numValues);
+
+/// @fn FFTBatchRadix4(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, float *twiddles, unsigned int twiddleStride, bool forward);
+/// @brief One radix-4 Stockham autosort stage of 16 interleaved complex FFTs (see FFTBatchInterleave). Used by BatchFFT.
+/// Every sub-transform of n points is split into 4 of n / 4 points: y[q + stride * (4p + r)] = W^(r * p) * sum(x[q + stride * (p + j * n / 4)] * W4^(r * j)), W = e^(-i * 2 * pi / n) for the forward and e^(i * 2 * pi / n) for the inverse transform, 0 <= q < stride.
+/// The transforms are in the vector lanes, so every twiddle is loaded once for all 16 of them. Not scaled.
+/// @param inReal Pointer to floating point numbers, 16 * n * stride big. Real part of the input.
+/// @param inImag Pointer to floating point numbers, 16 * n * stride big. Imaginary part of the input.
+/// @param outReal Pointer to floating point numbers, 16 * n * stride big. Real part of the output. Can not be the same as the input.
+/// @param outImag Pointer to floating point numbers, 16 * n * stride big. Imaginary part of the output. Can not be the same as the input.
+/// @param n The size of the sub-transforms at this stage, a power of 2 and at least 4.
+/// @param stride The number of sub-transforms (the product of the radices of the previous stages).
+/// @param twiddles Pointer to floating point number pairs: cos(2 * pi * j / size), sin(2 * pi * j / size) for j = 0 to 3 / 4 * size.
+/// @param twiddleStride size / n.
+/// @param forward Forward or inverse.
+void FFTBatchRadix4(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, float *twiddles, unsigned int twiddleStride, bool forward);
+
+/// @fn FFTBatchRadix2(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int stride);
+/// @brief The last radix-2 stage of 16 interleaved complex FFTs, for the sizes with an odd log2. Used by BatchFFT.
+/// @param inReal Pointer to floating point numbers, 32 * stride big. Real part of the input.
+/// @param inImag Pointer to floating point numbers, 32 * stride big. Imaginary part of the input.
+/// @param outReal Pointer to floating point numbers, 32 * stride big. Real part of the output. Can not be the same as the input.
+/// @param outImag Pointer to floating point numbers, 32 * stride big. Imaginary part of the output. Can not be the same as the input.
+/// @param stride Half of the FFT size.
+void FFTBatchRadix2(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int stride);
+
+/// @fn FFTBatchRealSplit(float *real, float *imag, unsigned int half, float *twiddles, bool forward);
+/// @brief The split step of 16 interleaved real FFTs, computed as complex FFTs of half size. Packing and scaling are the same as FFTReal in SuperpoweredFFT.h. Used by BatchFFT.
+/// The forward step runs after the complex FFT, the inverse step runs before the inverse complex FFT.
+/// @param real Pointer to floating point numbers, 16 * half big. Real part, in-place.
+/// @param imag Pointer to floating point numbers, 16 * half big. Imaginary part, in-place.
+/// @param half Half of the real FFT size.
+/// @param twiddles Pointer to floating point number pairs: cos(2 * pi * k / (2 * half)), sin(2 * pi * k / (2 * half)) for k = 0 to half / 2.
+/// @param forward Forward or inverse.
+void FFTBatchRealSplit(float *real, float *imag, unsigned int half, float *twiddles, bool forward);
+
+/// @fn FFTMixedRadixStage(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, unsigned int radix, float *twiddles, bool forward);
+/// @brief One radix 2, 3, 4, 5 or 7 Stockham autosort stage of a complex FFT. Used by MixedRadixFFT.
+/// Every sub-transform of n points is split into radix of n / radix points: y[q + stride * (radix * p + k)] = W^(k * p) * sum(x[q + stride * (p + j * n / radix)] * e^(j * k)), W = e^(-i * 2 * pi / n) and e = e^(-i * 2 * pi / radix) for the forward transform (conjugated for the inverse), 0 <= q < stride.
+/// The vectors run along q, so stages with a stride below the vector width use the scalar path. Not scaled.
+/// @param inReal Pointer to floating point numbers, n * stride big. Real part of the input.
+/// @param inImag Pointer to floating point numbers, n * stride big. Imaginary part of the input.
+/// @param outReal Pointer to floating point numbers, n * stride big. Real part of the output. Can not be the same as the input.
+/// @param outImag Pointer to floating point numbers, n * stride big. Imaginary part of the output. Can not be the same as the input.
+/// @param n The size of the sub-transforms at this stage, a multiple of radix.
+/// @param stride The number of sub-transforms (the product of the radices of the previous stages).
+/// @param radix 2, 3, 4, 5 or 7. Other values do nothing.
+/// @param twiddles Pointer to floating point number pairs: cos(2 * pi * k * p / n), sin(2 * pi * k * p / n) for p = 0 to n / radix - 1, and k = 1 to radix - 1 within every p.
+/// @param forward Forward or inverse.
+void FFTMixedRadixStage(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, unsigned int radix, float *twiddles, bool forward);
+
+/// @fn FFTDoubleRadix4(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int n, unsigned int stride, double *twiddles, unsigned int twiddleStride, bool forward);
+/// @brief One double precision radix-4 Stockham autosort stage of a complex FFT, the same as FFTBatchRadix4 for a single transform. Used by DoubleFFT.
+/// The vectors run along the stride, so stages with a stride below the vector width use the scalar path. Not scaled.
+/// @param inReal Pointer to double precision numbers, n * stride big. Real part of the input.
+/// @param inImag Pointer to double precision numbers, n * stride big. Imaginary part of the input.
+/// @param outReal Pointer to double precision numbers, n * stride big. Real part of the output. Can not be the same as the input.
+/// @param outImag Pointer to double precision numbers, n * stride big. Imaginary part of the output. Can not be the same as the input.
+/// @param n The size of the sub-transforms at this stage, a power of 2 and at least 4.
+/// @param stride The number of sub-transforms (the product of the radices of the previous stages).
+/// @param twiddles Pointer to double precision number pairs: cos(2 * pi * j / size), sin(2 * pi * j / size) for j = 0 to 3 / 4 * size.
+/// @param twiddleStride size / n.
+/// @param forward Forward or inverse.
+void FFTDoubleRadix4(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int n, unsigned int stride, double *twiddles, unsigned int twiddleStride, bool forward);
+
+/// @fn FFTDoubleRadix2(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int stride);
+/// @brief The last radix-2 stage of a double precision complex FFT, for the sizes with an odd log2. Used by DoubleFFT.
+/// @param inReal Pointer to double precision numbers, 2 * stride big. Real part of the input.
+/// @param inImag Pointer to double precision numbers, 2 * stride big. Imaginary part of the input.
+/// @param outReal Pointer to double precision numbers, 2 * stride big. Real part of the output. Can not be the same as the input.
+/// @param outImag Pointer to double precision numbers, 2 * stride big. Imaginary part of the output. Can not be the same as the input.
+/// @param stride Half of the FFT size.
+void FFTDoubleRadix2(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int stride);
+
+/// @fn ComplexMultiplyAccumulate(float **aReal, float **aImag, float **bReal, float **bImag, unsigned int numProducts, float *outReal, float *outImag, unsigned int numValues, bool realFFTPacking);
+/// @brief Sum of complex products: out[n] = sum of a[p][n] * b[p][n] for p = 0 to numProducts - 1. This is the frequency domain multiply-add of partitioned convolution (see Convolver).
+/// The output is read and written once, the sum is kept in registers over all products.
+/// @param aReal Pointers to the real parts of the first inputs, numProducts big.
+/// @param aImag Pointers to the imaginary parts of the first inputs, numProducts big.
+/// @param bReal Pointers to the real parts of the second inputs, numProducts big.
+/// @param bImag Pointers to the imaginary parts of the second inputs, numProducts big.
+/// @param numProducts The number of products to sum.
+/// @param outReal Pointer to floating point numbers, numValues big. Real part of the output. Overwritten, not added to.
+/// @param outImag Pointer to floating point numbers, numValues big. Imaginary part of the output. Overwritten, not added to.
+/// @param numValues The number of complex values in every input and the output.
+/// @param realFFTPacking If true, the first value is treated as FFTReal packs it: the DC in the real part and the Nyquist in the imaginary part, both real numbers.
+void ComplexMultiplyAccumulate(float **aReal, float **aImag, float **bReal, float **bImag, unsigned int numProducts, float *outReal, float *outImag, unsigned int numValues, bool realFFTPacking);
+
+/// @fn SparseComplexDotProducts(float *inReal, float *inImag, float *matrixReal, float *matrixImag, unsigned int *bandStart, unsigned int *bandLength, unsigned int numRows, float *outReal, float *outImag);
+/// @brief Complex sparse matrix - vector product, where every row of the matrix has one band of non-zero values: out[r] = sum of in[bandStart[r] + j] * matrix[r][j] for j = 0 to bandLength[r] - 1. This is the spectral kernel product of the constant-Q transform (see ConstantQ).
+/// @param inReal Pointer to floating point numbers. Real part of the input vector.
+/// @param inImag Pointer to floating point numbers. Imaginary part of the input vector.
+/// @param matrixReal Pointer to floating point numbers. Real part of the bands, row after row without gaps (the sum of bandLength big).
+/// @param matrixImag Pointer to floating point numbers. Imaginary part of the bands, row after row without gaps (the sum of bandLength big).
+/// @param bandStart Pointer to numRows unsigned integers. The index of the first input value of every band.
+/// @param bandLength Pointer to numRows unsigned integers. The length of every band.
+/// @param numRows The number of rows.
+/// @param outReal Pointer to floating point numbers, numRows big. Real part of the output.
+/// @param outImag Pointer to floating point numbers, numRows big. Imaginary part of the output.
+void SparseComplexDotProducts(float *inReal, float *inImag, float *matrixReal, float *matrixImag, unsigned int *bandStart, unsigned int *bandLength, unsigned int numRows, float *outReal, float *outImag);
+
+/// @fn VolumeMultichannel(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfFrames, unsigned int numChannels);
+/// @brief Applies volume on a single interleaved buffer with any number of channels, with a separate gain ramp for every channel: output = input * gain
+/// @param input Pointer to floating point numbers. 32-bit interleaved input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output. Can be equal to input (in-place processing).
+/// @param volumeStart Pointer to floating point numbers. Volume for the first frame, one value per channel.
+/// @param volumeEnd Pointer to floating point numbers. Volume for the last frame, one value per channel. Volume will be smoothly calculated between the first and last frames.
+/// @param numberOfFrames The number of frames to process.
+/// @param numChannels The number of channels.
+void VolumeMultichannel(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfFrames, unsigned int numChannels);
+
+/// @fn ChangeVolumeMultichannel(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfFrames, unsigned int numChannels);
+/// @brief Applies volume on a single interleaved buffer with any number of channels, with a separate gain ramp for every channel: output = input * gain
+/// @param input Pointer to floating point numbers. 32-bit interleaved input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output. Can be equal to input (in-place processing).
+/// @param volumeStart Pointer to floating point numbers. Volume for the first frame, one value per channel.
+/// @param volumeChange Pointer to floating point numbers. Change volume by this amount for every frame, one value per channel.
+/// @param numberOfFrames The number of frames to process.
+/// @param numChannels The number of channels.
+void ChangeVolumeMultichannel(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfFrames, unsigned int numChannels);
+
+/// @fn VolumeAddMultichannel(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfFrames, unsigned int numChannels);
+/// @brief Applies volume on a single interleaved buffer with any number of channels and adds it to the audio in the output buffer: output = output + input * gain
+/// @param input Pointer to floating point numbers. 32-bit interleaved input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output.
+/// @param volumeStart Pointer to floating point numbers. Volume for the first frame, one value per channel.
+/// @param volumeEnd Pointer to floating point numbers. Volume for the last frame, one value per channel. Volume will be smoothly calculated between the first and last frames.
+/// @param numberOfFrames The number of frames to process.
+/// @param numChannels The number of channels.
+void VolumeAddMultichannel(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfFrames, unsigned int numChannels);
+
+/// @fn ChangeVolumeAddMultichannel(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfFrames, unsigned int numChannels);
+/// @brief Applies volume on a single interleaved buffer with any number of channels and adds it to the audio in the output buffer: output = output + input * gain
+/// @param input Pointer to floating point numbers. 32-bit interleaved input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output.
+/// @param volumeStart Pointer to floating point numbers. Volume for the first frame, one value per channel.
+/// @param volumeChange Pointer to floating point numbers. Change volume by this amount for every frame, one value per channel.
+/// @param numberOfFrames The number of frames to process.
+/// @param numChannels The number of channels.
+void ChangeVolumeAddMultichannel(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfFrames, unsigned int numChannels);
+
+/// @fn IntToFloatGetPeaks(void *input, SampleFormat format, float *output, unsigned int numberOfFrames, unsigned int numChannels, float volumeStart, float volumeEnd, float *peaks, float *rms);
+/// @brief Converts interleaved integer input to 32-bit float output, applies volume and measures every channel in a single pass over the data: output = float(input) * gain
+/// Replaces the ShortIntToFloat() + Volume() + GetPeaks() sequence, which reads the buffer three times.
+/// @param input Pointer to the interleaved integer input.
+/// @param format The sample format of the input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved output.
+/// @param numberOfFrames The number of frames to process.
+/// @param numChannels The number of channels.
+/// @param volumeStart Volume for the first frame.
+/// @param volumeEnd Volume for the last frame. Volume will be smoothly calculated between the first and last frames.
+/// @param peaks Pointer to floating point numbers. Peak value of the output for every channel, should be numChannels big minimum. Can be NULL.
+/// @param rms Pointer to floating point numbers. RMS value of the output for every channel, should be numChannels big minimum. Can be NULL.
+void IntToFloatGetPeaks(void *input, SampleFormat format, float *output, unsigned int numberOfFrames, unsigned int numChannels, float volumeStart = 1.0f, float volumeEnd = 1.0f, float *peaks = 0, float *rms = 0);
+
+/// @brief Lightweight view of non-interleaved (planar) audio with one pointer per channel. It doesn't own or copy any memory.
+struct PlanarBuffer {
+    float **channels;            ///< Pointers to the first sample of every channel.
+    unsigned int numChannels;    ///< The number of channels.
+    unsigned int numberOfFrames; ///< The number of frames (samples per channel) in the view.
+    unsigned int offset;         ///< The view starts at this frame in every channel.
+
+/// @brief Constructor.
+/// @param channels Pointers to the first sample of every channel.
+/// @param numChannels The number of channels.
+/// @param numberOfFrames The number of frames.
+    PlanarBuffer(float **channels, unsigned int numChannels, unsigned int numberOfFrames) : channels(channels), numChannels(numChannels), numberOfFrames(numberOfFrames), offset(0) {}
+
+/// @return Returns with a pointer to the first sample of a channel in the view.
+/// @param index The index of the channel.
+    float *channel(unsigned int index) const { return channels[index] + offset; }
+
+/// @return Returns with a view of a range of frames of this view, without copying.
+/// @param firstFrame The first frame of the range, relative to this view.
+/// @param frames The number of frames in the range.
+    PlanarBuffer slice(unsigned int firstFrame, unsigned int frames) const {
+        PlanarBuffer view(*this);
+        view.offset += firstFrame;
+        view.numberOfFrames = frames;
+        return view;
+    }
+};
+
+/// @fn Volume(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeEnd);
+/// @brief Applies volume on every channel of a planar buffer: output = input * gain
+/// @param input Planar input with at least as many channels and frames as output.
+/// @param output Planar output. The number of channels and frames to process are taken from this view. Can be equal to input (in-place processing).
+/// @param volumeStart Volume for the first frame.
+/// @param volumeEnd Volume for the last frame. Volume will be smoothly calculated between the first and last frames.
+void Volume(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeEnd);
+
+/// @fn ChangeVolume(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeChange);
+/// @brief Applies volume on every channel of a planar buffer: output = input * gain
+/// @param input Planar input with at least as many channels and frames as output.
+/// @param output Planar output. The number of channels and frames to process are taken from this view. Can be equal to input (in-place processing).
+/// @param volumeStart Volume for the first frame.
+/// @param volumeChange Change volume by this amount for every frame.
+void ChangeVolume(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeChange);
+
+/// @fn VolumeAdd(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeEnd);
+/// @brief Applies volume on every channel of a planar buffer and adds it to the audio in the output buffer: output = output + input * gain
+/// @param input Planar input with at least as many channels and frames as output.
+/// @param output Planar output. The number of channels and frames to process are taken from this view.
+/// @param volumeStart Volume for the first frame.
+/// @param volumeEnd Volume for the last frame. Volume will be smoothly calculated between the first and last frames.
+void VolumeAdd(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeEnd);
+
+/// @fn ChangeVolumeAdd(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeChange);
+/// @brief Applies volume on every channel of a planar buffer and adds it to the audio in the output buffer: output = output + input * gain
+/// @param input Planar input with at least as many channels and frames as output.
+/// @param output Planar output. The number of channels and frames to process are taken from this view.
+/// @param volumeStart Volume for the first frame.
+/// @param volumeChange Change volume by this amount for every frame.
+void ChangeVolumeAdd(const PlanarBuffer &input, const PlanarBuffer &output, float volumeStart, float volumeChange);
+
+/// @fn CrossStereo(const PlanarBuffer &inputA, const PlanarBuffer &inputB, const PlanarBuffer &output, float inputAGainStart, float inputAGainEnd, float inputBGainStart, float inputBGainEnd);
+/// @brief Crossfades two planar inputs with any number of channels into a planar output: output = inputA * gain + inputB * gain
+/// @param inputA Planar input (first) with at least as many channels and frames as output.
+/// @param inputB Planar input (second) with at least as many channels and frames as output.
+/// @param output Planar output. The number of channels and frames to process are taken from this view. Can be equal with one of the inputs (in-place processing).
+/// @param inputAGainStart Gain of the first sample on the first input.
+/// @param inputAGainEnd Gain for the last sample on the first input. Gain will be smoothly calculated between start end end.
+/// @param inputBGainStart Gain of the first sample on the second input.
+/// @param inputBGainEnd Gain for the last sample on the second input. Gain will be smoothly calculated between start end end.
+void CrossStereo(const PlanarBuffer &inputA, const PlanarBuffer &inputB, const PlanarBuffer &output, float inputAGainStart, float inputAGainEnd, float inputBGainStart, float inputBGainEnd);
+
+/// @fn Interleave(const PlanarBuffer &input, float *output);
+/// @brief Makes an interleaved output from a planar input with any number of channels.
+/// @param input Planar input.
+/// @param output Pointer to floating point numbers. Interleaved output with input.numChannels channels.
+void Interleave(const PlanarBuffer &input, float *output);
+
+/// @fn DeInterleave(float *input, const PlanarBuffer &output);
+/// @brief Deinterleaves an interleaved input with any number of channels to a planar output.
+/// @param input Pointer to floating point numbers. Interleaved input with output.numChannels channels.
+/// @param output Planar output.
+void DeInterleave(float *input, const PlanarBuffer &output);
+
+/// @fn Add1(const PlanarBuffer &input, const PlanarBuffer &output);
+/// @brief Adds every channel of a planar input to the same channel of a planar output: output[ch][n] += input[ch][n]
+/// @param input Planar input with at least as many channels and frames as output.
+/// @param output Planar output. The number of channels and frames to process are taken from this view.
+void Add1(const PlanarBuffer &input, const PlanarBuffer &output);
+
+/// @fn Peak(const PlanarBuffer &input);
+/// @return Returns the peak absolute value of all channels. Useful for metering.
+/// @param input Planar input.
+float Peak(const PlanarBuffer &input);
+
+struct ditherInternals;
+
+/// @brief Dithered conversion from 32-bit floating point to 16-bit or 24-bit integer audio, with optional noise shaping.
+/// Keep one instance for every audio stream. Noise shaping feeds the quantization error of every channel back into the next frames, so the state must be continuous between calls.
+class Dither {
+public:
+    /// @brief Dither modes.
+    typedef enum Mode {
+        Mode_TPDF = 0,       ///< Triangular probability density function dither with a flat noise spectrum.
+        Mode_NoiseShaped = 1 ///< TPDF dither with 5-tap error feedback noise shaping, moving the noise to less audible frequencies. Designed for 44100 Hz and 48000 Hz.
+    } Mode;
+
+/// @brief Constructor.
+/// @param numChannels The number of channels in the interleaved input.
+/// @param mode Dither mode.
+/// @param seed Seed for the random number generators. Instances with different seeds produce uncorrelated dither noise.
+    Dither(unsigned int numChannels, Mode mode = Mode_TPDF, unsigned int seed = 1);
+    ~Dither();
+
+/// @brief Clears the noise shaping state. Call it if the audio is not continuous anymore, such as after a seek.
+    void reset();
+
+/// @brief Converts 32-bit float input to dithered 16-bit signed integer output. The scaling is the same as FloatToShortInt(), but the result is rounded instead of truncated.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input.
+/// @param output Pointer to short integer numbers. 16-bit interleaved output.
+/// @param numberOfFrames The number of frames to process.
+    void processShortInt(float *input, short int *output, unsigned int numberOfFrames);
+
+/// @brief Converts 32-bit float input to dithered 24-bit signed integer output. The scaling is the same as Superpowered::FloatTo24bit(), but the result is rounded instead of truncated.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input.
+/// @param output Output buffer pointer. Packed 24-bit interleaved output, 3 bytes per sample.
+/// @param numberOfFrames The number of frames to process.
+    void process24bit(float *input, void *output, unsigned int numberOfFrames);
+
+private:
+    ditherInternals *internals;
+    Dither(const Dither&);
+    Dither& operator=(const Dither&);
+};
+
+}
+}
+
+#endif
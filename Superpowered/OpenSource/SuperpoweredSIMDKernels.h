@@ -0,0 +1,939 @@
+// Vector kernels for SuperpoweredSIMD.cpp.
+// This file has no include guard on purpose: SuperpoweredSIMD.cpp includes it once for every instruction set, with a vector traits struct named "V" declared in the enclosing namespace. Don't include it anywhere else.
+// Every kernel processes full vectors first, then hands the remaining values to the scalar implementation.
+
+static const float stereoFrameOffsets[16] = { 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7 };
+
+template <bool add> static void volumeRamp(float *input, float *output, float gainStart, float gainStep, unsigned int numberOfFrames) {
+    const unsigned int numberOfValues = numberOfFrames * 2;
+    typename V::f frame = V::load(stereoFrameOffsets), frameStep = V::set1(float(V::width / 2)), start = V::set1(gainStart), step = V::set1(gainStep);
+    unsigned int n = 0;
+
+    for (; n + V::width <= numberOfValues; n += V::width) {
+        typename V::f x = V::mul(V::load(input + n), V::mla(start, frame, step));
+        if (add) x = V::add(x, V::load(output + n));
+        V::store(output + n, x);
+        frame = V::add(frame, frameStep);
+    }
+
+    const unsigned int framesDone = n / 2;
+    scalar::volumeRamp<add>(input + n, output + n, gainStart + gainStep * float(framesDone), gainStep, numberOfFrames - framesDone);
+}
+
+static void Volume(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames) {
+    if (numberOfFrames) volumeRamp<false>(input, output, volumeStart, (volumeEnd - volumeStart) / float(numberOfFrames), numberOfFrames);
+}
+
+static void ChangeVolume(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames) {
+    volumeRamp<false>(input, output, volumeStart, volumeChange, numberOfFrames);
+}
+
+static void VolumeAdd(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfFrames) {
+    if (numberOfFrames) volumeRamp<true>(input, output, volumeStart, (volumeEnd - volumeStart) / float(numberOfFrames), numberOfFrames);
+}
+
+static void ChangeVolumeAdd(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfFrames) {
+    volumeRamp<true>(input, output, volumeStart, volumeChange, numberOfFrames);
+}
+
+static void CrossStereo(float *inputA, float *inputB, float *output, float inputAGainStart, float inputAGainEnd, float inputBGainStart, float inputBGainEnd, unsigned int numberOfFrames) {
+    if (!numberOfFrames) return;
+    const unsigned int numberOfValues = numberOfFrames * 2;
+    const float stepA = (inputAGainEnd - inputAGainStart) / float(numberOfFrames), stepB = (inputBGainEnd - inputBGainStart) / float(numberOfFrames);
+    typename V::f frame = V::load(stereoFrameOffsets), frameStep = V::set1(float(V::width / 2));
+    typename V::f startA = V::set1(inputAGainStart), startB = V::set1(inputBGainStart), vStepA = V::set1(stepA), vStepB = V::set1(stepB);
+    unsigned int n = 0;
+
+    for (; n + V::width <= numberOfValues; n += V::width) {
+        typename V::f x = V::mul(V::load(inputA + n), V::mla(startA, frame, vStepA));
+        V::store(output + n, V::mla(x, V::load(inputB + n), V::mla(startB, frame, vStepB)));
+        frame = V::add(frame, frameStep);
+    }
+
+    const float framesDone = float(n / 2);
+    scalar::crossStereo(inputA + n, inputB + n, output + n, inputAGainStart + stepA * framesDone, stepA, inputBGainStart + stepB * framesDone, stepB, numberOfFrames - n / 2);
+}
+
+static void Interleave(float *left, float *right, float *output, unsigned int numberOfFrames) {
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfFrames; n += V::width) V::interleave(V::load(left + n), V::load(right + n), output + n * 2);
+    scalar::Interleave(left + n, right + n, output + n * 2, numberOfFrames - n);
+}
+
+static void DeInterleave(float *input, float *left, float *right, unsigned int numberOfFrames) {
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfFrames; n += V::width) {
+        typename V::f l, r;
+        V::deinterleave(input + n * 2, l, r);
+        V::store(left + n, l);
+        V::store(right + n, r);
+    }
+    scalar::DeInterleave(input + n * 2, left + n, right + n, numberOfFrames - n);
+}
+
+static void ShortIntToFloat(short int *input, float *output, unsigned int numberOfFrames, unsigned int numChannels) {
+    const unsigned int numberOfValues = numberOfFrames * numChannels;
+    const typename V::f mul = V::set1(scalar::shortToFloatMul);
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfValues; n += V::width) V::store(output + n, V::mul(V::loadShort(input + n), mul));
+    scalar::shortIntToFloat(input + n, output + n, numberOfValues - n);
+}
+
+static void FloatToShortInt(float *input, short int *output, unsigned int numberOfFrames, unsigned int numChannels) {
+    const unsigned int numberOfValues = numberOfFrames * numChannels;
+    const typename V::f mul = V::set1(scalar::floatToShortMul), negativeLimit = V::set1(-scalar::floatToShortMul); // Clamping happens before the conversion, because out of range floats convert to INT_MIN.
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfValues; n += V::width) V::storeShort(output + n, V::max(negativeLimit, V::min(mul, V::mul(V::load(input + n), mul))));
+    scalar::floatToShortInt(input + n, output + n, numberOfValues - n);
+}
+
+static void Add1(float *input, float *output, unsigned int numberOfItems) {
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfItems; n += V::width) V::store(output + n, V::add(V::load(output + n), V::load(input + n)));
+    scalar::Add1(input + n, output + n, numberOfItems - n);
+}
+
+static void Add2(float *inputA, float *inputB, float *output, unsigned int numberOfItems) {
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfItems; n += V::width) V::store(output + n, V::add(V::load(inputA + n), V::load(inputB + n)));
+    scalar::Add2(inputA + n, inputB + n, output + n, numberOfItems - n);
+}
+
+static void Add4(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfItems) {
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfItems; n += V::width) {
+        typename V::f ab = V::add(V::load(inputA + n), V::load(inputB + n)), cd = V::add(V::load(inputC + n), V::load(inputD + n));
+        V::store(output + n, V::add(ab, cd));
+    }
+    scalar::Add4(inputA + n, inputB + n, inputC + n, inputD + n, output + n, numberOfItems - n);
+}
+
+static float DotProduct(float *inputA, float *inputB, unsigned int numValues) {
+    typename V::f sum0 = V::set1(0), sum1 = V::set1(0);
+    unsigned int n = 0;
+    for (; n + V::width * 2 <= numValues; n += V::width * 2) { // Two accumulators hide the latency of the multiply-add.
+        sum0 = V::mla(sum0, V::load(inputA + n), V::load(inputB + n));
+        sum1 = V::mla(sum1, V::load(inputA + n + V::width), V::load(inputB + n + V::width));
+    }
+    return V::sum(V::add(sum0, sum1)) + scalar::DotProduct(inputA + n, inputB + n, numValues - n);
+}
+
+static float Peak(float *input, unsigned int numberOfValues) {
+    typename V::f peak0 = V::set1(0), peak1 = V::set1(0);
+    unsigned int n = 0;
+    for (; n + V::width * 2 <= numberOfValues; n += V::width * 2) {
+        peak0 = V::max(peak0, V::abs(V::load(input + n)));
+        peak1 = V::max(peak1, V::abs(V::load(input + n + V::width)));
+    }
+    const float peak = V::maximum(V::max(peak0, peak1)), tail = scalar::Peak(input + n, numberOfValues - n);
+    return peak > tail ? peak : tail;
+}
+
+// Multichannel gain ramps, one pass over the interleaved buffer.
+template <bool add, bool endGains> static void volumeMultichannel(float *input, float *output, float *gainStart, float *gainEndOrChange, unsigned int numberOfFrames, unsigned int numChannels) {
+    if (!numberOfFrames || !numChannels) return;
+    const float stepMul = 1.0f / float(numberOfFrames);
+    unsigned int frame = 0;
+
+    if (numChannels >= V::width) { // Vectors run along the channels of one frame, the gains are loaded directly from the start/end arrays.
+        const typename V::f vStepMul = V::set1(stepMul);
+        for (; frame < numberOfFrames; frame++, input += numChannels, output += numChannels) {
+            const typename V::f f = V::set1(float(frame));
+            unsigned int ch = 0;
+            for (; ch + V::width <= numChannels; ch += V::width) {
+                const typename V::f start = V::load(gainStart + ch);
+                typename V::f step = V::load(gainEndOrChange + ch);
+                if (endGains) step = V::mul(V::sub(step, start), vStepMul);
+                typename V::f x = V::mul(V::load(input + ch), V::mla(start, step, f));
+                if (add) x = V::add(x, V::load(output + ch));
+                V::store(output + ch, x);
+            }
+            scalar::volumeFrame<add, endGains>(input + ch, output + ch, gainStart + ch, gainEndOrChange + ch, float(frame), stepMul, numChannels - ch);
+        }
+        return;
+    }
+
+    // Fewer channels than lanes: a tile of V::width frames is numChannels vectors, and the channel pattern of every vector is the same in each tile.
+    // The per-lane gain at tile t is base + increment * t, so there is no accumulated rounding error over long buffers.
+    float base[V::width * V::width], increment[V::width * V::width];
+    const unsigned int tileValues = numChannels * V::width;
+    for (unsigned int n = 0; n < tileValues; n++) {
+        const unsigned int ch = n % numChannels;
+        const float step = endGains ? (gainEndOrChange[ch] - gainStart[ch]) * stepMul : gainEndOrChange[ch];
+        base[n] = gainStart[ch] + step * float(n / numChannels);
+        increment[n] = step * float(V::width);
+    }
+
+    float tile = 0;
+    for (; frame + V::width <= numberOfFrames; frame += V::width, input += tileValues, output += tileValues, tile += 1.0f) {
+        const typename V::f t = V::set1(tile);
+        for (unsigned int n = 0; n < tileValues; n += V::width) {
+            typename V::f x = V::mul(V::load(input + n), V::mla(V::load(base + n), V::load(increment + n), t));
+            if (add) x = V::add(x, V::load(output + n));
+            V::store(output + n, x);
+        }
+    }
+    for (; frame < numberOfFrames; frame++, input += numChannels, output += numChannels) scalar::volumeFrame<add, endGains>(input, output, gainStart, gainEndOrChange, float(frame), stepMul, numChannels);
+}
+
+template <int format> static inline typename V::f loadSamples(const void *input, unsigned int index) {
+    if (format == SampleFormat_Int16) return V::loadShort((const short int *)input + index);
+    else if (format == SampleFormat_Int24) return V::loadInt24((const unsigned char *)input + index * 3);
+    else return V::loadInt32((const int *)input + index);
+}
+
+// Integer to float conversion, gain ramp and per-channel peak and sum of squares in one pass.
+template <int format> static void integerToFloat(const void *input, float *output, unsigned int numberOfFrames, unsigned int numChannels, float gainStart, float gainStep, float *peaks, float *sumOfSquares) {
+    const float scale = (format == SampleFormat_Int16) ? scalar::shortToFloatMul : scalar::int32ToFloatMul;
+    const unsigned int numberOfValues = numberOfFrames * numChannels, spare = (format == SampleFormat_Int24) ? 3 : 0; // 24-bit loads read a few bytes after the last sample.
+    unsigned int frame = 0;
+
+    if (numChannels >= V::width) { // Vectors run along the channels of one frame.
+        for (; (frame + 1) * numChannels + spare <= numberOfValues; frame++) {
+            const typename V::f g = V::set1((gainStart + gainStep * float(frame)) * scale);
+            const unsigned int first = frame * numChannels;
+            unsigned int ch = 0;
+            for (; ch + V::width <= numChannels; ch += V::width) {
+                const typename V::f x = V::mul(loadSamples<format>(input, first + ch), g);
+                V::store(output + first + ch, x);
+                if (peaks) V::store(peaks + ch, V::max(V::load(peaks + ch), V::abs(x)));
+                if (sumOfSquares) V::store(sumOfSquares + ch, V::mla(V::load(sumOfSquares + ch), x, x));
+            }
+            for (; ch < numChannels; ch++) {
+                const float v = scalar::integerSample<format>(input, first + ch) * (gainStart + gainStep * float(frame));
+                output[first + ch] = v;
+                if (peaks && (fabsf(v) > peaks[ch])) peaks[ch] = fabsf(v);
+                if (sumOfSquares) sumOfSquares[ch] += v * v;
+            }
+        }
+    } else { // Fewer channels than lanes: a tile of V::width frames is numChannels vectors with a fixed channel pattern, each vector has its own accumulators.
+        float frameOffsets[V::width * V::width];
+        const unsigned int tileValues = numChannels * V::width;
+        for (unsigned int n = 0; n < tileValues; n++) frameOffsets[n] = float(n / numChannels);
+
+        typename V::f peakAccumulators[V::width], squareAccumulators[V::width];
+        for (unsigned int k = 0; k < numChannels; k++) peakAccumulators[k] = squareAccumulators[k] = V::set1(0);
+        const typename V::f start = V::set1(gainStart * scale), step = V::set1(gainStep * scale);
+
+        for (; (frame + V::width) * numChannels + spare <= numberOfValues; frame += V::width) {
+            const typename V::f tileFrame = V::set1(float(frame));
+            for (unsigned int k = 0, index = frame * numChannels; k < numChannels; k++, index += V::width) {
+                const typename V::f g = V::mla(start, V::add(tileFrame, V::load(frameOffsets + k * V::width)), step);
+                const typename V::f x = V::mul(loadSamples<format>(input, index), g);
+                V::store(output + index, x);
+                peakAccumulators[k] = V::max(peakAccumulators[k], V::abs(x));
+                squareAccumulators[k] = V::mla(squareAccumulators[k], x, x);
+            }
+        }
+
+        // Fold the lanes into their channels.
+        float lanes[V::width];
+        for (unsigned int k = 0; k < numChannels; k++) {
+            if (peaks) {
+                V::store(lanes, peakAccumulators[k]);
+                for (unsigned int j = 0; j < V::width; j++) {
+                    const unsigned int ch = (k * V::width + j) % numChannels;
+                    if (lanes[j] > peaks[ch]) peaks[ch] = lanes[j];
+                }
+            }
+            if (sumOfSquares) {
+                V::store(lanes, squareAccumulators[k]);
+                for (unsigned int j = 0; j < V::width; j++) sumOfSquares[(k * V::width + j) % numChannels] += lanes[j];
+            }
+        }
+    }
+
+    scalar::integerToFloatFrames<format>(input, output, frame, numberOfFrames, numChannels, gainStart, gainStep, peaks, sumOfSquares);
+}
+
+static void IntToFloatGetPeaks(void *input, SampleFormat format, float *output, unsigned int numberOfFrames, unsigned int numChannels, float volumeStart, float volumeEnd, float *peaks, float *rms) {
+    if (peaks) for (unsigned int ch = 0; ch < numChannels; ch++) peaks[ch] = 0;
+    if (rms) for (unsigned int ch = 0; ch < numChannels; ch++) rms[ch] = 0;
+    if (!numChannels) return;
+    const float step = numberOfFrames ? (volumeEnd - volumeStart) / float(numberOfFrames) : 0.0f;
+    switch (format) {
+        case SampleFormat_Int16: integerToFloat<SampleFormat_Int16>(input, output, numberOfFrames, numChannels, volumeStart, step, peaks, rms); break;
+        case SampleFormat_Int24: integerToFloat<SampleFormat_Int24>(input, output, numberOfFrames, numChannels, volumeStart, step, peaks, rms); break;
+        default: integerToFloat<SampleFormat_Int32>(input, output, numberOfFrames, numChannels, volumeStart, step, peaks, rms);
+    }
+    if (rms) scalar::finishRMS(rms, numberOfFrames, numChannels);
+}
+
+template <bool bit24> static inline void storeQuantized(void *output, unsigned int index, typename V::i q) {
+    if (!bit24) V::storeShortInt((short int *)output + index, q); // Saturates.
+    else {
+        int lanes[V::width];
+        V::storeInt(lanes, q);
+        for (unsigned int j = 0; j < V::width; j++) scalar::storeQuantized<true>(output, index + j, lanes[j]);
+    }
+}
+
+// TPDF dither runs along the interleaved values, the channels don't matter. Every lane has its own random generator.
+template <bool bit24> static void ditherTPDF(ditherInternals *internals, float *input, void *output, unsigned int numberOfValues) {
+    const typename V::f scale = V::set1(bit24 ? scalar::floatTo24Mul : scalar::floatToShortMul), limit = V::set1(bit24 ? scalar::int24Max : scalar::floatToShortMul), negativeLimit = V::sub(V::set1(0), limit);
+    typename V::i random = V::loadInt((const int *)internals->random);
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfValues; n += V::width) {
+        const typename V::f v = V::mla(V::triangular(V::xorshift(random)), V::load(input + n), scale);
+        storeQuantized<bit24>(output, n, V::roundToInt(V::max(negativeLimit, V::min(limit, v))));
+    }
+    V::storeInt((int *)internals->random, random);
+    scalar::ditherTPDF<bit24>(internals, input, output, n, numberOfValues);
+}
+
+// Noise shaping feeds back the error of the previous frames of the same channel, so vectors run along the channels of one frame.
+template <bool bit24> static void ditherShaped(ditherInternals *internals, float *input, void *output, unsigned int numberOfFrames) {
+    const unsigned int numChannels = internals->numChannels;
+    if (numChannels < V::width) {
+        scalar::ditherShaped<bit24>(internals, input, output, numberOfFrames);
+        return;
+    }
+    const typename V::f scale = V::set1(bit24 ? scalar::floatTo24Mul : scalar::floatToShortMul), limit = V::set1(bit24 ? scalar::int24Max : scalar::floatToShortMul), negativeLimit = V::sub(V::set1(0), limit);
+    typename V::f h[5];
+    for (unsigned int k = 0; k < 5; k++) h[k] = V::set1(scalar::noiseShaping[k]);
+    float *taps[5];
+
+    for (unsigned int frame = 0; frame < numberOfFrames; frame++) {
+        scalar::ditherTaps(internals, taps);
+        unsigned int ch = 0;
+        for (; ch + V::width <= numChannels; ch += V::width) {
+            typename V::f feedback = V::mul(h[0], V::load(taps[0] + ch));
+            for (unsigned int k = 1; k < 5; k++) feedback = V::mla(feedback, h[k], V::load(taps[k] + ch));
+            const typename V::f v = V::max(negativeLimit, V::min(limit, V::sub(V::mul(V::load(input + frame * numChannels + ch), scale), feedback)));
+            typename V::i random = V::loadInt((const int *)internals->random + ch);
+            const typename V::i q = V::roundToInt(V::add(v, V::triangular(V::xorshift(random))));
+            V::storeInt((int *)internals->random + ch, random);
+            V::store(taps[4] + ch, V::sub(V::intToFloat(q), v));
+            storeQuantized<bit24>(output, frame * numChannels + ch, q);
+        }
+        scalar::ditherShapedFrame<bit24>(internals, input, output, frame, ch, taps);
+        internals->head = (internals->head + 4) % 5;
+    }
+}
+
+static void dither(ditherInternals *internals, float *input, void *output, unsigned int numberOfFrames, bool bit24) {
+    if (internals->mode == Dither::Mode_NoiseShaped) {
+        if (bit24) ditherShaped<true>(internals, input, output, numberOfFrames); else ditherShaped<false>(internals, input, output, numberOfFrames);
+    } else {
+        const unsigned int numberOfValues = numberOfFrames * internals->numChannels;
+        if (bit24) ditherTPDF<true>(internals, input, output, numberOfValues); else ditherTPDF<false>(internals, input, output, numberOfValues);
+    }
+}
+
+// MixN sums up to 4 inputs per pass over a tile that fits into the L1 cache. Intermediate sums stay in the tile, only the last pass writes the output.
+static const unsigned int mixTileValues = 1024;
+
+static inline void mixInput(typename V::f &sum, typename V::f &ramp, const float *input, typename V::f base, typename V::f step) {
+    const typename V::f x = V::load(input);
+    sum = V::mla(sum, x, base);
+    ramp = V::mla(ramp, x, step);
+}
+
+template <unsigned int count, bool last> static void mixGroup(float **inputs, unsigned int firstInput, const float *source, float *destination, const float *gainStart, const float *gainEnd, float stepMul, const float *frameOf, unsigned int offset, unsigned int firstFrame, unsigned int values, unsigned int numChannels, typename V::f &peak) {
+    typename V::f base[count ? count : 1], step[count ? count : 1];
+    const float *in[count ? count : 1];
+    for (unsigned int j = 0; j < count; j++) {
+        float s, st;
+        scalar::mixGain(gainStart, gainEnd, firstInput + j, stepMul, s, st);
+        base[j] = V::set1(s + st * float(firstFrame));
+        step[j] = V::set1(st);
+        in[j] = inputs[firstInput + j] + offset;
+    }
+
+    // sum(input * (base + step * frame)) = sum(input * base) + frame * sum(input * step), so every input costs one load and two independent multiply-adds.
+    typename V::f maximum = peak;
+    unsigned int v = 0;
+    for (; v + V::width <= values; v += V::width) {
+        typename V::f sum = source ? V::load(source + v) : V::set1(0), ramp = V::set1(0);
+        // Unrolled by hand, so base and step stay in registers.
+        if (count > 0) mixInput(sum, ramp, in[0] + v, base[0], step[0]);
+        if (count > 1) mixInput(sum, ramp, in[1] + v, base[1], step[1]);
+        if (count > 2) mixInput(sum, ramp, in[2] + v, base[2], step[2]);
+        if (count > 3) mixInput(sum, ramp, in[3] + v, base[3], step[3]);
+        sum = V::mla(sum, ramp, V::load(frameOf + v));
+        V::store(destination + v, sum);
+        if (last) maximum = V::max(maximum, V::abs(sum));
+    }
+    peak = maximum;
+    for (; v < values; v++) {
+        const float sum = scalar::mixValue(inputs, firstInput, firstInput + count, source ? source[v] : 0, gainStart, gainEnd, stepMul, offset + v, float(firstFrame + v / numChannels));
+        destination[v] = sum;
+        if (last) peak = V::max(peak, V::set1(fabsf(sum)));
+    }
+}
+
+static float MixN(float **inputs, unsigned int numInputs, float *output, float *gainStart, float *gainEnd, unsigned int numberOfFrames, unsigned int numChannels, bool addToOutput) {
+    if (!numChannels || (numChannels * V::width > mixTileValues)) return scalar::MixN(inputs, numInputs, output, gainStart, gainEnd, numberOfFrames, numChannels, addToOutput);
+    if (!numberOfFrames) return 0;
+    // A tile is a multiple of V::width frames, so the frame index pattern of the lanes is the same in every tile.
+    const unsigned int tileFrames = V::width * (mixTileValues / (numChannels * V::width));
+    const float stepMul = 1.0f / float(numberOfFrames);
+    float frameOf[mixTileValues], tile[mixTileValues];
+    for (unsigned int frame = 0, n = 0, frames = numberOfFrames < tileFrames ? numberOfFrames : tileFrames; frame < frames; frame++) {
+        for (unsigned int ch = 0; ch < numChannels; ch++) frameOf[n++] = float(frame);
+    }
+    typename V::f peak = V::set1(0);
+
+    for (unsigned int firstFrame = 0; firstFrame < numberOfFrames; firstFrame += tileFrames) {
+        const unsigned int offset = firstFrame * numChannels, values = (numberOfFrames - firstFrame < tileFrames ? numberOfFrames - firstFrame : tileFrames) * numChannels;
+        const float *source = addToOutput ? output + offset : 0;
+        unsigned int k = 0;
+        for (; k + 4 < numInputs; k += 4, source = tile) mixGroup<4, false>(inputs, k, source, tile, gainStart, gainEnd, stepMul, frameOf, offset, firstFrame, values, numChannels, peak);
+
+        float *destination = output + offset;
+        switch (numInputs - k) {
+            case 0: mixGroup<0, true>(inputs, k, source, destination, gainStart, gainEnd, stepMul, frameOf, offset, firstFrame, values, numChannels, peak); break;
+            case 1: mixGroup<1, true>(inputs, k, source, destination, gainStart, gainEnd, stepMul, frameOf, offset, firstFrame, values, numChannels, peak); break;
+            case 2: mixGroup<2, true>(inputs, k, source, destination, gainStart, gainEnd, stepMul, frameOf, offset, firstFrame, values, numChannels, peak); break;
+            case 3: mixGroup<3, true>(inputs, k, source, destination, gainStart, gainEnd, stepMul, frameOf, offset, firstFrame, values, numChannels, peak); break;
+            default: mixGroup<4, true>(inputs, k, source, destination, gainStart, gainEnd, stepMul, frameOf, offset, firstFrame, values, numChannels, peak);
+        }
+    }
+    return V::maximum(peak);
+}
+
+static void FloatToHalf(float *input, unsigned short *output, unsigned int numberOfValues) {
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfValues; n += V::width) V::storeHalf(output + n, V::load(input + n));
+    scalar::FloatToHalf(input + n, output + n, numberOfValues - n);
+}
+
+static void HalfToFloat(unsigned short *input, float *output, unsigned int numberOfValues) {
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfValues; n += V::width) V::store(output + n, V::loadHalf(input + n));
+    scalar::HalfToFloat(input + n, output + n, numberOfValues - n);
+}
+
+static void FloatToBFloat16(float *input, unsigned short *output, unsigned int numberOfValues) {
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfValues; n += V::width) V::storeBFloat16(output + n, V::load(input + n));
+    scalar::FloatToBFloat16(input + n, output + n, numberOfValues - n);
+}
+
+static void BFloat16ToFloat(unsigned short *input, float *output, unsigned int numberOfValues) {
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfValues; n += V::width) V::store(output + n, V::loadBFloat16(input + n));
+    scalar::BFloat16ToFloat(input + n, output + n, numberOfValues - n);
+}
+
+// Up to 4 channels share every interpolated coefficient vector, so the coefficient tables are read once per group.
+template <unsigned int count> static inline void polyphaseGroup(float **inputs, const float *coefficients, const float *deltas, float fraction, unsigned int numTaps, float *output) {
+    const typename V::f f = V::set1(fraction);
+    typename V::f sum[count];
+    for (unsigned int ch = 0; ch < count; ch++) sum[ch] = V::set1(0);
+    unsigned int k = 0;
+    for (; k + V::width <= numTaps; k += V::width) {
+        const typename V::f c = V::mla(V::load(coefficients + k), V::load(deltas + k), f);
+        for (unsigned int ch = 0; ch < count; ch++) sum[ch] = V::mla(sum[ch], V::load(inputs[ch] + k), c);
+    }
+    for (unsigned int ch = 0; ch < count; ch++) output[ch] = V::sum(sum[ch]) + scalar::polyphaseTaps(inputs[ch] + k, coefficients + k, deltas + k, fraction, numTaps - k);
+}
+
+static void PolyphaseFIR(float **inputs, unsigned int numChannels, float *coefficients, float *deltas, float fraction, unsigned int numTaps, float *output) {
+    unsigned int ch = 0;
+    for (; ch + 4 <= numChannels; ch += 4) polyphaseGroup<4>(inputs + ch, coefficients, deltas, fraction, numTaps, output + ch);
+    switch (numChannels - ch) {
+        case 1: polyphaseGroup<1>(inputs + ch, coefficients, deltas, fraction, numTaps, output + ch); break;
+        case 2: polyphaseGroup<2>(inputs + ch, coefficients, deltas, fraction, numTaps, output + ch); break;
+        case 3: polyphaseGroup<3>(inputs + ch, coefficients, deltas, fraction, numTaps, output + ch); break;
+        default: break;
+    }
+}
+
+// One biquad over blocks of V::width frames of up to 2 planar channels. The output of a block is the sum of the block's responses to the input frames and to the state (see scalar::biquadBlockResponses).
+// The state after a block is computed from the state before it directly, so the recursion is two multiply-adds per block, not per frame. The channels share the loads of the impulse response.
+// The output is stored to output, or its sum of squares is added to sumOfSquares if output is NULL.
+template <unsigned int count> static inline void biquadBlocks(float **input, unsigned int numberOfFrames, const float *responses, float *state1, float *state2, float **output, typename V::f *sumOfSquares) {
+    const float *impulse = responses + V::width - 1, *feedback = responses + V::width * 6;
+    const float f0 = feedback[0], f1 = feedback[1], f2 = feedback[2], f3 = feedback[3];
+    const typename V::f fromZ1 = V::load(responses + V::width * 2), fromZ2 = V::load(responses + V::width * 3), toZ1 = V::load(responses + V::width * 4), toZ2 = V::load(responses + V::width * 5);
+    const float *x[count];
+    float z1[count], z2[count];
+    typename V::f sum[count];
+    for (unsigned int ch = 0; ch < count; ch++) {
+        x[ch] = input[ch];
+        z1[ch] = state1[ch];
+        z2[ch] = state2[ch];
+        sum[ch] = output ? V::set1(0) : sumOfSquares[ch];
+    }
+
+    for (unsigned int n = 0; n < numberOfFrames; n += V::width) {
+        typename V::f y[count];
+        for (unsigned int ch = 0; ch < count; ch++) y[ch] = V::mul(V::set1(x[ch][n]), V::load(impulse));
+        for (unsigned int j = 1; j < V::width; j++) {
+            const typename V::f h = V::load(impulse - j);
+            for (unsigned int ch = 0; ch < count; ch++) y[ch] = V::mla(y[ch], V::set1(x[ch][n + j]), h);
+        }
+        for (unsigned int ch = 0; ch < count; ch++) {
+            const typename V::f in = V::load(x[ch] + n);
+            const float u1 = V::sum(V::mul(in, toZ1)), u2 = V::sum(V::mul(in, toZ2)), z = z1[ch];
+            y[ch] = V::mla(V::mla(y[ch], fromZ1, V::set1(z)), fromZ2, V::set1(z2[ch]));
+            z1[ch] = u1 + f0 * z + f1 * z2[ch];
+            z2[ch] = u2 + f2 * z + f3 * z2[ch];
+            if (output) V::store(output[ch] + n, y[ch]); else sum[ch] = V::mla(sum[ch], y[ch], y[ch]);
+        }
+    }
+
+    for (unsigned int ch = 0; ch < count; ch++) {
+        state1[ch] = z1[ch];
+        state2[ch] = z2[ch];
+        if (!output) sumOfSquares[ch] = sum[ch];
+    }
+}
+
+// Both biquads for count channels starting at channel first, through planar chunks of blockChunkFrames.
+static const unsigned int blockChunkFrames = 256;
+
+template <unsigned int count> static void biquad2Blocks(float *input, unsigned int numberOfFrames, unsigned int numChannels, unsigned int first, const float *responses, float *state, float *sumOfSquares) {
+    float buffer[count * 2][blockChunkFrames], *x[count], *y[count], z1[count], z2[count], z3[count], z4[count];
+    typename V::f sum[count];
+    for (unsigned int ch = 0; ch < count; ch++) {
+        x[ch] = buffer[ch];
+        y[ch] = buffer[count + ch];
+        z1[ch] = state[first + ch];
+        z2[ch] = state[numChannels + first + ch];
+        z3[ch] = state[numChannels * 2 + first + ch];
+        z4[ch] = state[numChannels * 3 + first + ch];
+        sum[ch] = V::set1(0);
+    }
+
+    for (unsigned int chunk = 0; chunk < numberOfFrames; chunk += blockChunkFrames) {
+        const unsigned int frames = (numberOfFrames - chunk < blockChunkFrames) ? numberOfFrames - chunk : blockChunkFrames;
+        float *in = input + (size_t)chunk * numChannels + first;
+        if (numChannels == 1) x[0] = in;
+        else if ((count == 2) && (numChannels == 2)) DeInterleave(in, x[0], x[count - 1], frames);
+        else for (unsigned int n = 0; n < frames; n++, in += numChannels) {
+            for (unsigned int ch = 0; ch < count; ch++) x[ch][n] = in[ch];
+        }
+        biquadBlocks<count>(x, frames, responses, z1, z2, y, NULL);
+        biquadBlocks<count>(y, frames, responses + V::width * 6 + 4, z3, z4, NULL, sum);
+    }
+
+    for (unsigned int ch = 0; ch < count; ch++) {
+        state[first + ch] = z1[ch];
+        state[numChannels + first + ch] = z2[ch];
+        state[numChannels * 2 + first + ch] = z3[ch];
+        state[numChannels * 3 + first + ch] = z4[ch];
+        sumOfSquares[first + ch] += V::sum(sum[ch]);
+    }
+}
+
+// The filters are recursive. With at least V::width channels the vectors run along the channels: every lane is a channel with its own state.
+// The remaining channels (mono and stereo on every path) run along the frames instead, in blocks of V::width frames. Computing the block responses costs about as much as a few blocks, so short buffers use the scalar path.
+static void Biquad2SumOfSquares(float *input, unsigned int numberOfFrames, unsigned int numChannels, float *coefficients, float *state, float *sumOfSquares) {
+    const typename V::f b0 = V::set1(coefficients[0]), b1 = V::set1(coefficients[1]), b2 = V::set1(coefficients[2]), a1 = V::set1(-coefficients[3]), a2 = V::set1(-coefficients[4]);
+    const typename V::f b3 = V::set1(coefficients[5]), b4 = V::set1(coefficients[6]), b5 = V::set1(coefficients[7]), a3 = V::set1(-coefficients[8]), a4 = V::set1(-coefficients[9]);
+    unsigned int ch = 0;
+
+    for (; ch + V::width <= numChannels; ch += V::width) {
+        typename V::f z1 = V::load(state + ch), z2 = V::load(state + numChannels + ch), z3 = V::load(state + numChannels * 2 + ch), z4 = V::load(state + numChannels * 3 + ch), sum = V::set1(0);
+        const float *x = input + ch;
+        for (unsigned int frame = 0; frame < numberOfFrames; frame++, x += numChannels) {
+            const typename V::f in = V::load(x), y = V::mla(z1, b0, in);
+            z1 = V::mla(V::mla(z2, b1, in), a1, y);
+            z2 = V::mla(V::mul(b2, in), a2, y);
+            const typename V::f o = V::mla(z3, b3, y);
+            z3 = V::mla(V::mla(z4, b4, y), a3, o);
+            z4 = V::mla(V::mul(b5, y), a4, o);
+            sum = V::mla(sum, o, o);
+        }
+        V::store(state + ch, z1);
+        V::store(state + numChannels + ch, z2);
+        V::store(state + numChannels * 2 + ch, z3);
+        V::store(state + numChannels * 3 + ch, z4);
+        V::store(sumOfSquares + ch, V::add(V::load(sumOfSquares + ch), sum));
+    }
+
+    unsigned int frame = 0;
+    if ((ch < numChannels) && (numberOfFrames >= V::width * 8)) {
+        float responses[(V::width * 6 + 4) * 2];
+        scalar::biquadBlockResponses(coefficients, V::width, responses);
+        scalar::biquadBlockResponses(coefficients + 5, V::width, responses + V::width * 6 + 4);
+        frame = numberOfFrames - numberOfFrames % V::width;
+        unsigned int c = ch;
+        for (; c + 2 <= numChannels; c += 2) biquad2Blocks<2>(input, frame, numChannels, c, responses, state, sumOfSquares);
+        if (c < numChannels) biquad2Blocks<1>(input, frame, numChannels, c, responses, state, sumOfSquares);
+    }
+    scalar::biquad2SumOfSquares(input + (size_t)frame * numChannels, numberOfFrames - frame, numChannels, ch, coefficients, state, sumOfSquares);
+}
+
+// The vectors run along the frames of one channel, every phase is 12 multiply-adds on shifted loads of the input.
+static float TruePeak4x(float *input, unsigned int numberOfFrames, float *framePeaks) {
+    typename V::f peak = V::set1(0);
+    unsigned int n = 0;
+    for (; n + V::width <= numberOfFrames; n += V::width) {
+        typename V::f framePeak = V::abs(V::load(input + n - 6));
+        for (unsigned int phase = 0; phase < 4; phase++) {
+            const float *c = scalar::truePeakCoefficients[phase];
+            typename V::f sum = V::mul(V::load(input + n), V::set1(c[0]));
+            for (unsigned int k = 1; k < 12; k++) sum = V::mla(sum, V::load(input + n - k), V::set1(c[k]));
+            framePeak = V::max(framePeak, V::abs(sum));
+        }
+        if (framePeaks) V::store(framePeaks + n, V::max(V::load(framePeaks + n), framePeak));
+        peak = V::max(peak, framePeak);
+    }
+    const float vectorPeak = V::maximum(peak), tail = scalar::truePeak4x(input, n, numberOfFrames, framePeaks);
+    return vectorPeak > tail ? vectorPeak : tail;
+}
+
+// Batched FFT: 16 transforms are interleaved, value t of complex element k is at [k * 16 + t]. The vectors run along the transforms, so every twiddle is loaded once for 16 transforms.
+static void FFTBatchInterleave(float **inputs, unsigned int numValues, float *output) {
+    for (unsigned int n = 0; n < numValues; n += 4, output += 64) {
+        for (unsigned int t = 0; t < 16; t += 4) V::transpose4(inputs[t] + n, inputs[t + 1] + n, inputs[t + 2] + n, inputs[t + 3] + n, output + t, output + 16 + t, output + 32 + t, output + 48 + t);
+    }
+}
+
+static void FFTBatchDeInterleave(float *input, float **outputs, unsigned int numValues) {
+    for (unsigned int n = 0; n < numValues; n += 4, input += 64) {
+        for (unsigned int t = 0; t < 16; t += 4) V::transpose4(input + t, input + 16 + t, input + 32 + t, input + 48 + t, outputs[t] + n, outputs[t + 1] + n, outputs[t + 2] + n, outputs[t + 3] + n);
+    }
+}
+
+// (re + i * im) * (w[0] + i * w[1]), w[2] is -w[1].
+static inline void fftBatchTwiddle(typename V::f &re, typename V::f &im, const typename V::f *w) {
+    const typename V::f r = V::mla(V::mul(re, w[0]), im, w[2]);
+    im = V::mla(V::mul(re, w[1]), im, w[0]);
+    re = r;
+}
+
+// The butterflies of one p. The -i * (b - d) term goes to output row u, the +i * (b - d) term to row v, so the same code runs both directions.
+template <bool twiddled> static inline void fftBatchButterflies(const float *xr, const float *xi, unsigned int quarter, float *yr, float *yi, unsigned int block, unsigned int u, unsigned int v, const typename V::f *w) {
+    for (unsigned int k = 0; k < block; k += V::width) {
+        const typename V::f ar = V::load(xr + k), ai = V::load(xi + k), br = V::load(xr + quarter + k), bi = V::load(xi + quarter + k);
+        const typename V::f cr = V::load(xr + quarter * 2 + k), ci = V::load(xi + quarter * 2 + k), dr = V::load(xr + quarter * 3 + k), di = V::load(xi + quarter * 3 + k);
+        const typename V::f apcr = V::add(ar, cr), apci = V::add(ai, ci), amcr = V::sub(ar, cr), amci = V::sub(ai, ci);
+        const typename V::f bpdr = V::add(br, dr), bpdi = V::add(bi, di), bmdr = V::sub(br, dr), bmdi = V::sub(bi, di);
+        typename V::f r2 = V::sub(apcr, bpdr), i2 = V::sub(apci, bpdi), ur = V::add(amcr, bmdi), ui = V::sub(amci, bmdr), vr = V::sub(amcr, bmdi), vi = V::add(amci, bmdr);
+        if (twiddled) {
+            fftBatchTwiddle(r2, i2, w);
+            fftBatchTwiddle(ur, ui, w + 3);
+            fftBatchTwiddle(vr, vi, w + 6);
+        }
+        V::store(yr + k, V::add(apcr, bpdr));
+        V::store(yi + k, V::add(apci, bpdi));
+        V::store(yr + block * 2 + k, r2);
+        V::store(yi + block * 2 + k, i2);
+        V::store(yr + block * u + k, ur);
+        V::store(yi + block * u + k, ui);
+        V::store(yr + block * v + k, vr);
+        V::store(yi + block * v + k, vi);
+    }
+}
+
+static void FFTBatchRadix4(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, float *twiddles, unsigned int twiddleStride, bool forward) {
+    const unsigned int m = n / 4, block = stride * 16, quarter = m * block, u = forward ? 1 : 3, v = 4 - u;
+    const float sign = forward ? -1.0f : 1.0f;
+    fftBatchButterflies<false>(inReal, inImag, quarter, outReal, outImag, block, u, v, 0);
+    for (unsigned int p = 1; p < m; p++) {
+        const float *t2 = twiddles + p * 2 * twiddleStride * 2, *tu = twiddles + p * u * twiddleStride * 2, *tv = twiddles + p * v * twiddleStride * 2;
+        const typename V::f w[9] = {
+            V::set1(t2[0]), V::set1(t2[1] * sign), V::set1(-t2[1] * sign),
+            V::set1(tu[0]), V::set1(tu[1] * sign), V::set1(-tu[1] * sign),
+            V::set1(tv[0]), V::set1(tv[1] * sign), V::set1(-tv[1] * sign)
+        };
+        fftBatchButterflies<true>(inReal + p * block, inImag + p * block, quarter, outReal + p * 4 * block, outImag + p * 4 * block, block, u, v, w);
+    }
+}
+
+static void FFTBatchRadix2(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int stride) {
+    const unsigned int block = stride * 16;
+    for (unsigned int k = 0; k < block; k += V::width) {
+        const typename V::f ar = V::load(inReal + k), ai = V::load(inImag + k), br = V::load(inReal + block + k), bi = V::load(inImag + block + k);
+        V::store(outReal + k, V::add(ar, br));
+        V::store(outImag + k, V::add(ai, bi));
+        V::store(outReal + block + k, V::sub(ar, br));
+        V::store(outImag + block + k, V::sub(ai, bi));
+    }
+}
+
+static void FFTBatchRealSplit(float *real, float *imag, unsigned int half, float *twiddles, bool forward) {
+    const typename V::f two = V::set1(2.0f);
+    for (unsigned int t = 0; t < 16; t += V::width) {
+        const typename V::f dc = V::load(real + t), nyquist = V::load(imag + t);
+        V::store(real + t, forward ? V::mul(V::add(dc, nyquist), two) : V::add(dc, nyquist));
+        V::store(imag + t, forward ? V::mul(V::sub(dc, nyquist), two) : V::sub(dc, nyquist));
+    }
+    for (unsigned int k = 1; k <= half / 2; k++) {
+        float *rk = real + k * 16, *ik = imag + k * 16, *rm = real + (half - k) * 16, *im = imag + (half - k) * 16;
+        const typename V::f c = V::set1(twiddles[k * 2]), s = V::set1(twiddles[k * 2 + 1]), ns = V::set1(-twiddles[k * 2 + 1]);
+        for (unsigned int t = 0; t < 16; t += V::width) {
+            const typename V::f ar = V::load(rk + t), ai = V::load(ik + t), br = V::load(rm + t), mbi = V::load(im + t); // B = conj(Z[half - k]), mbi is -bi.
+            typename V::f xr, xi, yr, yi;
+            if (forward) { // The same as LargeFFT::realFFT.
+                const typename V::f sr = V::add(ar, br), si = V::sub(ai, mbi), dr = V::add(ai, mbi), di = V::sub(br, ar);
+                const typename V::f tr = V::mla(V::mul(dr, c), di, s), ti = V::mla(V::mul(di, c), dr, ns);
+                xr = V::add(sr, tr); xi = V::add(si, ti); yr = V::sub(sr, tr); yi = V::sub(ti, si);
+            } else {
+                const typename V::f pr = V::add(ar, br), pi = V::sub(ai, mbi), qr = V::sub(ar, br), qi = V::add(ai, mbi);
+                const typename V::f wr = V::mla(V::mul(qr, c), qi, ns), wi = V::mla(V::mul(qi, c), qr, s);
+                xr = V::sub(pr, wi); xi = V::add(pi, wr); yr = V::add(pr, wi); yi = V::sub(wr, pi);
+            }
+            V::store(rk + t, xr);
+            V::store(ik + t, xi);
+            V::store(rm + t, yr);
+            V::store(im + t, yi);
+        }
+    }
+}
+
+// In-place DFT of radix vectors, the same as scalar::mixedRadixDFT.
+template <unsigned int radix> static inline void mixedRadixDFT(typename V::f *re, typename V::f *im, bool forward) {
+    const float sign = forward ? -1.0f : 1.0f;
+    if (radix == 2) {
+        const typename V::f r = V::sub(re[0], re[1]), i = V::sub(im[0], im[1]);
+        re[0] = V::add(re[0], re[1]);
+        im[0] = V::add(im[0], im[1]);
+        re[1] = r;
+        im[1] = i;
+    } else if (radix == 3) {
+        const typename V::f ar = V::add(re[1], re[2]), ai = V::add(im[1], im[2]), s = V::set1(scalar::radix3Sin * sign), half = V::set1(-0.5f);
+        const typename V::f sr = V::mul(V::sub(re[1], re[2]), s), si = V::mul(V::sub(im[1], im[2]), s), cr = V::mla(re[0], ar, half), ci = V::mla(im[0], ai, half);
+        re[0] = V::add(re[0], ar);
+        im[0] = V::add(im[0], ai);
+        re[1] = V::sub(cr, si);
+        im[1] = V::add(ci, sr);
+        re[2] = V::add(cr, si);
+        im[2] = V::sub(ci, sr);
+    } else if (radix == 4) {
+        const typename V::f apcr = V::add(re[0], re[2]), apci = V::add(im[0], im[2]), amcr = V::sub(re[0], re[2]), amci = V::sub(im[0], im[2]);
+        const typename V::f bpdr = V::add(re[1], re[3]), bpdi = V::add(im[1], im[3]), bmdr = V::sub(re[1], re[3]), bmdi = V::sub(im[1], im[3]);
+        const typename V::f ur = V::add(amcr, bmdi), ui = V::sub(amci, bmdr), vr = V::sub(amcr, bmdi), vi = V::add(amci, bmdr);
+        re[0] = V::add(apcr, bpdr);
+        im[0] = V::add(apci, bpdi);
+        re[2] = V::sub(apcr, bpdr);
+        im[2] = V::sub(apci, bpdi);
+        re[1] = forward ? ur : vr;
+        im[1] = forward ? ui : vi;
+        re[3] = forward ? vr : ur;
+        im[3] = forward ? vi : ui;
+    } else if (radix == 5) {
+        const typename V::f c1 = V::set1(scalar::radix5Cos[0]), c2 = V::set1(scalar::radix5Cos[1]), s1 = V::set1(scalar::radix5Sin[0] * sign), s2 = V::set1(scalar::radix5Sin[1] * sign), ns1 = V::set1(-scalar::radix5Sin[0] * sign);
+        const typename V::f a1r = V::add(re[1], re[4]), a1i = V::add(im[1], im[4]), b1r = V::sub(re[1], re[4]), b1i = V::sub(im[1], im[4]);
+        const typename V::f a2r = V::add(re[2], re[3]), a2i = V::add(im[2], im[3]), b2r = V::sub(re[2], re[3]), b2i = V::sub(im[2], im[3]);
+        const typename V::f c1r = V::mla(V::mla(re[0], a1r, c1), a2r, c2), c1i = V::mla(V::mla(im[0], a1i, c1), a2i, c2), s1r = V::mla(V::mul(b1r, s1), b2r, s2), s1i = V::mla(V::mul(b1i, s1), b2i, s2);
+        const typename V::f c2r = V::mla(V::mla(re[0], a1r, c2), a2r, c1), c2i = V::mla(V::mla(im[0], a1i, c2), a2i, c1), s2r = V::mla(V::mul(b1r, s2), b2r, ns1), s2i = V::mla(V::mul(b1i, s2), b2i, ns1);
+        re[0] = V::add(re[0], V::add(a1r, a2r));
+        im[0] = V::add(im[0], V::add(a1i, a2i));
+        re[1] = V::sub(c1r, s1i);
+        im[1] = V::add(c1i, s1r);
+        re[4] = V::add(c1r, s1i);
+        im[4] = V::sub(c1i, s1r);
+        re[2] = V::sub(c2r, s2i);
+        im[2] = V::add(c2i, s2r);
+        re[3] = V::add(c2r, s2i);
+        im[3] = V::sub(c2i, s2r);
+    } else if (radix == 7) {
+        const typename V::f c1 = V::set1(scalar::radix7Cos[0]), c2 = V::set1(scalar::radix7Cos[1]), c3 = V::set1(scalar::radix7Cos[2]);
+        const typename V::f s1 = V::set1(scalar::radix7Sin[0] * sign), s2 = V::set1(scalar::radix7Sin[1] * sign), s3 = V::set1(scalar::radix7Sin[2] * sign), ns1 = V::set1(-scalar::radix7Sin[0] * sign), ns3 = V::set1(-scalar::radix7Sin[2] * sign);
+        const typename V::f a1r = V::add(re[1], re[6]), a1i = V::add(im[1], im[6]), b1r = V::sub(re[1], re[6]), b1i = V::sub(im[1], im[6]);
+        const typename V::f a2r = V::add(re[2], re[5]), a2i = V::add(im[2], im[5]), b2r = V::sub(re[2], re[5]), b2i = V::sub(im[2], im[5]);
+        const typename V::f a3r = V::add(re[3], re[4]), a3i = V::add(im[3], im[4]), b3r = V::sub(re[3], re[4]), b3i = V::sub(im[3], im[4]);
+        const typename V::f c1r = V::mla(V::mla(V::mla(re[0], a1r, c1), a2r, c2), a3r, c3), c1i = V::mla(V::mla(V::mla(im[0], a1i, c1), a2i, c2), a3i, c3);
+        const typename V::f c2r = V::mla(V::mla(V::mla(re[0], a1r, c2), a2r, c3), a3r, c1), c2i = V::mla(V::mla(V::mla(im[0], a1i, c2), a2i, c3), a3i, c1);
+        const typename V::f c3r = V::mla(V::mla(V::mla(re[0], a1r, c3), a2r, c1), a3r, c2), c3i = V::mla(V::mla(V::mla(im[0], a1i, c3), a2i, c1), a3i, c2);
+        const typename V::f s1r = V::mla(V::mla(V::mul(b1r, s1), b2r, s2), b3r, s3), s1i = V::mla(V::mla(V::mul(b1i, s1), b2i, s2), b3i, s3);
+        const typename V::f s2r = V::mla(V::mla(V::mul(b1r, s2), b2r, ns3), b3r, ns1), s2i = V::mla(V::mla(V::mul(b1i, s2), b2i, ns3), b3i, ns1);
+        const typename V::f s3r = V::mla(V::mla(V::mul(b1r, s3), b2r, ns1), b3r, s2), s3i = V::mla(V::mla(V::mul(b1i, s3), b2i, ns1), b3i, s2);
+        re[0] = V::add(re[0], V::add(V::add(a1r, a2r), a3r));
+        im[0] = V::add(im[0], V::add(V::add(a1i, a2i), a3i));
+        re[1] = V::sub(c1r, s1i);
+        im[1] = V::add(c1i, s1r);
+        re[6] = V::add(c1r, s1i);
+        im[6] = V::sub(c1i, s1r);
+        re[2] = V::sub(c2r, s2i);
+        im[2] = V::add(c2i, s2r);
+        re[5] = V::add(c2r, s2i);
+        im[5] = V::sub(c2i, s2r);
+        re[3] = V::sub(c3r, s3i);
+        im[3] = V::add(c3i, s3r);
+        re[4] = V::add(c3r, s3i);
+        im[4] = V::sub(c3i, s3r);
+    }
+}
+
+// y[k] * w[k], stored at k * stride. w holds the broadcast twiddles: real, imaginary and negative imaginary for every k.
+template <unsigned int k> static inline void mixedRadixTwiddle(const typename V::f *re, const typename V::f *im, const typename V::f *w, float *yr, float *yi, unsigned int stride) {
+    const typename V::f *t = w + (k - 1) * 3;
+    V::store(yr + k * stride, V::mla(V::mul(re[k], t[0]), im[k], t[2]));
+    V::store(yi + k * stride, V::mla(V::mul(re[k], t[1]), im[k], t[0]));
+}
+
+// The vectors run along q, so the stages with a stride below the vector width (the first one or two) use the scalar path, and so does the end of the stride.
+template <unsigned int radix> static void mixedRadixStage(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, float *twiddles, bool forward) {
+    const unsigned int m = n / radix, step = m * stride, vectorStride = stride - stride % V::width;
+    const float sign = forward ? -1.0f : 1.0f;
+    const float *t = twiddles;
+    for (unsigned int p = 0; p < m; p++, t += (radix - 1) * 2) {
+        const float *xr = inReal + p * stride, *xi = inImag + p * stride;
+        float *yr = outReal + p * radix * stride, *yi = outImag + p * radix * stride;
+        typename V::f w[(radix - 1) * 3];
+        for (unsigned int k = 0; k < radix - 1; k++) {
+            w[k * 3] = V::set1(t[k * 2]);
+            w[k * 3 + 1] = V::set1(t[k * 2 + 1] * sign);
+            w[k * 3 + 2] = V::set1(-t[k * 2 + 1] * sign);
+        }
+        for (unsigned int q = 0; q < vectorStride; q += V::width) {
+            typename V::f re[radix], im[radix];
+            re[0] = V::load(xr + q); im[0] = V::load(xi + q);
+            re[1] = V::load(xr + step + q); im[1] = V::load(xi + step + q);
+            if (radix > 2) { re[2] = V::load(xr + step * 2 + q); im[2] = V::load(xi + step * 2 + q); }
+            if (radix > 3) { re[3] = V::load(xr + step * 3 + q); im[3] = V::load(xi + step * 3 + q); }
+            if (radix > 4) { re[4] = V::load(xr + step * 4 + q); im[4] = V::load(xi + step * 4 + q); }
+            if (radix > 5) { re[5] = V::load(xr + step * 5 + q); im[5] = V::load(xi + step * 5 + q); }
+            if (radix > 6) { re[6] = V::load(xr + step * 6 + q); im[6] = V::load(xi + step * 6 + q); }
+            mixedRadixDFT<radix>(re, im, forward);
+            V::store(yr + q, re[0]);
+            V::store(yi + q, im[0]);
+            mixedRadixTwiddle<1>(re, im, w, yr + q, yi + q, stride);
+            if (radix > 2) mixedRadixTwiddle<2>(re, im, w, yr + q, yi + q, stride);
+            if (radix > 3) mixedRadixTwiddle<3>(re, im, w, yr + q, yi + q, stride);
+            if (radix > 4) mixedRadixTwiddle<4>(re, im, w, yr + q, yi + q, stride);
+            if (radix > 5) mixedRadixTwiddle<5>(re, im, w, yr + q, yi + q, stride);
+            if (radix > 6) mixedRadixTwiddle<6>(re, im, w, yr + q, yi + q, stride);
+        }
+    }
+    if (vectorStride < stride) scalar::mixedRadixStage<radix>(inReal, inImag, outReal, outImag, n, stride, vectorStride, twiddles, forward);
+}
+
+static void FFTMixedRadixStage(float *inReal, float *inImag, float *outReal, float *outImag, unsigned int n, unsigned int stride, unsigned int radix, float *twiddles, bool forward) {
+    if (stride < V::width) {
+        scalar::FFTMixedRadixStage(inReal, inImag, outReal, outImag, n, stride, radix, twiddles, forward);
+        return;
+    }
+    switch (radix) {
+        case 2: mixedRadixStage<2>(inReal, inImag, outReal, outImag, n, stride, twiddles, forward); break;
+        case 3: mixedRadixStage<3>(inReal, inImag, outReal, outImag, n, stride, twiddles, forward); break;
+        case 4: mixedRadixStage<4>(inReal, inImag, outReal, outImag, n, stride, twiddles, forward); break;
+        case 5: mixedRadixStage<5>(inReal, inImag, outReal, outImag, n, stride, twiddles, forward); break;
+        case 7: mixedRadixStage<7>(inReal, inImag, outReal, outImag, n, stride, twiddles, forward); break;
+        default: break;
+    }
+}
+
+// Double precision FFT stages. The vectors run along q, so the stages with a stride below the vector width (the first one or two) use the scalar path.
+template <bool twiddled> static inline void doubleButterflies(const double *xr, const double *xi, unsigned int quarter, double *yr, double *yi, unsigned int stride, unsigned int u, unsigned int v, const typename D::d *w) {
+    for (unsigned int q = 0; q < stride; q += D::width) {
+        const typename D::d ar = D::load(xr + q), ai = D::load(xi + q), br = D::load(xr + quarter + q), bi = D::load(xi + quarter + q);
+        const typename D::d cr = D::load(xr + quarter * 2 + q), ci = D::load(xi + quarter * 2 + q), dr = D::load(xr + quarter * 3 + q), di = D::load(xi + quarter * 3 + q);
+        const typename D::d apcr = D::add(ar, cr), apci = D::add(ai, ci), amcr = D::sub(ar, cr), amci = D::sub(ai, ci);
+        const typename D::d bpdr = D::add(br, dr), bpdi = D::add(bi, di), bmdr = D::sub(br, dr), bmdi = D::sub(bi, di);
+        typename D::d r2 = D::sub(apcr, bpdr), i2 = D::sub(apci, bpdi), ur = D::add(amcr, bmdi), ui = D::sub(amci, bmdr), vr = D::sub(amcr, bmdi), vi = D::add(amci, bmdr);
+        if (twiddled) { // (re + i * im) * (w[0] + i * w[1]), w[2] is -w[1].
+            typename D::d t = D::mla(D::mul(r2, w[0]), i2, w[2]);
+            i2 = D::mla(D::mul(r2, w[1]), i2, w[0]);
+            r2 = t;
+            t = D::mla(D::mul(ur, w[3]), ui, w[5]);
+            ui = D::mla(D::mul(ur, w[4]), ui, w[3]);
+            ur = t;
+            t = D::mla(D::mul(vr, w[6]), vi, w[8]);
+            vi = D::mla(D::mul(vr, w[7]), vi, w[6]);
+            vr = t;
+        }
+        D::store(yr + q, D::add(apcr, bpdr));
+        D::store(yi + q, D::add(apci, bpdi));
+        D::store(yr + stride * 2 + q, r2);
+        D::store(yi + stride * 2 + q, i2);
+        D::store(yr + stride * u + q, ur);
+        D::store(yi + stride * u + q, ui);
+        D::store(yr + stride * v + q, vr);
+        D::store(yi + stride * v + q, vi);
+    }
+}
+
+static void FFTDoubleRadix4(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int n, unsigned int stride, double *twiddles, unsigned int twiddleStride, bool forward) {
+    if (stride < D::width) {
+        scalar::FFTDoubleRadix4(inReal, inImag, outReal, outImag, n, stride, twiddles, twiddleStride, forward);
+        return;
+    }
+    const unsigned int m = n / 4, quarter = m * stride, u = forward ? 1 : 3, v = 4 - u;
+    const double sign = forward ? -1.0 : 1.0;
+    doubleButterflies<false>(inReal, inImag, quarter, outReal, outImag, stride, u, v, 0);
+    for (unsigned int p = 1; p < m; p++) {
+        const double *t2 = twiddles + p * 2 * twiddleStride * 2, *tu = twiddles + p * u * twiddleStride * 2, *tv = twiddles + p * v * twiddleStride * 2;
+        const typename D::d w[9] = {
+            D::set1(t2[0]), D::set1(t2[1] * sign), D::set1(-t2[1] * sign),
+            D::set1(tu[0]), D::set1(tu[1] * sign), D::set1(-tu[1] * sign),
+            D::set1(tv[0]), D::set1(tv[1] * sign), D::set1(-tv[1] * sign)
+        };
+        doubleButterflies<true>(inReal + p * stride, inImag + p * stride, quarter, outReal + p * 4 * stride, outImag + p * 4 * stride, stride, u, v, w);
+    }
+}
+
+static void FFTDoubleRadix2(double *inReal, double *inImag, double *outReal, double *outImag, unsigned int stride) {
+    if (stride < D::width) {
+        scalar::FFTDoubleRadix2(inReal, inImag, outReal, outImag, stride);
+        return;
+    }
+    for (unsigned int q = 0; q < stride; q += D::width) {
+        const typename D::d ar = D::load(inReal + q), ai = D::load(inImag + q), br = D::load(inReal + stride + q), bi = D::load(inImag + stride + q);
+        D::store(outReal + q, D::add(ar, br));
+        D::store(outImag + q, D::add(ai, bi));
+        D::store(outReal + stride + q, D::sub(ar, br));
+        D::store(outImag + stride + q, D::sub(ai, bi));
+    }
+}
+
+// Two vectors per step with separate accumulators for the four partial products, so the multiply-adds of the products don't wait for each other.
+static void ComplexMultiplyAccumulate(float **aReal, float **aImag, float **bReal, float **bImag, unsigned int numProducts, float *outReal, float *outImag, unsigned int numValues, bool realFFTPacking) {
+    unsigned int n = 0;
+    for (; n + V::width * 2 <= numValues; n += V::width * 2) {
+        const typename V::f zero = V::set1(0);
+        typename V::f rr0 = zero, ii0 = zero, ri0 = zero, ir0 = zero, rr1 = zero, ii1 = zero, ri1 = zero, ir1 = zero;
+        for (unsigned int p = 0; p < numProducts; p++) {
+            const float *ar = aReal[p] + n, *ai = aImag[p] + n, *br = bReal[p] + n, *bi = bImag[p] + n;
+            typename V::f x = V::load(ar), y = V::load(ai), u = V::load(br), v = V::load(bi);
+            rr0 = V::mla(rr0, x, u);
+            ii0 = V::mla(ii0, y, v);
+            ri0 = V::mla(ri0, x, v);
+            ir0 = V::mla(ir0, y, u);
+            x = V::load(ar + V::width);
+            y = V::load(ai + V::width);
+            u = V::load(br + V::width);
+            v = V::load(bi + V::width);
+            rr1 = V::mla(rr1, x, u);
+            ii1 = V::mla(ii1, y, v);
+            ri1 = V::mla(ri1, x, v);
+            ir1 = V::mla(ir1, y, u);
+        }
+        V::store(outReal + n, V::sub(rr0, ii0));
+        V::store(outImag + n, V::add(ri0, ir0));
+        V::store(outReal + n + V::width, V::sub(rr1, ii1));
+        V::store(outImag + n + V::width, V::add(ri1, ir1));
+    }
+    scalar::complexMultiplyAccumulate(aReal, aImag, bReal, bImag, numProducts, outReal, outImag, n, numValues);
+    if (realFFTPacking && numValues) scalar::realFFTPackedFirst(aReal, aImag, bReal, bImag, numProducts, outReal, outImag);
+}
+
+// One row at a time, with separate accumulators for the four partial products.
+static void SparseComplexDotProducts(float *inReal, float *inImag, float *matrixReal, float *matrixImag, unsigned int *bandStart, unsigned int *bandLength, unsigned int numRows, float *outReal, float *outImag) {
+    for (unsigned int row = 0; row < numRows; row++) {
+        const float *xr = inReal + bandStart[row], *xi = inImag + bandStart[row];
+        const unsigned int length = bandLength[row];
+        const typename V::f zero = V::set1(0);
+        typename V::f rr = zero, ii = zero, ri = zero, ir = zero;
+        unsigned int n = 0;
+        for (; n + V::width <= length; n += V::width) {
+            const typename V::f x = V::load(xr + n), y = V::load(xi + n), u = V::load(matrixReal + n), v = V::load(matrixImag + n);
+            rr = V::mla(rr, x, u);
+            ii = V::mla(ii, y, v);
+            ri = V::mla(ri, x, v);
+            ir = V::mla(ir, y, u);
+        }
+        float real = V::sum(V::sub(rr, ii)), imag = V::sum(V::add(ri, ir));
+        scalar::sparseComplexDotProduct(xr, xi, matrixReal, matrixImag, n, length, real, imag);
+        outReal[row] = real;
+        outImag[row] = imag;
+        matrixReal += length;
+        matrixImag += length;
+    }
+}
+
+static const kernelTable table = {
+    Volume, ChangeVolume, VolumeAdd, ChangeVolumeAdd, CrossStereo, Interleave, DeInterleave, ShortIntToFloat, FloatToShortInt, Add1, Add2, Add4, DotProduct, Peak,
+    volumeMultichannel<false, true>, volumeMultichannel<false, false>, volumeMultichannel<true, true>, volumeMultichannel<true, false>,
+    IntToFloatGetPeaks, dither, MixN,
+    FloatToHalf, HalfToFloat, FloatToBFloat16, BFloat16ToFloat,
+    PolyphaseFIR, Biquad2SumOfSquares, TruePeak4x,
+    FFTBatchInterleave, FFTBatchDeInterleave, FFTBatchRadix4, FFTBatchRadix2, FFTBatchRealSplit, FFTMixedRadixStage,
+    FFTDoubleRadix4, FFTDoubleRadix2, ComplexMultiplyAccumulate, SparseComplexDotProducts
+};
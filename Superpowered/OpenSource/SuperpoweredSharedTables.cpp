@@ -0,0 +1,113 @@
+#include "SuperpoweredSharedTables.h"
+#include <mutex>
+#include <math.h>
+#include <stdlib.h>
+
+namespace Superpowered {
+namespace SharedTables {
+
+typedef enum Kind {
+    Kind_HannWindow,
+    Kind_Twiddles,
+    Kind_DoubleTwiddles
+} Kind;
+
+struct table {
+    table *next;
+    void *data;
+    unsigned int size, bytes, references;
+    Kind kind;
+};
+
+static std::mutex mutex;
+static table *tables = NULL; // A short list, only one entry per kind and size.
+
+static void *create(Kind kind, unsigned int size, unsigned int *bytes) {
+    switch (kind) {
+        case Kind_HannWindow: {
+            float *window = (float *)malloc(size * sizeof(float));
+            if (window) for (unsigned int n = 0; n < size; n++) window[n] = float(0.5 - 0.5 * cos(2.0 * M_PI * double(n) / double(size)));
+            *bytes = size * sizeof(float);
+            return window;
+        }
+        case Kind_Twiddles: {
+            float *twiddles = (float *)malloc(size * 2 * sizeof(float));
+            if (twiddles) for (unsigned int j = 0; j < size; j++) {
+                twiddles[j * 2] = (float)cos(2.0 * M_PI * double(j) / double(size));
+                twiddles[j * 2 + 1] = (float)sin(2.0 * M_PI * double(j) / double(size));
+            }
+            *bytes = size * 2 * sizeof(float);
+            return twiddles;
+        }
+        case Kind_DoubleTwiddles: {
+            const unsigned int count = size / 4 * 3;
+            double *twiddles = (double *)malloc(count * 2 * sizeof(double));
+            if (twiddles) for (unsigned int j = 0; j < count; j++) {
+                const long double angle = 2.0L * 3.14159265358979323846264338327950288L * (long double)j / (long double)size;
+                twiddles[j * 2] = (double)cosl(angle);
+                twiddles[j * 2 + 1] = (double)sinl(angle);
+            }
+            *bytes = count * 2 * sizeof(double);
+            return twiddles;
+        }
+    }
+    return NULL;
+}
+
+static const void *acquire(Kind kind, unsigned int size) {
+    if (!size) return NULL;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (table *t = tables; t; t = t->next) if ((t->kind == kind) && (t->size == size)) {
+        t->references++;
+        return t->data;
+    }
+
+    unsigned int bytes = 0;
+    void *data = create(kind, size, &bytes);
+    if (!data) return NULL;
+    table *t = new table;
+    t->data = data;
+    t->size = size;
+    t->bytes = bytes;
+    t->references = 1;
+    t->kind = kind;
+    t->next = tables;
+    tables = t;
+    return data;
+}
+
+const float *acquireHannWindow(unsigned int size) {
+    return (const float *)acquire(Kind_HannWindow, size);
+}
+
+const float *acquireTwiddles(unsigned int size) {
+    return (const float *)acquire(Kind_Twiddles, size);
+}
+
+const double *acquireDoubleTwiddles(unsigned int size) {
+    return (const double *)acquire(Kind_DoubleTwiddles, size);
+}
+
+void release(const void *data) {
+    if (!data) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (table **t = &tables; *t; t = &(*t)->next) if ((*t)->data == data) {
+        table *found = *t;
+        if (--found->references == 0) {
+            *t = found->next;
+            free(found->data);
+            delete found;
+        }
+        return;
+    }
+}
+
+unsigned int getMemoryUsage() {
+    std::lock_guard<std::mutex> lock(mutex);
+    unsigned int bytes = 0;
+    for (table *t = tables; t; t = t->next) bytes += t->bytes;
+    return bytes;
+}
+
+}
+}
@@ -0,0 +1,34 @@
+#ifndef Header_SuperpoweredSharedTables
+#define Header_SuperpoweredSharedTables
+
+namespace Superpowered {
+
+/// @brief Process-wide read-only tables (windows and twiddles), shared by every instance of the open-source spectral classes with the same size.
+/// Tables are reference counted: the first instance creates a table, the last one frees it. With hundreds of instances of the same size (one per voice in a polyphonic spectral effect for example) only one copy stays in the cache.
+/// Acquiring and releasing is thread-safe, but locks and may allocate: call these in constructors and destructors, not in the audio processing thread.
+namespace SharedTables {
+
+/// @return Returns with a periodic Hann window of size values: 0.5 - 0.5 * cos(2 * pi * n / size). Read-only, call release() when not needed anymore.
+/// @param size The window size.
+const float *acquireHannWindow(unsigned int size);
+
+/// @return Returns with size pairs of cos(2 * pi * j / size), sin(2 * pi * j / size). Read-only, call release() when not needed anymore.
+/// @param size The number of pairs, typically the FFT size.
+const float *acquireTwiddles(unsigned int size);
+
+/// @return Returns with 3 / 4 * size pairs of cos(2 * pi * j / size), sin(2 * pi * j / size) in double precision (computed in long double). Read-only, call release() when not needed anymore.
+/// @param size The FFT size, a multiple of 4.
+const double *acquireDoubleTwiddles(unsigned int size);
+
+/// @brief Releases a table returned by one of the acquire functions. Does nothing if table is NULL.
+/// @param table The table.
+void release(const void *table);
+
+/// @return Returns with the memory used by all shared tables in bytes.
+unsigned int getMemoryUsage();
+
+}
+
+}
+
+#endif
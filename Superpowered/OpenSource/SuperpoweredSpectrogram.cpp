@@ -0,0 +1,347 @@
+#include "SuperpoweredSpectrogram.h"
+#include "SuperpoweredSharedTables.h"
+#include "SuperpoweredSIMD.h"
+#include "SuperpoweredFFT.h"
+#include "SuperpoweredDecoder.h"
+#include <atomic>
+#include <thread>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if _WIN32
+#include "Windows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Superpowered {
+
+static const unsigned int minimumLogSize = 8, maximumLogSize = 13, maximumThreads = 64, framesPerRegion = 32, headerBytes = 64, minimumDecodeFrames = 1024;
+
+struct spectrogramInternals {
+    const float *window;            // Periodic Hann, fftSize, shared between instances.
+    float *weights;                 // The triangle of every mel band over its bins, band after band. NULL for the linear scale.
+    unsigned int *bandStart, *bandLength;
+    float *frequencies;
+    unsigned int samplerate, fftLogSize, fftSize, hop, numBands, firstBin, numThreads;
+};
+
+// One process(), render() call. The threads take regions of framesPerRegion frames until all are done.
+struct spectrogramJob {
+    spectrogramInternals *internals;
+    const float *input;
+    void *output;
+    std::atomic<unsigned int> nextRegion;
+    unsigned int numberOfInputFrames, numFrames, numRegions;
+    float minimumDb, maximumDb;
+    Spectrogram::Format format;
+};
+
+static inline double hzToMel(double hz) {
+    return 2595.0 * log10(1.0 + hz / 700.0);
+}
+
+static inline double melToHz(double mel) {
+    return 700.0 * (pow(10.0, mel / 2595.0) - 1.0);
+}
+
+Spectrogram::Spectrogram(unsigned int samplerate, unsigned int fftLogSize, unsigned int hopFrames, unsigned int numberOfMelBands, float minimumFrequency, float maximumFrequency, unsigned int numberOfThreads) {
+    if (samplerate < 1) samplerate = 1;
+    if (fftLogSize < minimumLogSize) fftLogSize = minimumLogSize; else if (fftLogSize > maximumLogSize) fftLogSize = maximumLogSize;
+    if (!numberOfThreads) numberOfThreads = std::thread::hardware_concurrency();
+    if (numberOfThreads < 1) numberOfThreads = 1; else if (numberOfThreads > maximumThreads) numberOfThreads = maximumThreads;
+    const float nyquist = float(samplerate) * 0.5f;
+    if ((maximumFrequency <= 0) || (maximumFrequency > nyquist)) maximumFrequency = nyquist;
+    if (minimumFrequency < 0) minimumFrequency = 0; else if (minimumFrequency > maximumFrequency) minimumFrequency = maximumFrequency;
+
+    internals = new spectrogramInternals;
+    internals->samplerate = samplerate;
+    internals->fftLogSize = fftLogSize;
+    internals->fftSize = 1u << fftLogSize;
+    internals->hop = hopFrames ? hopFrames : 1;
+    internals->numThreads = numberOfThreads;
+    internals->window = SharedTables::acquireHannWindow(internals->fftSize);
+    const unsigned int numBins = internals->fftSize / 2; // DC to Nyquist - 1.
+    const double binHz = double(samplerate) / double(internals->fftSize);
+
+    if (!numberOfMelBands) {
+        unsigned int first = (unsigned int)ceil(double(minimumFrequency) / binHz), last = (unsigned int)floor(double(maximumFrequency) / binHz);
+        if (last >= numBins) last = numBins - 1;
+        if (first > last) first = last;
+        internals->firstBin = first;
+        internals->numBands = last - first + 1;
+        internals->weights = NULL;
+        internals->bandStart = internals->bandLength = NULL;
+        internals->frequencies = new float[internals->numBands];
+        for (unsigned int b = 0; b < internals->numBands; b++) internals->frequencies[b] = float(double(first + b) * binHz);
+        return;
+    }
+
+    // Mel bands: triangles between the centers of the neighbouring bands, equally spaced on the mel scale.
+    internals->firstBin = 0;
+    internals->numBands = numberOfMelBands;
+    internals->frequencies = new float[numberOfMelBands];
+    internals->bandStart = new unsigned int[numberOfMelBands];
+    internals->bandLength = new unsigned int[numberOfMelBands];
+    const double melMin = hzToMel(minimumFrequency), melStep = (hzToMel(maximumFrequency) - melMin) / double(numberOfMelBands + 1);
+    unsigned int numWeights = 0;
+    for (int pass = 0; pass < 2; pass++) { // The first pass counts the weights, the second one stores them.
+        if (pass) internals->weights = new float[numWeights];
+        float *weights = internals->weights;
+        for (unsigned int b = 0; b < numberOfMelBands; b++) {
+            const double low = melToHz(melMin + melStep * double(b)), center = melToHz(melMin + melStep * double(b + 1)), high = melToHz(melMin + melStep * double(b + 2));
+            unsigned int start = (unsigned int)floor(low / binHz) + 1, end = (unsigned int)ceil(high / binHz);
+            if (end > numBins) end = numBins;
+            if (start >= end) { // Narrower than a bin: the nearest bin.
+                start = (unsigned int)floor(center / binHz + 0.5);
+                if (start >= numBins) start = numBins - 1;
+                end = start + 1;
+                if (pass) weights[0] = 1.0f;
+            } else if (pass) for (unsigned int j = start; j < end; j++) {
+                const double hz = double(j) * binHz;
+                weights[j - start] = float((hz <= center) ? (hz - low) / (center - low) : (high - hz) / (high - center));
+            }
+            if (pass) {
+                internals->frequencies[b] = float(center);
+                internals->bandStart[b] = start;
+                internals->bandLength[b] = end - start;
+                weights += end - start;
+            } else numWeights += end - start;
+        }
+    }
+}
+
+Spectrogram::~Spectrogram() {
+    SharedTables::release(internals->window);
+    delete[] internals->weights;
+    delete[] internals->bandStart;
+    delete[] internals->bandLength;
+    delete[] internals->frequencies;
+    delete internals;
+}
+
+unsigned int Spectrogram::getNumberOfBands() {
+    return internals->numBands;
+}
+
+float Spectrogram::getFrequency(unsigned int band) {
+    return (band < internals->numBands) ? internals->frequencies[band] : 0;
+}
+
+unsigned int Spectrogram::getNumberOfFrames(unsigned int numberOfFrames) {
+    return (numberOfFrames + internals->hop - 1) / internals->hop;
+}
+
+// Decibels of one frame to db, numBands big. real, imag and power are fftSize / 2 big.
+static void transformFrame(spectrogramInternals *internals, const float *input, unsigned int numberOfFrames, unsigned int frame, float minimumDb, float *real, float *imag, float *power, float *db) {
+    const unsigned int fftSize = internals->fftSize, half = fftSize / 2;
+    const long long first = (long long)frame * internals->hop - half;
+    const float *window = internals->window;
+    if ((first >= 0) && (first + fftSize <= numberOfFrames)) {
+        const float *x = input + first;
+        for (unsigned int n = 0; n < half; n++) {
+            real[n] = x[n * 2] * window[n * 2];
+            imag[n] = x[n * 2 + 1] * window[n * 2 + 1];
+        }
+    } else for (unsigned int n = 0; n < half; n++) { // The frame reaches over the start or the end of the signal.
+        const long long even = first + n * 2, odd = even + 1;
+        real[n] = ((even >= 0) && (even < numberOfFrames)) ? input[even] * window[n * 2] : 0;
+        imag[n] = ((odd >= 0) && (odd < numberOfFrames)) ? input[odd] * window[n * 2 + 1] : 0;
+    }
+    FFTReal(real, imag, (int)internals->fftLogSize, true);
+
+    // A full-scale sine wave at the center of a bin has a magnitude of fftSize / 2. The DC is in real[0] with 2x the level of the other bins, the Nyquist in imag[0] is dropped.
+    const float scale = 4.0f / (float(fftSize) * float(fftSize)), minimumPower = powf(10.0f, minimumDb * 0.1f);
+    power[0] = real[0] * real[0] * 0.25f * scale;
+    for (unsigned int j = 1; j < half; j++) power[j] = (real[j] * real[j] + imag[j] * imag[j]) * scale;
+
+    if (internals->weights) {
+        float *weights = internals->weights;
+        for (unsigned int b = 0; b < internals->numBands; b++) {
+            const float p = SIMD::DotProduct(power + internals->bandStart[b], weights, internals->bandLength[b]);
+            db[b] = 10.0f * log10f(p > minimumPower ? p : minimumPower);
+            weights += internals->bandLength[b];
+        }
+    } else for (unsigned int b = 0; b < internals->numBands; b++) {
+        const float p = power[internals->firstBin + b];
+        db[b] = 10.0f * log10f(p > minimumPower ? p : minimumPower);
+    }
+}
+
+static void storeFrame(spectrogramJob *job, unsigned int frame, float *db) {
+    const unsigned int numBands = job->internals->numBands;
+    const size_t index = (size_t)frame * numBands;
+    switch (job->format) {
+        case Spectrogram::Format_Float32: memcpy((float *)job->output + index, db, numBands * sizeof(float)); break;
+        case Spectrogram::Format_Float16: SIMD::FloatToHalf(db, (unsigned short *)job->output + index, numBands); break;
+        case Spectrogram::Format_UInt8: {
+            unsigned char *output = (unsigned char *)job->output + index;
+            const float range = job->maximumDb - job->minimumDb, mul = (range > 0) ? 255.0f / range : 0;
+            for (unsigned int b = 0; b < numBands; b++) {
+                const float v = (db[b] - job->minimumDb) * mul + 0.5f;
+                output[b] = (v <= 0) ? 0 : ((v >= 255.0f) ? 255 : (unsigned char)v);
+            }
+        } break;
+    }
+}
+
+static void work(spectrogramJob *job) {
+    spectrogramInternals *internals = job->internals;
+    const unsigned int half = internals->fftSize / 2;
+    float *buffer = (float *)malloc((half * 3 + internals->numBands) * sizeof(float));
+    if (!buffer) return;
+    float *real = buffer, *imag = buffer + half, *power = imag + half, *db = power + half;
+
+    unsigned int region;
+    while ((region = job->nextRegion.fetch_add(1)) < job->numRegions) {
+        const unsigned int first = region * framesPerRegion, last = (first + framesPerRegion < job->numFrames) ? first + framesPerRegion : job->numFrames;
+        for (unsigned int frame = first; frame < last; frame++) {
+            transformFrame(internals, job->input, job->numberOfInputFrames, frame, job->minimumDb, real, imag, power, db);
+            storeFrame(job, frame, db);
+        }
+    }
+    free(buffer);
+}
+
+// Every region on the calling thread and the pool. Returns when all are done.
+static void run(spectrogramInternals *internals, const float *input, unsigned int numberOfFrames, void *output, Spectrogram::Format format, float minimumDb, float maximumDb) {
+    spectrogramJob job;
+    job.internals = internals;
+    job.input = input;
+    job.output = output;
+    job.nextRegion.store(0);
+    job.numberOfInputFrames = numberOfFrames;
+    job.numFrames = (numberOfFrames + internals->hop - 1) / internals->hop;
+    job.numRegions = (job.numFrames + framesPerRegion - 1) / framesPerRegion;
+    job.minimumDb = minimumDb;
+    job.maximumDb = maximumDb;
+    job.format = format;
+
+    unsigned int numThreads = (job.numRegions < internals->numThreads) ? job.numRegions : internals->numThreads;
+    if (numThreads < 1) numThreads = 1;
+    std::thread **threads = new std::thread *[numThreads];
+    for (unsigned int n = 1; n < numThreads; n++) threads[n] = new std::thread(work, &job);
+    work(&job);
+    for (unsigned int n = 1; n < numThreads; n++) {
+        threads[n]->join();
+        delete threads[n];
+    }
+    delete[] threads;
+}
+
+void Spectrogram::process(float *input, unsigned int numberOfFrames, float *output, float minimumDb) {
+    if (!input || !output || !numberOfFrames) return;
+    run(internals, input, numberOfFrames, output, Format_Float32, minimumDb, 0);
+}
+
+// A writable memory mapping of a new file.
+struct mappedFile {
+    void *data;
+    size_t bytes;
+#if _WIN32
+    HANDLE file, mapping;
+#else
+    int file;
+#endif
+};
+
+static bool mapFile(mappedFile *map, const char *path, size_t bytes) {
+    map->bytes = bytes;
+#if _WIN32
+    map->file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (map->file == INVALID_HANDLE_VALUE) return false;
+    map->mapping = CreateFileMappingA(map->file, NULL, PAGE_READWRITE, (DWORD)((unsigned long long)bytes >> 32), (DWORD)(bytes & 0xffffffff), NULL);
+    map->data = map->mapping ? MapViewOfFile(map->mapping, FILE_MAP_WRITE, 0, 0, bytes) : NULL;
+    if (map->data) return true;
+    if (map->mapping) CloseHandle(map->mapping);
+    CloseHandle(map->file);
+#else
+    map->file = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (map->file < 0) return false;
+    if (ftruncate(map->file, (off_t)bytes) == 0) {
+        map->data = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, map->file, 0);
+        if (map->data != MAP_FAILED) return true;
+    }
+    close(map->file);
+#endif
+    return false;
+}
+
+static void unmapFile(mappedFile *map) {
+#if _WIN32
+    UnmapViewOfFile(map->data);
+    CloseHandle(map->mapping);
+    CloseHandle(map->file);
+#else
+    munmap(map->data, map->bytes);
+    close(map->file);
+#endif
+}
+
+bool Spectrogram::render(float *input, unsigned int numberOfFrames, const char *path, Format format, float minimumDb, float maximumDb) {
+    if (!path || (!input && numberOfFrames)) return false;
+    const unsigned int numFrames = getNumberOfFrames(numberOfFrames), bytesPerValue = (format == Format_Float32) ? 4 : ((format == Format_Float16) ? 2 : 1);
+    mappedFile map;
+    if (!mapFile(&map, path, headerBytes + (size_t)numFrames * internals->numBands * bytesPerValue)) return false;
+
+    unsigned int header[headerBytes / 4];
+    memset(header, 0, headerBytes);
+    memcpy(header, "SPSG", 4);
+    header[1] = 1;
+    header[2] = (unsigned int)format;
+    header[3] = numFrames;
+    header[4] = internals->numBands;
+    header[5] = internals->hop;
+    header[6] = internals->samplerate;
+    header[7] = internals->fftSize;
+    memcpy(header + 8, &minimumDb, 4);
+    memcpy(header + 9, &maximumDb, 4);
+    memcpy(map.data, header, headerBytes);
+
+    if (numFrames) run(internals, input, numberOfFrames, (unsigned char *)map.data + headerBytes, format, minimumDb, maximumDb);
+    unmapFile(&map);
+    return true;
+}
+
+int Spectrogram::renderFile(const char *audioPath, const char *path, Format format, float minimumDb, float maximumDb) {
+    Decoder decoder;
+    const int openResult = decoder.open(audioPath);
+    if (openResult != Decoder::OpenSuccess) return openResult;
+    if (decoder.getSamplerate() != internals->samplerate) return Decoder::Error;
+
+    unsigned int framesPerChunk = decoder.getFramesPerChunk(), capacity = (decoder.getDurationFrames() > 0) ? (unsigned int)decoder.getDurationFrames() : 0, numberOfFrames = 0;
+    if (framesPerChunk < minimumDecodeFrames) framesPerChunk = minimumDecodeFrames;
+    short int *pcm = (short int *)malloc(framesPerChunk * 4 + 16384);
+    float *stereo = (float *)malloc(framesPerChunk * 2 * sizeof(float)), *mono = capacity ? (float *)malloc(capacity * sizeof(float)) : NULL;
+    int result = (pcm && stereo && (mono || !capacity)) ? 1 : Decoder::Error;
+
+    while (result > 0) {
+        result = decoder.decodeAudio(pcm, framesPerChunk);
+        if (result <= 0) break;
+        const unsigned int decoded = (unsigned int)result;
+        if (numberOfFrames + decoded > capacity) { // The duration may change while decoding.
+            const unsigned int newCapacity = (numberOfFrames + decoded) * 2;
+            float *grown = (float *)realloc(mono, newCapacity * sizeof(float));
+            if (!grown) {
+                result = Decoder::Error;
+                break;
+            }
+            mono = grown;
+            capacity = newCapacity;
+        }
+        SIMD::ShortIntToFloat(pcm, stereo, decoded, 2);
+        for (unsigned int n = 0; n < decoded; n++) mono[numberOfFrames + n] = (stereo[n * 2] + stereo[n * 2 + 1]) * 0.5f;
+        numberOfFrames += decoded;
+    }
+    free(pcm);
+    free(stereo);
+
+    if ((result == Decoder::EndOfFile) && !render(mono, numberOfFrames, path, format, minimumDb, maximumDb)) result = Decoder::Error;
+    free(mono);
+    return (result == Decoder::EndOfFile) ? 0 : Decoder::Error;
+}
+
+}
@@ -0,0 +1,80 @@
+#ifndef Header_SuperpoweredSpectrogram
+#define Header_SuperpoweredSpectrogram
+
+namespace Superpowered {
+
+struct spectrogramInternals;
+
+/// @brief Offline spectrogram renderer for images and feature matrices of complete tracks. Log-magnitude (decibel) frames on a linear or mel frequency scale.
+/// The frames are split into regions which are transformed on a pool of threads in parallel. Every region reads its own overlapping span of the input, so the result is the same for any number of threads.
+/// Frame n is centered at input frame n * hopFrames with a periodic Hann window, the signal is padded with silence on both sides. A full-scale sine wave at the center of a bin or band is 0 dB.
+/// render() and renderFile() write a matrix file through a memory mapping, so the output is never kept in memory as a whole. The file layout (little endian):
+/// - 64 bytes header: "SPSG" (4 chars), version (uint32, 1), format (uint32, Format), number of frames (uint32), number of bands (uint32), hop frames (uint32), samplerate (uint32), FFT size (uint32), minimum and maximum decibel (2 float32), 24 bytes reserved (zeros).
+/// - The values of every frame, frame after frame, the lowest band first.
+/// One instance can not be used on multiple threads concurrently.
+class Spectrogram {
+public:
+    /// @brief Value formats.
+    typedef enum Format {
+        Format_Float32 = 0, ///< Decibels as 32-bit floating point numbers, limited to minimumDb.
+        Format_Float16 = 1, ///< Decibels as IEEE 754 half precision (fp16) numbers, limited to minimumDb.
+        Format_UInt8 = 2    ///< 0 for minimumDb (and below), 255 for maximumDb (and above), linear in decibels between them.
+    } Format;
+
+/// @brief Constructor.
+/// @param samplerate The sample rate of the input in Hz.
+/// @param fftLogSize FFT log size, between 8 and 13 (FFT 256 - 8192).
+/// @param hopFrames The distance between the centers of two frames in frames.
+/// @param numberOfMelBands The number of mel bands (triangular filters on the power spectrum, HTK mel scale). 0 outputs the FFT bins on a linear scale.
+/// @param minimumFrequency The lowest frequency in Hz. Bands or bins below are not output.
+/// @param maximumFrequency The highest frequency in Hz. 0 means samplerate / 2.
+/// @param numberOfThreads The number of threads to transform on, including the calling thread. 0 means the number of CPU cores.
+    Spectrogram(unsigned int samplerate, unsigned int fftLogSize = 11, unsigned int hopFrames = 512, unsigned int numberOfMelBands = 0, float minimumFrequency = 0, float maximumFrequency = 0, unsigned int numberOfThreads = 0);
+    ~Spectrogram();
+
+/// @return Returns with the number of values in a frame (mel bands or FFT bins).
+    unsigned int getNumberOfBands();
+
+/// @return Returns with the center frequency of a band or bin in Hz.
+/// @param band The index of the band, 0 is the lowest.
+    float getFrequency(unsigned int band);
+
+/// @return Returns with the number of frames for numberOfFrames input.
+/// @param numberOfFrames The number of input frames.
+    unsigned int getNumberOfFrames(unsigned int numberOfFrames);
+
+/// @brief Transforms a complete signal to memory.
+/// @param input Pointer to floating point numbers. 32-bit mono input.
+/// @param numberOfFrames The number of input frames.
+/// @param output Pointer to floating point numbers, getNumberOfFrames(numberOfFrames) * getNumberOfBands() big. Output: decibels, limited to minimumDb.
+/// @param minimumDb The lowest decibel value.
+    void process(float *input, unsigned int numberOfFrames, float *output, float minimumDb = -120.0f);
+
+/// @brief Transforms a complete signal to a matrix file. An existing file is overwritten.
+/// @return Returns with false if the file can not be created or mapped.
+/// @param input Pointer to floating point numbers. 32-bit mono input.
+/// @param numberOfFrames The number of input frames.
+/// @param path The file system path of the output file.
+/// @param format Value format.
+/// @param minimumDb The lowest decibel value.
+/// @param maximumDb The highest decibel value, used by Format_UInt8 only.
+    bool render(float *input, unsigned int numberOfFrames, const char *path, Format format = Format_UInt8, float minimumDb = -100.0f, float maximumDb = 0);
+
+/// @brief Decodes an audio file with Decoder, mixes it to mono, then transforms it to a matrix file with render().
+/// @return Returns with 0 on success, the open() error code of Decoder if the file can not be opened, or Decoder::Error if decoding or writing failed or the sample rate of the file is different.
+/// @param audioPath The file system path of the audio file.
+/// @param path The file system path of the output file.
+/// @param format Value format.
+/// @param minimumDb The lowest decibel value.
+/// @param maximumDb The highest decibel value, used by Format_UInt8 only.
+    int renderFile(const char *audioPath, const char *path, Format format = Format_UInt8, float minimumDb = -100.0f, float maximumDb = 0);
+
+private:
+    spectrogramInternals *internals;
+    Spectrogram(const Spectrogram&);
+    Spectrogram& operator=(const Spectrogram&);
+};
+
+}
+
+#endif
@@ -0,0 +1,115 @@
+#include "SuperpoweredTruePeakLimiter.h"
+#include "SuperpoweredTruePeakMeter.h"
+#include <math.h>
+#include <string.h>
+
+namespace Superpowered {
+
+// The gain reaches its target over the look-ahead window. The audio is delayed by the detector delay too, so the gain lines up with the peaks.
+static const unsigned int lookahead = 64, window = lookahead + 1, blockFrames = 256;
+
+struct truePeakLimiterInternals {
+    TruePeakMeter *meter;
+    float framePeaks[blockFrames];
+    float delay[(lookahead + 8) * 2];  // Interleaved stereo ring of the last getLatencyFrames() input frames.
+    float minimumValues[window + 1];   // Monotonic queue for the sliding minimum of the required gain.
+    unsigned int minimumIndexes[window + 1];
+    float minimums[window];            // The last sliding minimums, for the moving average.
+    double minimumSum;
+    float previousDetector, gain, gainReduction;
+    unsigned int frame, delayPosition, queueHead, queueTail;
+    bool wasEnabled;
+};
+
+TruePeakLimiter::TruePeakLimiter(unsigned int _samplerate) : ceilingDb(-1.0f), releaseSec(0.05f) {
+    samplerate = _samplerate;
+    internals = new truePeakLimiterInternals;
+    internals->meter = new TruePeakMeter(2);
+    internals->gainReduction = 1.0f;
+    reset();
+}
+
+TruePeakLimiter::~TruePeakLimiter() {
+    delete internals->meter;
+    delete internals;
+}
+
+unsigned int TruePeakLimiter::getLatencyFrames() {
+    return lookahead + TruePeakMeter::getDelayFrames();
+}
+
+void TruePeakLimiter::reset() {
+    internals->meter->reset();
+    memset(internals->delay, 0, sizeof(internals->delay));
+    for (unsigned int n = 0; n < window; n++) internals->minimums[n] = 1.0f;
+    internals->minimumSum = window;
+    internals->previousDetector = 0;
+    internals->gain = 1.0f;
+    internals->frame = internals->delayPosition = internals->queueHead = internals->queueTail = 0;
+    internals->wasEnabled = false;
+}
+
+float TruePeakLimiter::getGainReductionDb() {
+    const float gain = internals->gainReduction;
+    internals->gainReduction = 1.0f;
+    return -20.0f * log10f(gain);
+}
+
+bool TruePeakLimiter::process(float *input, float *output, unsigned int numberOfFrames) {
+    if (!input || !output || !numberOfFrames) return false; // Some safety.
+    if (!enabled) {
+        if (internals->wasEnabled) reset();
+        return false;
+    }
+    internals->wasEnabled = true;
+
+    float c = ceilingDb, r = releaseSec;
+    if (c > 0) c = 0; else if (c < -40.0f) c = -40.0f;
+    if (r < 0.001f) r = 0.001f; else if (r > 1.0f) r = 1.0f;
+    const float ceiling = powf(10.0f, c * 0.05f), release = 1.0f - expf(-1.0f / (r * float(samplerate ? samplerate : 44100))), averageMul = 1.0f / float(window);
+    const unsigned int latency = getLatencyFrames(), queueSize = window + 1;
+    truePeakLimiterInternals *l = internals;
+
+    while (numberOfFrames > 0) {
+        const unsigned int frames = numberOfFrames < blockFrames ? numberOfFrames : blockFrames;
+        l->meter->process(input, frames, 0, l->framePeaks);
+
+        for (unsigned int n = 0; n < frames; n++, l->frame++) {
+            // An inter-sample peak between two frames may be reported for either of them.
+            const float detector = l->framePeaks[n] > l->previousDetector ? l->framePeaks[n] : l->previousDetector;
+            l->previousDetector = l->framePeaks[n];
+            const float required = detector > ceiling ? ceiling / detector : 1.0f;
+
+            // Sliding minimum of the required gain over the window.
+            while ((l->queueHead != l->queueTail) && (l->minimumValues[(l->queueTail + queueSize - 1) % queueSize] >= required)) l->queueTail = (l->queueTail + queueSize - 1) % queueSize;
+            l->minimumValues[l->queueTail] = required;
+            l->minimumIndexes[l->queueTail] = l->frame;
+            l->queueTail = (l->queueTail + 1) % queueSize;
+            if (l->frame - l->minimumIndexes[l->queueHead] >= window) l->queueHead = (l->queueHead + 1) % queueSize;
+            const float minimum = l->minimumValues[l->queueHead];
+
+            // The moving average of the minimums is a smooth attack, which is never above the required gain of the oldest frame in the window.
+            float *oldest = l->minimums + l->frame % window;
+            l->minimumSum += double(minimum) - double(*oldest);
+            *oldest = minimum;
+            const float target = float(l->minimumSum) * averageMul;
+            if (target < l->gain) l->gain = target; else l->gain += (target - l->gain) * release;
+            if (l->gain < l->gainReduction) l->gainReduction = l->gain;
+
+            float *delayed = l->delay + l->delayPosition * 2;
+            const float left = delayed[0], right = delayed[1];
+            delayed[0] = input[n * 2];
+            delayed[1] = input[n * 2 + 1];
+            output[n * 2] = left * l->gain;
+            output[n * 2 + 1] = right * l->gain;
+            if (++l->delayPosition >= latency) l->delayPosition = 0;
+        }
+
+        input += frames * 2;
+        output += frames * 2;
+        numberOfFrames -= frames;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,48 @@
+#ifndef Header_SuperpoweredTruePeakLimiter
+#define Header_SuperpoweredTruePeakLimiter
+
+#include "SuperpoweredFX.h"
+
+namespace Superpowered {
+
+struct truePeakLimiterInternals;
+
+/// @brief Look-ahead limiter with a true-peak detector (TruePeakMeter, ITU-R BS.1770-4 4x oversampling), so inter-sample peaks are kept under the ceiling too.
+/// Superpowered::Limiter detects sample peaks only. Use this one for mastering and export, where the output must meet a dBTP limit.
+/// Latency is getLatencyFrames() frames. It doesn't allocate any memory in process() and needs about 10 kb of memory.
+class TruePeakLimiter: public FX {
+public:
+    float ceilingDb;  ///< Ceiling in dBTP, limited between 0 and -40. Default: -1.
+    float releaseSec; ///< Release in seconds (not milliseconds!). Limited between 0.001 and 1. Default: 0.05 (50 ms).
+
+/// @brief Constructor. Enabled is false by default.
+/// @param samplerate The initial sample rate in Hz.
+    TruePeakLimiter(unsigned int samplerate);
+    ~TruePeakLimiter();
+
+/// @return Returns the maximum gain reduction in decibels since the last getGainReductionDb() call.
+    float getGainReductionDb();
+
+/// @return Returns with the latency in frames.
+    static unsigned int getLatencyFrames();
+
+/// @brief Clears the look-ahead buffer and the gain state.
+    void reset();
+
+/// @brief Processes the audio. Always call it in the audio processing callback, regardless if the effect is enabled or not for smooth, audio-artifact free operation.
+/// It's never blocking for real-time usage. You can change all properties and call getGainReductionDb() on any thread, concurrently with process().
+/// @return If process() returns with true, the contents of output are replaced with the audio output. If process() returns with false, the contents of output are not changed.
+/// @param input Pointer to floating point numbers. 32-bit interleaved stereo input.
+/// @param output Pointer to floating point numbers. 32-bit interleaved stereo output. Can point to the same location with input (in-place processing).
+/// @param numberOfFrames Number of frames to process. Any number is accepted.
+    bool process(float *input, float *output, unsigned int numberOfFrames);
+
+private:
+    truePeakLimiterInternals *internals;
+    TruePeakLimiter(const TruePeakLimiter&);
+    TruePeakLimiter& operator=(const TruePeakLimiter&);
+};
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include "SuperpoweredTruePeakMeter.h"
+#include "SuperpoweredSIMD.h"
+#include <math.h>
+#include <string.h>
+
+namespace Superpowered {
+
+static const unsigned int historyFrames = 11, blockFrames = 1024; // The interpolation filter has 12 taps per phase.
+
+struct truePeakMeterInternals {
+    float *buffer;   // Planar, every channel has historyFrames + blockFrames values. The history is in front of the block.
+    float *maxPeaks; // One per channel.
+    unsigned int numChannels;
+};
+
+TruePeakMeter::TruePeakMeter(unsigned int numChannels) {
+    internals = new truePeakMeterInternals;
+    internals->numChannels = numChannels ? numChannels : 1;
+    internals->buffer = new float[(historyFrames + blockFrames) * internals->numChannels];
+    internals->maxPeaks = new float[internals->numChannels];
+    reset();
+}
+
+TruePeakMeter::~TruePeakMeter() {
+    delete[] internals->buffer;
+    delete[] internals->maxPeaks;
+    delete internals;
+}
+
+void TruePeakMeter::reset() {
+    memset(internals->buffer, 0, (historyFrames + blockFrames) * internals->numChannels * sizeof(float));
+    memset(internals->maxPeaks, 0, internals->numChannels * sizeof(float));
+}
+
+float TruePeakMeter::process(float *input, unsigned int numberOfFrames, float *peaks, float *framePeaks) {
+    const unsigned int numChannels = internals->numChannels;
+    if (peaks) memset(peaks, 0, numChannels * sizeof(float));
+    if (framePeaks) memset(framePeaks, 0, numberOfFrames * sizeof(float));
+    float peak = 0;
+
+    while (numberOfFrames > 0) {
+        const unsigned int frames = numberOfFrames < blockFrames ? numberOfFrames : blockFrames;
+        for (unsigned int ch = 0; ch < numChannels; ch++) {
+            float *channel = internals->buffer + ch * (historyFrames + blockFrames), *block = channel + historyFrames, *i = input + ch;
+            for (unsigned int n = 0; n < frames; n++, i += numChannels) block[n] = *i;
+
+            const float p = SIMD::TruePeak4x(block, frames, framePeaks);
+            if (p > internals->maxPeaks[ch]) internals->maxPeaks[ch] = p;
+            if (peaks && (p > peaks[ch])) peaks[ch] = p;
+            if (p > peak) peak = p;
+            memmove(channel, channel + frames, historyFrames * sizeof(float));
+        }
+        input += frames * numChannels;
+        if (framePeaks) framePeaks += frames;
+        numberOfFrames -= frames;
+    }
+    return peak;
+}
+
+float TruePeakMeter::getMaxPeak(unsigned int channel) {
+    return (channel < internals->numChannels) ? internals->maxPeaks[channel] : 0;
+}
+
+float TruePeakMeter::getMaxPeakDbTP() {
+    float peak = 0;
+    for (unsigned int ch = 0; ch < internals->numChannels; ch++) if (internals->maxPeaks[ch] > peak) peak = internals->maxPeaks[ch];
+    return (peak > 0) ? 20.0f * log10f(peak) : -INFINITY;
+}
+
+unsigned int TruePeakMeter::getDelayFrames() {
+    return 6;
+}
+
+}
@@ -0,0 +1,47 @@
+#ifndef Header_SuperpoweredTruePeakMeter
+#define Header_SuperpoweredTruePeakMeter
+
+namespace Superpowered {
+
+struct truePeakMeterInternals;
+
+/// @brief True-peak meter according to ITU-R BS.1770-4 Annex 2 (4x oversampling), for any number of channels.
+/// Superpowered::Peak() and GetPeaks() measure sample peaks only, and miss the inter-sample peaks created by reconstruction (D/A conversion, lossy encoding, sample rate conversion). This meter measures those too.
+/// process() is not allocating and not blocking. The filter state of every channel is kept between calls, so the audio can be fed in any chunk size.
+class TruePeakMeter {
+public:
+/// @brief Constructor.
+/// @param numChannels The number of channels in the interleaved input.
+    TruePeakMeter(unsigned int numChannels = 2);
+    ~TruePeakMeter();
+
+/// @brief Measures audio.
+/// @return Returns the true peak (absolute value) of all channels in this chunk.
+/// @param input Pointer to floating point numbers. 32-bit interleaved input with numChannels channels.
+/// @param numberOfFrames The number of frames to process.
+/// @param peaks Pointer to floating point numbers, numChannels big. If not NULL, receives the true peak of every channel in this chunk. Can be NULL.
+/// @param framePeaks Pointer to floating point numbers, numberOfFrames big. If not NULL, receives the true peak of all channels around every frame, for use as a detector (such as TruePeakLimiter). The interpolation filter delays the detector by getDelayFrames() frames: framePeaks[n] belongs to input frame n - getDelayFrames(). Can be NULL.
+    float process(float *input, unsigned int numberOfFrames, float *peaks = 0, float *framePeaks = 0);
+
+/// @return Returns the highest true peak (absolute value) of a channel since the last reset().
+/// @param channel The index of the channel.
+    float getMaxPeak(unsigned int channel);
+
+/// @return Returns the highest true peak of all channels since the last reset() in dBTP (decibels relative to full scale, true peak). -INFINITY for silence.
+    float getMaxPeakDbTP();
+
+/// @brief Clears the filter state and the maximum peaks.
+    void reset();
+
+/// @return Returns with the delay of the interpolation filter in frames (6).
+    static unsigned int getDelayFrames();
+
+private:
+    truePeakMeterInternals *internals;
+    TruePeakMeter(const TruePeakMeter&);
+    TruePeakMeter& operator=(const TruePeakMeter&);
+};
+
+}
+
+#endif